@@ -1,8 +1,10 @@
 #include "imgui_gamepad.h"
+#include "imgui_input_trace.h"
+#include "imgui_internal.h"
 
 namespace ImGamepad {
 
-#ifndef IMGUI_DISABLE
+#if !defined(IMGUI_DISABLE) && !defined(IMKEYBOARD_DISABLE_GAMEPAD)
 
 ImGuiGamepadStyle::ImGuiGamepadStyle() {
 	Scale = 1.0f;
@@ -28,11 +30,264 @@ ImGuiGamepadStyle::ImGuiGamepadStyle() {
 	Colors[ImGuiGamepadCol_StickForeground] = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
 	Colors[ImGuiGamepadCol_TriggerBackground] = ImVec4(0.3f, 0.3f, 0.3f, 1.0f);
 	Colors[ImGuiGamepadCol_TriggerForeground] = ImVec4(0.6f, 0.6f, 0.6f, 1.0f);
+	Colors[ImGuiGamepadCol_StickHistogram] = ImVec4(1.0f, 0.8f, 0.0f, 0.8f);
+	Colors[ImGuiGamepadCol_ButtonRecorded] = ImVec4(0.0f, 0.5f, 1.0f, 0.5f);
 }
 
+// Number of bins per axis of the stick position histogram
+static const int StickHistogramSize = 32;
+
+// Fixed-size 2D histogram of stick positions, binned over [-1, 1] on both axes
+struct StickHistogram {
+	ImU32 Bins[StickHistogramSize * StickHistogramSize];
+	ImU32 MaxCount;	   // Highest bin count, kept up to date on insert so rendering doesn't need to scan for it
+	ImU32 SampleCount; // Total number of samples
+
+	StickHistogram() {
+		Clear();
+	}
+
+	void Clear() {
+		memset(Bins, 0, sizeof(Bins));
+		MaxCount = 0;
+		SampleCount = 0;
+	}
+
+	void Add(float x, float y) {
+		const int bx = ImClamp((int)((x + 1.0f) * 0.5f * StickHistogramSize), 0, StickHistogramSize - 1);
+		const int by = ImClamp((int)((y + 1.0f) * 0.5f * StickHistogramSize), 0, StickHistogramSize - 1);
+		const ImU32 count = ++Bins[by * StickHistogramSize + bx];
+		if (count > MaxCount) {
+			MaxCount = count;
+		}
+		SampleCount++;
+	}
+};
+
+// Number of samples kept per axis - enough for a few seconds at 1 kHz event rate
+static const int AxisHistorySize = 4096;
+
+// Fixed-size ring buffer of (time, value) samples for one axis
+struct AxisHistory {
+	double Times[AxisHistorySize];
+	float Values[AxisHistorySize];
+	int Head;  // Index the next sample is written to
+	int Count; // Number of valid samples
+
+	AxisHistory() {
+		Clear();
+	}
+
+	void Clear() {
+		Head = 0;
+		Count = 0;
+	}
+
+	void Add(double time, float value) {
+		Times[Head] = time;
+		Values[Head] = value;
+		Head = (Head + 1) % AxisHistorySize;
+		if (Count < AxisHistorySize) {
+			Count++;
+		}
+	}
+
+	// i = 0 is the oldest sample
+	int Index(int i) const {
+		return (Head - Count + i + AxisHistorySize) % AxisHistorySize;
+	}
+};
+
+// Built-in layouts
+static const ImGuiGamepadElementDesc xbox_elements[] = {
+	{ImGuiGamepadElementType_Trigger, ImVec2(0.15f, -0.1041667f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadL2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Trigger, ImVec2(0.85f, -0.1041667f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadR2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Shoulder, ImVec2(0.125f, 0.0916667f), ImVec2(0.0f, 0.0f), "L1", ImGuiKey_GamepadL1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Shoulder, ImVec2(0.875f, 0.0916667f), ImVec2(0.0f, 0.0f), "R1", ImGuiKey_GamepadR1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_DPad, ImVec2(0.22f, 0.55f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_None,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Stick, ImVec2(0.35f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadL3,
+	 ImGuiGamepadStick_Left},
+	{ImGuiGamepadElementType_Stick, ImVec2(0.65f, 0.65f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadR3,
+	 ImGuiGamepadStick_Right},
+	{ImGuiGamepadElementType_Button, ImVec2(0.78f, 0.3416667f), ImVec2(0.0f, 0.0f), "Y", ImGuiKey_GamepadFaceUp,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.845f, 0.45f), ImVec2(0.0f, 0.0f), "B", ImGuiKey_GamepadFaceRight,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.78f, 0.5583333f), ImVec2(0.0f, 0.0f), "A", ImGuiKey_GamepadFaceDown,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.715f, 0.45f), ImVec2(0.0f, 0.0f), "X", ImGuiKey_GamepadFaceLeft,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.42f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadBack,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.58f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadStart,
+	 ImGuiGamepadStick_None},
+};
+
+static const ImGuiGamepadElementDesc playstation_elements[] = {
+	{ImGuiGamepadElementType_Trigger, ImVec2(0.15f, -0.1041667f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadL2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Trigger, ImVec2(0.85f, -0.1041667f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadR2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Shoulder, ImVec2(0.125f, 0.0916667f), ImVec2(0.0f, 0.0f), "L1", ImGuiKey_GamepadL1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Shoulder, ImVec2(0.875f, 0.0916667f), ImVec2(0.0f, 0.0f), "R1", ImGuiKey_GamepadR1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_DPad, ImVec2(0.22f, 0.55f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_None,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Stick, ImVec2(0.35f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadL3,
+	 ImGuiGamepadStick_Left},
+	{ImGuiGamepadElementType_Stick, ImVec2(0.65f, 0.65f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadR3,
+	 ImGuiGamepadStick_Right},
+	{ImGuiGamepadElementType_Button, ImVec2(0.78f, 0.3416667f), ImVec2(0.0f, 0.0f), "tri", ImGuiKey_GamepadFaceUp,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.845f, 0.45f), ImVec2(0.0f, 0.0f), "O", ImGuiKey_GamepadFaceRight,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.78f, 0.5583333f), ImVec2(0.0f, 0.0f), "X", ImGuiKey_GamepadFaceDown,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.715f, 0.45f), ImVec2(0.0f, 0.0f), "sq", ImGuiKey_GamepadFaceLeft,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.42f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadBack,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.58f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadStart,
+	 ImGuiGamepadStick_None},
+};
+
+static const ImGuiGamepadElementDesc switch_pro_elements[] = {
+	{ImGuiGamepadElementType_Trigger, ImVec2(0.15f, -0.1041667f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadL2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Trigger, ImVec2(0.85f, -0.1041667f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadR2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Shoulder, ImVec2(0.125f, 0.0916667f), ImVec2(0.0f, 0.0f), "L1", ImGuiKey_GamepadL1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Shoulder, ImVec2(0.875f, 0.0916667f), ImVec2(0.0f, 0.0f), "R1", ImGuiKey_GamepadR1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_DPad, ImVec2(0.22f, 0.55f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_None,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Stick, ImVec2(0.35f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadL3,
+	 ImGuiGamepadStick_Left},
+	{ImGuiGamepadElementType_Stick, ImVec2(0.65f, 0.65f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadR3,
+	 ImGuiGamepadStick_Right},
+	{ImGuiGamepadElementType_Button, ImVec2(0.78f, 0.3416667f), ImVec2(0.0f, 0.0f), "X", ImGuiKey_GamepadFaceUp,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.845f, 0.45f), ImVec2(0.0f, 0.0f), "A", ImGuiKey_GamepadFaceRight,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.78f, 0.5583333f), ImVec2(0.0f, 0.0f), "B", ImGuiKey_GamepadFaceDown,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.715f, 0.45f), ImVec2(0.0f, 0.0f), "Y", ImGuiKey_GamepadFaceLeft,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.42f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadBack,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.58f, 0.35f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadStart,
+	 ImGuiGamepadStick_None},
+};
+
+// Element geometry in pixels relative to the canvas top left corner
+struct GamepadElementGeometry {
+	ImVec2 Min, Max; // Bounding box
+	ImVec2 Center;
+	float Radius; // Half the width, for round elements and the D-pad
+};
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+// Clickable area of a button in pixels relative to the canvas top left corner
+struct GamepadHitShape {
+	ImGuiKey Key;
+	ImGuiGamepadElementType Type; // To skip the elements hidden by the flags
+	ImVec2 Min, Max;			  // Bounding box
+	float RadiusSqr;			  // > 0.0f for circular buttons centered in the bounding box
+};
+#endif
+
+// Geometry of a layout, rebuilt only when the scale or the style sizes change
+struct GamepadLayoutGeometry {
+	float Scale; // -1.0f if not built yet
+	float BodyWidth, BodyHeight, ButtonSize, DPadSize, StickSize, TriggerWidth, TriggerHeight;
+	ImVec2 CanvasSize;
+	ImVec2 BodyMin, BodyMax;
+	ImVector<GamepadElementGeometry> Elements;
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	ImVector<GamepadHitShape> HitShapes; // In draw order
+#endif
+
+	GamepadLayoutGeometry() {
+		Scale = -1.0f;
+	}
+};
+
+struct GamepadLayout {
+	const char *Name;
+	ImVector<ImGuiGamepadElementDesc> Elements;
+	GamepadLayoutGeometry Geometry;
+};
+
 struct GamepadContext {
-	ImVector<ImGuiKey> HighlightedButtons;
+	ImBitArrayForNamedKeys HighlightedButtons;
+	ImVector<ImGuiKey> RecordedButtons; // In recording order
+	ImBitArrayForNamedKeys RecordedBits;
+	ImBitArrayForNamedKeys EventDownBits; // Last down state seen in the input events, to detect presses
+	ImVector<ImGuiKey> EventPresses;	  // Buttons that went down in the input events of EventFrame
+	int EventFrame;						  // Frame the input events were last looked at
+	int RecordFrame;					  // Frame EventPresses were last recorded
+	StickHistogram StickHistograms[ImGuiGamepadStick_COUNT];
+	int StickHistogramFrame; // Frame the current stick positions were last added to the histograms
+	AxisHistory AxisHistories[ImGuiGamepadAxis_COUNT];
+	bool AxisExternal[ImGuiGamepadAxis_COUNT]; // Fed by AddAxisSample(), not recorded from the input
+	float AxisKeyValues[ImGuiKey_GamepadRStickDown - ImGuiKey_GamepadL2 + 1]; // Last analog value per axis key
+	int AxisHistoryFrame;	  // Frame the input events were last recorded
+	double AxisHistoryTime;	  // Time of the last recorded frame
+	ImVector<float> ScopeMin; // Per-column scratch buffers for AxisScope() decimation
+	ImVector<float> ScopeMax;
+	ImVector<float> ScopeLast;
+	ImVector<GamepadLayout *> Layouts; // Built-in layouts first, indexed by ImGuiGamepadLayout
+	const ImInputState *InputState;	   // nullptr for the ImGui input
 	ImGuiGamepadStyle Style;
+	ImGuiID StateHash;	   // What the widgets of StateHashFrame drew, see GetStateHash()
+	ImGuiID PrevStateHash; // Same for the previous frame that drew widgets
+	int StateHashFrame;
+
+	GamepadContext() {
+		EventFrame = -1;
+		RecordFrame = -1;
+		InputState = nullptr;
+		StateHash = PrevStateHash = 0;
+		StateHashFrame = -1;
+		StickHistogramFrame = -1;
+		memset(AxisExternal, 0, sizeof(AxisExternal));
+		memset(AxisKeyValues, 0, sizeof(AxisKeyValues));
+		AxisHistoryFrame = -1;
+		AxisHistoryTime = 0.0;
+		AddLayout("Xbox", xbox_elements, IM_ARRAYSIZE(xbox_elements));
+		AddLayout("PlayStation", playstation_elements, IM_ARRAYSIZE(playstation_elements));
+		AddLayout("Steam", xbox_elements, IM_ARRAYSIZE(xbox_elements));
+		AddLayout("Switch Pro", switch_pro_elements, IM_ARRAYSIZE(switch_pro_elements));
+		IM_ASSERT(Layouts.Size == ImGuiGamepadLayout_Count);
+	}
+
+	~GamepadContext() {
+		for (int i = 0; i < Layouts.Size; i++) {
+			IM_DELETE(Layouts[i]);
+		}
+	}
+
+	ImGuiGamepadLayout AddLayout(const char *name, const ImGuiGamepadElementDesc *elements, int count) {
+		for (int i = 0; i < count; i++) {
+			IM_ASSERT((elements[i].Type == ImGuiGamepadElementType_Stick) ==
+					  (elements[i].Stick >= 0 && elements[i].Stick < ImGuiGamepadStick_COUNT));
+		}
+		GamepadLayout *layout = IM_NEW(GamepadLayout)();
+		layout->Name = name;
+		layout->Elements.resize(count);
+		if (count > 0) {
+			memcpy(layout->Elements.Data, elements, (size_t)count * sizeof(ImGuiGamepadElementDesc));
+		}
+		Layouts.push_back(layout);
+		return Layouts.Size - 1;
+	}
 };
 
 static GamepadContext *GetContext() {
@@ -49,39 +304,376 @@ static ImU32 GetColorU32(ImGuiGamepadCol idx) {
 	return ImGui::ColorConvertFloat4ToU32(style.Colors[idx]);
 }
 
+void SetInputState(const ImInputState *state) {
+	GetContext()->InputState = state;
+}
+
+static bool IsKeyDown(ImGuiKey key) {
+	const ImInputState *state = GetContext()->InputState;
+	if (state == nullptr) {
+		return ImGui::IsKeyDown(key);
+	}
+	const int key_index = ImInputStateGetKeyIndex(key);
+	return key_index != -1 && ImInputStateIsKeyDown(state, key_index) != 0;
+}
+
 static bool IsButtonHighlighted(ImGuiKey button) {
+	return GetContext()->HighlightedButtons.TestBit(button);
+}
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+static bool IsButtonRecorded(ImGuiKey button) {
+	return GetContext()->RecordedBits.TestBit(button);
+}
+
+static void Record(ImGuiKey button, bool record) {
 	GamepadContext *ctx = GetContext();
-	for (int i = 0; i < ctx->HighlightedButtons.Size; i++) {
-		if (ctx->HighlightedButtons[i] == button) {
-			return true;
+	if (record == IsButtonRecorded(button)) {
+		return;
+	}
+	if (record) {
+		ctx->RecordedBits.SetBit(button);
+		ctx->RecordedButtons.push_back(button);
+	} else {
+		ctx->RecordedBits.ClearBit(button);
+		for (int i = 0; i < ctx->RecordedButtons.Size; i++) {
+			if (ctx->RecordedButtons[i] == button) {
+				ctx->RecordedButtons.erase(&ctx->RecordedButtons[i]);
+				break;
+			}
 		}
 	}
-	return false;
 }
+#endif // IMKEYBOARD_DISABLE_RECORDING
 
 void HighlightButton(ImGuiKey button, bool highlight) {
+	IM_ASSERT(ImGui::IsNamedKey(button));
 	GamepadContext *ctx = GetContext();
 	if (highlight) {
-		if (!IsButtonHighlighted(button)) {
-			ctx->HighlightedButtons.push_back(button);
-		}
+		ctx->HighlightedButtons.SetBit(button);
 	} else {
-		for (int i = 0; i < ctx->HighlightedButtons.Size; i++) {
-			if (ctx->HighlightedButtons[i] == button) {
-				ctx->HighlightedButtons.erase(&ctx->HighlightedButtons[i]);
-				break;
+		ctx->HighlightedButtons.ClearBit(button);
+	}
+}
+
+void ClearHighlights() {
+	GamepadContext *ctx = GetContext();
+	ctx->HighlightedButtons.ClearAllBits();
+}
+
+void ClearRecorded() {
+	GamepadContext *ctx = GetContext();
+	ctx->RecordedButtons.clear();
+	ctx->RecordedBits.ClearAllBits();
+}
+
+const ImVector<ImGuiKey> &GetRecordedButtons() {
+	return GetContext()->RecordedButtons;
+}
+
+static bool IsStickDirectionKey(ImGuiKey key) {
+	return key >= ImGuiKey_GamepadLStickLeft && key <= ImGuiKey_GamepadRStickDown;
+}
+
+// Collect the gamepad buttons pressed this frame. Only the events processed this frame are looked at, so the cost
+// doesn't depend on the number of keys and sub-frame presses are not missed. Runs every frame, recordable or not, so a
+// button held while recording was off doesn't count as pressed once it's turned on.
+static void UpdateInputEvents() {
+	GamepadContext *ctx = GetContext();
+	ImGuiContext &g = *GImGui;
+	if (ctx->EventFrame == g.FrameCount) {
+		return;
+	}
+	ctx->EventFrame = g.FrameCount;
+	ctx->EventPresses.resize(0);
+	for (int i = 0; i < g.InputEventsTrail.Size; i++) {
+		const ImGuiInputEvent &e = g.InputEventsTrail[i];
+		if (e.Type != ImGuiInputEventType_Key || !ImGui::IsGamepadKey(e.Key.Key) || IsStickDirectionKey(e.Key.Key)) {
+			continue;
+		}
+		// Analog buttons (triggers) send an event per value change, only count the transition to down
+		const bool was_down = ctx->EventDownBits.TestBit(e.Key.Key);
+		if (e.Key.Down) {
+			ctx->EventDownBits.SetBit(e.Key.Key);
+		} else {
+			ctx->EventDownBits.ClearBit(e.Key.Key);
+		}
+		if (e.Key.Down && !was_down) {
+			ctx->EventPresses.push_back(e.Key.Key);
+		}
+	}
+}
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+// Toggle the recorded state of every gamepad button pressed this frame, once even with several widgets on screen
+static void RecordInputEvents() {
+	GamepadContext *ctx = GetContext();
+	UpdateInputEvents();
+	if (ctx->RecordFrame == ctx->EventFrame) {
+		return;
+	}
+	ctx->RecordFrame = ctx->EventFrame;
+	for (int i = 0; i < ctx->EventPresses.Size; i++) {
+		Record(ctx->EventPresses[i], !IsButtonRecorded(ctx->EventPresses[i]));
+	}
+}
+
+static void AddHitRect(GamepadLayoutGeometry &geo, ImGuiKey key, ImGuiGamepadElementType type, const ImVec2 &min,
+					   const ImVec2 &max) {
+	GamepadHitShape shape;
+	shape.Key = key;
+	shape.Type = type;
+	shape.Min = min;
+	shape.Max = max;
+	shape.RadiusSqr = 0.0f;
+	geo.HitShapes.push_back(shape);
+}
+
+static void AddHitCircle(GamepadLayoutGeometry &geo, ImGuiKey key, ImGuiGamepadElementType type, const ImVec2 &center,
+						 float radius) {
+	GamepadHitShape shape;
+	shape.Key = key;
+	shape.Type = type;
+	shape.Min = ImVec2(center.x - radius, center.y - radius);
+	shape.Max = ImVec2(center.x + radius, center.y + radius);
+	shape.RadiusSqr = radius * radius;
+	geo.HitShapes.push_back(shape);
+}
+#endif // IMKEYBOARD_DISABLE_RECORDING
+
+static bool IsElementHidden(ImGuiGamepadElementType type, ImGuiGamepadFlags flags) {
+	switch (type) {
+	case ImGuiGamepadElementType_Button:
+		return (flags & ImGuiGamepadFlags_HideFaceButtons) != 0;
+	case ImGuiGamepadElementType_CenterButton:
+		return (flags & ImGuiGamepadFlags_HideCenterButtons) != 0;
+	case ImGuiGamepadElementType_Shoulder:
+		return (flags & ImGuiGamepadFlags_HideShoulderButtons) != 0;
+	case ImGuiGamepadElementType_Trigger:
+		return (flags & ImGuiGamepadFlags_HideTriggers) != 0;
+	case ImGuiGamepadElementType_Stick:
+		return (flags & ImGuiGamepadFlags_HideSticks) != 0;
+	case ImGuiGamepadElementType_DPad:
+		return (flags & ImGuiGamepadFlags_HideDPad) != 0;
+	default:
+		return false;
+	}
+}
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+// Topmost visible shape under the canvas relative position (shapes are in draw order), ImGuiKey_None if none
+static ImGuiKey HitTest(const GamepadLayoutGeometry &geo, ImGuiGamepadFlags flags, const ImVec2 &mouse_pos) {
+	const ImVector<GamepadHitShape> &shapes = geo.HitShapes;
+	for (int i = shapes.Size - 1; i >= 0; i--) {
+		const GamepadHitShape &shape = shapes[i];
+		if (IsElementHidden(shape.Type, flags)) {
+			continue;
+		}
+		if (mouse_pos.x < shape.Min.x || mouse_pos.x >= shape.Max.x || mouse_pos.y < shape.Min.y ||
+			mouse_pos.y >= shape.Max.y) {
+			continue;
+		}
+		if (shape.RadiusSqr > 0.0f) {
+			const ImVec2 d(mouse_pos.x - (shape.Min.x + shape.Max.x) * 0.5f,
+						   mouse_pos.y - (shape.Min.y + shape.Max.y) * 0.5f);
+			if (ImLengthSqr(d) > shape.RadiusSqr) {
+				continue;
 			}
 		}
+		return shape.Key;
 	}
+	return ImGuiKey_None;
 }
+#endif
 
-void ClearHighlights() {
+// Pressed/highlighted/recorded overlay color for a button, 0 if none applies
+static ImU32 GetOverlayColor(ImGuiKey key, bool showPressed, bool recordable) {
+	if (showPressed && IsKeyDown(key)) {
+		return GetColorU32(ImGuiGamepadCol_ButtonPressed);
+	}
+	if (IsButtonHighlighted(key)) {
+		return GetColorU32(ImGuiGamepadCol_ButtonHighlighted);
+	}
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	if (recordable && IsButtonRecorded(key)) {
+		return GetColorU32(ImGuiGamepadCol_ButtonRecorded);
+	}
+#else
+	IM_UNUSED(recordable);
+#endif
+	return 0;
+}
+
+void AddStickSample(ImGuiGamepadStick stick, float x, float y) {
+	IM_ASSERT(stick >= 0 && stick < ImGuiGamepadStick_COUNT);
+	GetContext()->StickHistograms[stick].Add(x, y);
+}
+
+void ClearStickHistograms() {
+	GamepadContext *ctx = GetContext();
+	for (int i = 0; i < ImGuiGamepadStick_COUNT; i++) {
+		ctx->StickHistograms[i].Clear();
+	}
+}
+
+// Analog value in [0, 1] as reported by the backend (0 for digital-only input)
+static float GetKeyAnalogValue(ImGuiKey key) {
+	const ImInputState *state = GetContext()->InputState;
+	if (state == nullptr) {
+		return ImGui::GetKeyData(key)->AnalogValue;
+	}
+	const int key_index = ImInputStateGetKeyIndex(key);
+	return key_index != -1 ? state->KeysAnalog[key_index] : 0.0f;
+}
+
+// Stick deflection in [-1, 1] on both axes, y pointing down (screen space)
+static ImVec2 GetStickValue(ImGuiGamepadStick stick) {
+	if (stick == ImGuiGamepadStick_Left) {
+		return ImVec2(GetKeyAnalogValue(ImGuiKey_GamepadLStickRight) - GetKeyAnalogValue(ImGuiKey_GamepadLStickLeft),
+					  GetKeyAnalogValue(ImGuiKey_GamepadLStickDown) - GetKeyAnalogValue(ImGuiKey_GamepadLStickUp));
+	}
+	return ImVec2(GetKeyAnalogValue(ImGuiKey_GamepadRStickRight) - GetKeyAnalogValue(ImGuiKey_GamepadRStickLeft),
+				  GetKeyAnalogValue(ImGuiKey_GamepadRStickDown) - GetKeyAnalogValue(ImGuiKey_GamepadRStickUp));
+}
+
+static bool IsAxisKey(ImGuiKey key) {
+	return key >= ImGuiKey_GamepadL2 && key <= ImGuiKey_GamepadRStickDown && key != ImGuiKey_GamepadL3 &&
+		   key != ImGuiKey_GamepadR3;
+}
+
+// Axis value from the last seen analog values of its keys
+static float GetAxisValue(const GamepadContext *ctx, ImGuiGamepadAxis axis) {
+	const float *v = ctx->AxisKeyValues;
+	const int base = ImGuiKey_GamepadL2;
+	switch (axis) {
+	case ImGuiGamepadAxis_L2:
+		return v[ImGuiKey_GamepadL2 - base];
+	case ImGuiGamepadAxis_R2:
+		return v[ImGuiKey_GamepadR2 - base];
+	case ImGuiGamepadAxis_LeftStickX:
+		return v[ImGuiKey_GamepadLStickRight - base] - v[ImGuiKey_GamepadLStickLeft - base];
+	case ImGuiGamepadAxis_LeftStickY:
+		return v[ImGuiKey_GamepadLStickDown - base] - v[ImGuiKey_GamepadLStickUp - base];
+	case ImGuiGamepadAxis_RightStickX:
+		return v[ImGuiKey_GamepadRStickRight - base] - v[ImGuiKey_GamepadRStickLeft - base];
+	case ImGuiGamepadAxis_RightStickY:
+	default:
+		return v[ImGuiKey_GamepadRStickDown - base] - v[ImGuiKey_GamepadRStickUp - base];
+	}
+}
+
+static ImGuiGamepadAxis GetAxisForKey(ImGuiKey key) {
+	switch (key) {
+	case ImGuiKey_GamepadL2:
+		return ImGuiGamepadAxis_L2;
+	case ImGuiKey_GamepadR2:
+		return ImGuiGamepadAxis_R2;
+	case ImGuiKey_GamepadLStickLeft:
+	case ImGuiKey_GamepadLStickRight:
+		return ImGuiGamepadAxis_LeftStickX;
+	case ImGuiKey_GamepadLStickUp:
+	case ImGuiKey_GamepadLStickDown:
+		return ImGuiGamepadAxis_LeftStickY;
+	case ImGuiKey_GamepadRStickLeft:
+	case ImGuiKey_GamepadRStickRight:
+		return ImGuiGamepadAxis_RightStickX;
+	default:
+		return ImGuiGamepadAxis_RightStickY;
+	}
+}
+
+// Record every analog key event processed this frame. Events carry no timestamp, so they are spread evenly over the
+// time since the previous frame to keep their order and sub-frame shape in the trace.
+static void UpdateAxisHistory() {
+	GamepadContext *ctx = GetContext();
+	ImGuiContext &g = *GImGui;
+	if (ctx->AxisHistoryFrame == g.FrameCount) {
+		return;
+	}
+	const bool first_frame = ctx->AxisHistoryFrame == -1;
+	const double prev_time = first_frame ? g.Time : ctx->AxisHistoryTime;
+	ctx->AxisHistoryFrame = g.FrameCount;
+	ctx->AxisHistoryTime = g.Time;
+
+	// Nothing to compare the events against on the first frame, and an external input state has no event trail
+	if (first_frame || ctx->InputState != nullptr) {
+		for (int key = ImGuiKey_GamepadL2; key <= ImGuiKey_GamepadRStickDown; key++) {
+			ctx->AxisKeyValues[key - ImGuiKey_GamepadL2] = GetKeyAnalogValue((ImGuiKey)key);
+		}
+		for (int axis = 0; axis < ImGuiGamepadAxis_COUNT; axis++) {
+			if (!ctx->AxisExternal[axis]) {
+				ctx->AxisHistories[axis].Add(g.Time, GetAxisValue(ctx, axis));
+			}
+		}
+		return;
+	}
+
+	int event_count = 0;
+	for (int i = 0; i < g.InputEventsTrail.Size; i++) {
+		const ImGuiInputEvent &e = g.InputEventsTrail[i];
+		if (e.Type == ImGuiInputEventType_Key && IsAxisKey(e.Key.Key)) {
+			event_count++;
+		}
+	}
+	int event_index = 0;
+	for (int i = 0; i < g.InputEventsTrail.Size; i++) {
+		const ImGuiInputEvent &e = g.InputEventsTrail[i];
+		if (e.Type != ImGuiInputEventType_Key || !IsAxisKey(e.Key.Key)) {
+			continue;
+		}
+		ctx->AxisKeyValues[e.Key.Key - ImGuiKey_GamepadL2] = e.Key.AnalogValue;
+		const ImGuiGamepadAxis axis = GetAxisForKey(e.Key.Key);
+		if (ctx->AxisExternal[axis]) {
+			continue;
+		}
+		const double time = prev_time + (g.Time - prev_time) * (double)(++event_index) / (double)event_count;
+		ctx->AxisHistories[axis].Add(time, GetAxisValue(ctx, axis));
+	}
+}
+
+void AddAxisSample(ImGuiGamepadAxis axis, float value, double time) {
+	IM_ASSERT(axis >= 0 && axis < ImGuiGamepadAxis_COUNT);
+	GamepadContext *ctx = GetContext();
+	ctx->AxisExternal[axis] = true;
+	ctx->AxisHistories[axis].Add(time, value);
+}
+
+void ClearAxisHistory() {
 	GamepadContext *ctx = GetContext();
-	ctx->HighlightedButtons.clear();
+	for (int i = 0; i < ImGuiGamepadAxis_COUNT; i++) {
+		ctx->AxisHistories[i].Clear();
+		ctx->AxisExternal[i] = false;
+	}
+}
+
+// Draw the histogram as a density grid covering the stick base, only non-empty bins are emitted
+static void RenderStickHistogram(ImDrawList *draw_list, ImVec2 center, float size, const StickHistogram &histogram) {
+	IM_INPUT_TRACE_SCOPE("ImGamepad::StickHistogram");
+	if (histogram.MaxCount == 0) {
+		return;
+	}
+	const ImVec4 &color = GetStyle().Colors[ImGuiGamepadCol_StickHistogram];
+	const float cell_size = size * 2.0f / StickHistogramSize;
+	const float inv_max = 1.0f / (float)histogram.MaxCount;
+	const ImVec2 grid_min(center.x - size, center.y - size);
+	for (int by = 0; by < StickHistogramSize; by++) {
+		for (int bx = 0; bx < StickHistogramSize; bx++) {
+			const ImU32 count = histogram.Bins[by * StickHistogramSize + bx];
+			if (count == 0) {
+				continue;
+			}
+			// Keep single samples visible, they are what reveals drift
+			const float density = 0.15f + 0.85f * (float)count * inv_max;
+			const ImVec2 cell_min(grid_min.x + bx * cell_size, grid_min.y + by * cell_size);
+			const ImVec4 cell_color(color.x, color.y, color.z, color.w * density);
+			draw_list->AddRectFilled(cell_min, ImVec2(cell_min.x + cell_size, cell_min.y + cell_size),
+									 ImGui::ColorConvertFloat4ToU32(cell_color));
+		}
+	}
 }
 
 static void RenderButton(ImDrawList *draw_list, ImVec2 center, float radius, const char *label, ImGuiKey key,
-						 float scale, bool showPressed) {
+						 float scale, bool showPressed, bool recordable) {
 	// Button background
 	draw_list->AddCircleFilled(center, radius, GetColorU32(ImGuiGamepadCol_ButtonBackground));
 	draw_list->AddCircle(center, radius, GetColorU32(ImGuiGamepadCol_ButtonBorder), 0, 1.5f * scale);
@@ -93,17 +685,38 @@ static void RenderButton(ImDrawList *draw_list, ImVec2 center, float radius, con
 		draw_list->AddText(text_pos, GetColorU32(ImGuiGamepadCol_ButtonLabel), label);
 	}
 
-	// Pressed/highlighted overlay
-	bool pressed = showPressed && ImGui::IsKeyDown(key);
-	bool highlighted = IsButtonHighlighted(key);
-	if (pressed) {
-		draw_list->AddCircleFilled(center, radius, GetColorU32(ImGuiGamepadCol_ButtonPressed));
-	} else if (highlighted) {
-		draw_list->AddCircleFilled(center, radius, GetColorU32(ImGuiGamepadCol_ButtonHighlighted));
+	// Pressed/highlighted/recorded overlay
+	const ImU32 overlay_color = GetOverlayColor(key, showPressed, recordable);
+	if (overlay_color != 0) {
+		draw_list->AddCircleFilled(center, radius, overlay_color);
 	}
 }
 
-static void RenderDPad(ImDrawList *draw_list, ImVec2 center, float size, float scale, bool showPressed) {
+// Pressable area of each D-pad direction, shared by the overlays and the hit shapes
+struct DPadDirection {
+	ImGuiKey Key;
+	ImVec2 Min, Max;
+};
+
+static void GetDPadDirections(ImVec2 center, float size, DPadDirection directions[4]) {
+	const float arm_width = size * 0.35f;
+	const float arm_length = size * 0.5f;
+	directions[0].Key = ImGuiKey_GamepadDpadUp;
+	directions[0].Min = ImVec2(center.x - arm_width * 0.4f, center.y - arm_length);
+	directions[0].Max = ImVec2(center.x + arm_width * 0.4f, center.y - arm_width * 0.3f);
+	directions[1].Key = ImGuiKey_GamepadDpadDown;
+	directions[1].Min = ImVec2(center.x - arm_width * 0.4f, center.y + arm_width * 0.3f);
+	directions[1].Max = ImVec2(center.x + arm_width * 0.4f, center.y + arm_length);
+	directions[2].Key = ImGuiKey_GamepadDpadLeft;
+	directions[2].Min = ImVec2(center.x - arm_length, center.y - arm_width * 0.4f);
+	directions[2].Max = ImVec2(center.x - arm_width * 0.3f, center.y + arm_width * 0.4f);
+	directions[3].Key = ImGuiKey_GamepadDpadRight;
+	directions[3].Min = ImVec2(center.x + arm_width * 0.3f, center.y - arm_width * 0.4f);
+	directions[3].Max = ImVec2(center.x + arm_length, center.y + arm_width * 0.4f);
+}
+
+static void RenderDPad(ImDrawList *draw_list, ImVec2 center, float size, float scale, bool showPressed,
+					   bool recordable) {
 	const float arm_width = size * 0.35f;
 	const float arm_length = size * 0.5f;
 
@@ -125,89 +738,60 @@ static void RenderDPad(ImDrawList *draw_list, ImVec2 center, float size, float s
 					   ImVec2(center.x + arm_length, center.y + arm_width * 0.5f), GetColorU32(ImGuiGamepadCol_Border),
 					   3.0f * scale);
 
-	// Direction highlights
-	if (showPressed) {
-		if (ImGui::IsKeyDown(ImGuiKey_GamepadDpadUp)) {
-			draw_list->AddRectFilled(ImVec2(center.x - arm_width * 0.4f, center.y - arm_length),
-									 ImVec2(center.x + arm_width * 0.4f, center.y - arm_width * 0.3f),
-									 GetColorU32(ImGuiGamepadCol_ButtonPressed), 2.0f * scale);
-		}
-		if (ImGui::IsKeyDown(ImGuiKey_GamepadDpadDown)) {
-			draw_list->AddRectFilled(ImVec2(center.x - arm_width * 0.4f, center.y + arm_width * 0.3f),
-									 ImVec2(center.x + arm_width * 0.4f, center.y + arm_length),
-									 GetColorU32(ImGuiGamepadCol_ButtonPressed), 2.0f * scale);
-		}
-		if (ImGui::IsKeyDown(ImGuiKey_GamepadDpadLeft)) {
-			draw_list->AddRectFilled(ImVec2(center.x - arm_length, center.y - arm_width * 0.4f),
-									 ImVec2(center.x - arm_width * 0.3f, center.y + arm_width * 0.4f),
-									 GetColorU32(ImGuiGamepadCol_ButtonPressed), 2.0f * scale);
+	// Direction overlays (pressed/highlighted/recorded)
+	DPadDirection directions[4];
+	GetDPadDirections(center, size, directions);
+	for (int i = 0; i < IM_ARRAYSIZE(directions); i++) {
+		const ImU32 overlay_color = GetOverlayColor(directions[i].Key, showPressed, recordable);
+		if (overlay_color != 0) {
+			draw_list->AddRectFilled(directions[i].Min, directions[i].Max, overlay_color, 2.0f * scale);
 		}
-		if (ImGui::IsKeyDown(ImGuiKey_GamepadDpadRight)) {
-			draw_list->AddRectFilled(ImVec2(center.x + arm_width * 0.3f, center.y - arm_width * 0.4f),
-									 ImVec2(center.x + arm_length, center.y + arm_width * 0.4f),
-									 GetColorU32(ImGuiGamepadCol_ButtonPressed), 2.0f * scale);
-		}
-	}
-
-	// Highlighted directions
-	if (IsButtonHighlighted(ImGuiKey_GamepadDpadUp)) {
-		draw_list->AddRectFilled(ImVec2(center.x - arm_width * 0.4f, center.y - arm_length),
-								 ImVec2(center.x + arm_width * 0.4f, center.y - arm_width * 0.3f),
-								 GetColorU32(ImGuiGamepadCol_ButtonHighlighted), 2.0f * scale);
-	}
-	if (IsButtonHighlighted(ImGuiKey_GamepadDpadDown)) {
-		draw_list->AddRectFilled(ImVec2(center.x - arm_width * 0.4f, center.y + arm_width * 0.3f),
-								 ImVec2(center.x + arm_width * 0.4f, center.y + arm_length),
-								 GetColorU32(ImGuiGamepadCol_ButtonHighlighted), 2.0f * scale);
-	}
-	if (IsButtonHighlighted(ImGuiKey_GamepadDpadLeft)) {
-		draw_list->AddRectFilled(ImVec2(center.x - arm_length, center.y - arm_width * 0.4f),
-								 ImVec2(center.x - arm_width * 0.3f, center.y + arm_width * 0.4f),
-								 GetColorU32(ImGuiGamepadCol_ButtonHighlighted), 2.0f * scale);
-	}
-	if (IsButtonHighlighted(ImGuiKey_GamepadDpadRight)) {
-		draw_list->AddRectFilled(ImVec2(center.x + arm_width * 0.3f, center.y - arm_width * 0.4f),
-								 ImVec2(center.x + arm_length, center.y + arm_width * 0.4f),
-								 GetColorU32(ImGuiGamepadCol_ButtonHighlighted), 2.0f * scale);
 	}
 }
 
-static void RenderAnalogStick(ImDrawList *draw_list, ImVec2 center, float size, ImGuiKey stickButton, float scale,
-							  bool showPressed, bool showStickPos) {
+static void RenderAnalogStick(ImDrawList *draw_list, ImVec2 center, float size, ImGuiGamepadStick stick,
+							  ImGuiKey stickButton, float scale, bool showPressed, bool showStickPos,
+							  bool showHistogram, bool recordable) {
 	// Stick base (outer circle)
 	draw_list->AddCircleFilled(center, size, GetColorU32(ImGuiGamepadCol_StickBackground));
 	draw_list->AddCircle(center, size, GetColorU32(ImGuiGamepadCol_Border), 0, 1.5f * scale);
 
-	// Stick position indicator (inner circle)
+	if (showHistogram) {
+		draw_list->PushClipRect(ImVec2(center.x - size, center.y - size), ImVec2(center.x + size, center.y + size),
+								true);
+		RenderStickHistogram(draw_list, center, size, GetContext()->StickHistograms[stick]);
+		draw_list->PopClipRect();
+	}
+
+	// Stick position indicator (inner circle), full deflection moves it to the edge of the base
+	const float knob_size = size * 0.6f;
 	ImVec2 stick_pos = center;
 	if (showStickPos) {
-		// In a real implementation, you'd read actual stick values
-		// For demo, we just show center position
+		const ImVec2 value = GetStickValue(stick);
+		stick_pos.x += ImClamp(value.x, -1.0f, 1.0f) * (size - knob_size);
+		stick_pos.y += ImClamp(value.y, -1.0f, 1.0f) * (size - knob_size);
 	}
-	draw_list->AddCircleFilled(stick_pos, size * 0.6f, GetColorU32(ImGuiGamepadCol_StickForeground));
+	draw_list->AddCircleFilled(stick_pos, knob_size, GetColorU32(ImGuiGamepadCol_StickForeground));
 
 	// Click highlight
-	bool pressed = showPressed && ImGui::IsKeyDown(stickButton);
-	bool highlighted = IsButtonHighlighted(stickButton);
-	if (pressed) {
-		draw_list->AddCircleFilled(center, size, GetColorU32(ImGuiGamepadCol_ButtonPressed));
-	} else if (highlighted) {
-		draw_list->AddCircleFilled(center, size, GetColorU32(ImGuiGamepadCol_ButtonHighlighted));
+	const ImU32 overlay_color = GetOverlayColor(stickButton, showPressed, recordable);
+	if (overlay_color != 0) {
+		draw_list->AddCircleFilled(center, size, overlay_color);
 	}
 }
 
 static void RenderTrigger(ImDrawList *draw_list, ImVec2 pos, float width, float height, ImGuiKey key, float scale,
-						  bool showPressed, bool showTriggerLevel) {
+						  bool showPressed, bool showTriggerLevel, bool recordable) {
 	// Trigger background
 	draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height), GetColorU32(ImGuiGamepadCol_TriggerBackground),
 							 3.0f * scale);
 	draw_list->AddRect(pos, ImVec2(pos.x + width, pos.y + height), GetColorU32(ImGuiGamepadCol_Border), 3.0f * scale);
 
-	// Trigger fill level (would show analog value in real implementation)
+	// Trigger fill level
 	if (showTriggerLevel) {
-		float fill = 0.0f; // Would be actual trigger value
-		if (showPressed && ImGui::IsKeyDown(key)) {
-			fill = 1.0f;
+		float fill = ImSaturate(GetKeyAnalogValue(key));
+		if (fill == 0.0f && showPressed && IsKeyDown(key)) {
+			fill = 1.0f; // Digital-only trigger
 		}
 		if (fill > 0.0f) {
 			draw_list->AddRectFilled(pos, ImVec2(pos.x + width * fill, pos.y + height),
@@ -215,20 +799,15 @@ static void RenderTrigger(ImDrawList *draw_list, ImVec2 pos, float width, float
 		}
 	}
 
-	// Pressed/highlighted
-	bool pressed = showPressed && ImGui::IsKeyDown(key);
-	bool highlighted = IsButtonHighlighted(key);
-	if (pressed) {
-		draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height), GetColorU32(ImGuiGamepadCol_ButtonPressed),
-								 3.0f * scale);
-	} else if (highlighted) {
-		draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height),
-								 GetColorU32(ImGuiGamepadCol_ButtonHighlighted), 3.0f * scale);
+	// Pressed/highlighted/recorded
+	const ImU32 overlay_color = GetOverlayColor(key, showPressed, recordable);
+	if (overlay_color != 0) {
+		draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height), overlay_color, 3.0f * scale);
 	}
 }
 
 static void RenderShoulderButton(ImDrawList *draw_list, ImVec2 pos, float width, float height, ImGuiKey key,
-								 const char *label, float scale, bool showPressed) {
+								 const char *label, float scale, bool showPressed, bool recordable) {
 	draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height), GetColorU32(ImGuiGamepadCol_ButtonBackground),
 							 5.0f * scale);
 	draw_list->AddRect(pos, ImVec2(pos.x + width, pos.y + height), GetColorU32(ImGuiGamepadCol_ButtonBorder),
@@ -240,161 +819,454 @@ static void RenderShoulderButton(ImDrawList *draw_list, ImVec2 pos, float width,
 		draw_list->AddText(text_pos, GetColorU32(ImGuiGamepadCol_ButtonLabel), label);
 	}
 
-	bool pressed = showPressed && ImGui::IsKeyDown(key);
-	bool highlighted = IsButtonHighlighted(key);
-	if (pressed) {
-		draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height), GetColorU32(ImGuiGamepadCol_ButtonPressed),
-								 5.0f * scale);
-	} else if (highlighted) {
-		draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height),
-								 GetColorU32(ImGuiGamepadCol_ButtonHighlighted), 5.0f * scale);
+	const ImU32 overlay_color = GetOverlayColor(key, showPressed, recordable);
+	if (overlay_color != 0) {
+		draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + height), overlay_color, 5.0f * scale);
 	}
 }
 
-void Gamepad(ImGuiGamepadLayout layout, ImGuiGamepadFlags flags) {
-	const ImGuiGamepadStyle &style = GetStyle();
-	const float scale = style.Scale * (ImGui::GetFontSize() / 13.0f);
+ImGuiGamepadLayout RegisterLayout(const ImGuiGamepadLayoutDesc &desc) {
+	IM_ASSERT(desc.Name != nullptr);
+	IM_ASSERT(desc.ElementCount >= 0 && (desc.Elements != nullptr || desc.ElementCount == 0));
+	return GetContext()->AddLayout(desc.Name, desc.Elements, desc.ElementCount);
+}
+
+int GetLayoutCount() {
+	return GetContext()->Layouts.Size;
+}
+
+const char *GetLayoutName(ImGuiGamepadLayout layout) {
+	GamepadContext *ctx = GetContext();
+	IM_ASSERT(layout >= 0 && layout < ctx->Layouts.Size);
+	return ctx->Layouts[layout]->Name;
+}
+
+// Unscaled size of an element type taken from the style
+static ImVec2 GetElementStyleSize(ImGuiGamepadElementType type, const ImGuiGamepadStyle &style) {
+	switch (type) {
+	case ImGuiGamepadElementType_CenterButton:
+		return ImVec2(style.ButtonSize * 0.8f, style.ButtonSize * 0.8f);
+	case ImGuiGamepadElementType_Shoulder:
+		return ImVec2(style.TriggerWidth, style.TriggerHeight * 0.8f);
+	case ImGuiGamepadElementType_Trigger:
+		return ImVec2(style.TriggerWidth, style.TriggerHeight);
+	case ImGuiGamepadElementType_Stick:
+		return ImVec2(style.StickSize, style.StickSize);
+	case ImGuiGamepadElementType_DPad:
+		return ImVec2(style.DPadSize, style.DPadSize);
+	case ImGuiGamepadElementType_Button:
+	default:
+		return ImVec2(style.ButtonSize, style.ButtonSize);
+	}
+}
+
+static bool IsGeometryValid(const GamepadLayoutGeometry &geo, const ImGuiGamepadStyle &style, float scale) {
+	return geo.Scale == scale && geo.BodyWidth == style.BodyWidth && geo.BodyHeight == style.BodyHeight &&
+		   geo.ButtonSize == style.ButtonSize && geo.DPadSize == style.DPadSize && geo.StickSize == style.StickSize &&
+		   geo.TriggerWidth == style.TriggerWidth && geo.TriggerHeight == style.TriggerHeight;
+}
+
+// The canvas covers the body with a 10px margin and every element with a 5px margin
+static void BuildGeometry(GamepadLayout &layout, const ImGuiGamepadStyle &style, float scale) {
+	GamepadLayoutGeometry &geo = layout.Geometry;
+	geo.Scale = scale;
+	geo.BodyWidth = style.BodyWidth;
+	geo.BodyHeight = style.BodyHeight;
+	geo.ButtonSize = style.ButtonSize;
+	geo.DPadSize = style.DPadSize;
+	geo.StickSize = style.StickSize;
+	geo.TriggerWidth = style.TriggerWidth;
+	geo.TriggerHeight = style.TriggerHeight;
 
 	const float body_width = style.BodyWidth * scale;
 	const float body_height = style.BodyHeight * scale;
-	const float body_rounding = style.BodyRounding * scale;
-	const float button_size = style.ButtonSize * scale;
-	const float dpad_size = style.DPadSize * scale;
-	const float stick_size = style.StickSize * scale;
-	const float trigger_width = style.TriggerWidth * scale;
-	const float trigger_height = style.TriggerHeight * scale;
+	ImVec2 bb_min(-10.0f * scale, -10.0f * scale);
+	ImVec2 bb_max(body_width + 10.0f * scale, body_height + 10.0f * scale);
+	geo.Elements.resize(layout.Elements.Size);
+	for (int i = 0; i < layout.Elements.Size; i++) {
+		const ImGuiGamepadElementDesc &desc = layout.Elements[i];
+		GamepadElementGeometry &el = geo.Elements[i];
+		ImVec2 size = GetElementStyleSize(desc.Type, style);
+		if (desc.Size.x > 0.0f) {
+			size.x *= desc.Size.x;
+		}
+		if (desc.Size.y > 0.0f) {
+			size.y *= desc.Size.y;
+		}
+		size = ImVec2(size.x * scale, size.y * scale);
+		el.Center = ImVec2(desc.Pos.x * body_width, desc.Pos.y * body_height);
+		el.Radius = size.x * 0.5f;
+		el.Min = ImVec2(el.Center.x - size.x * 0.5f, el.Center.y - size.y * 0.5f);
+		el.Max = ImVec2(el.Center.x + size.x * 0.5f, el.Center.y + size.y * 0.5f);
+		bb_min = ImMin(bb_min, ImVec2(el.Min.x - 5.0f * scale, el.Min.y - 5.0f * scale));
+		bb_max = ImMax(bb_max, ImVec2(el.Max.x + 5.0f * scale, el.Max.y + 5.0f * scale));
+	}
+
+	// Move the origin to the top left corner of the canvas
+	const ImVec2 offset(-bb_min.x, -bb_min.y);
+	for (int i = 0; i < geo.Elements.Size; i++) {
+		GamepadElementGeometry &el = geo.Elements[i];
+		el.Center = ImVec2(el.Center.x + offset.x, el.Center.y + offset.y);
+		el.Min = ImVec2(el.Min.x + offset.x, el.Min.y + offset.y);
+		el.Max = ImVec2(el.Max.x + offset.x, el.Max.y + offset.y);
+	}
+	geo.BodyMin = offset;
+	geo.BodyMax = ImVec2(offset.x + body_width, offset.y + body_height);
+	geo.CanvasSize = ImVec2(bb_max.x - bb_min.x, bb_max.y - bb_min.y);
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	// Clickable areas for recording, matching what the Render*() functions draw
+	geo.HitShapes.resize(0);
+	for (int i = 0; i < geo.Elements.Size; i++) {
+		const ImGuiGamepadElementDesc &desc = layout.Elements[i];
+		const GamepadElementGeometry &el = geo.Elements[i];
+		switch (desc.Type) {
+		case ImGuiGamepadElementType_Button:
+		case ImGuiGamepadElementType_CenterButton:
+		case ImGuiGamepadElementType_Stick:
+			AddHitCircle(geo, desc.Key, desc.Type, el.Center, el.Radius);
+			break;
+		case ImGuiGamepadElementType_Shoulder:
+		case ImGuiGamepadElementType_Trigger:
+			AddHitRect(geo, desc.Key, desc.Type, el.Min, el.Max);
+			break;
+		case ImGuiGamepadElementType_DPad: {
+			DPadDirection directions[4];
+			GetDPadDirections(el.Center, el.Max.x - el.Min.x, directions);
+			for (int d = 0; d < IM_ARRAYSIZE(directions); d++) {
+				AddHitRect(geo, directions[d].Key, desc.Type, directions[d].Min, directions[d].Max);
+			}
+			break;
+		}
+		}
+	}
+#endif // IMKEYBOARD_DISABLE_RECORDING
+}
+
+// Folds what a widget drew into the hash of the frame. The stick histogram grows every frame it's shown, so it keeps
+// the hash changing.
+static void AddStateHash(ImGuiGamepadLayout layout, ImGuiGamepadFlags flags, float scale) {
+	IM_INPUT_TRACE_SCOPE("ImGamepad::StateHash");
+	GamepadContext *ctx = GetContext();
+	const int frame = ImGui::GetFrameCount();
+	if (ctx->StateHashFrame != frame) {
+		ctx->PrevStateHash = ctx->StateHash;
+		ctx->StateHash = 0;
+		ctx->StateHashFrame = frame;
+	}
+	int header[3] = {layout, flags, 0};
+	if (flags & ImGuiGamepadFlags_ShowPressed) {
+		IM_STATIC_ASSERT(ImGuiKey_GamepadRStickDown - ImGuiKey_GamepadStart < 32);
+		for (int k = ImGuiKey_GamepadStart; k <= ImGuiKey_GamepadRStickDown; k++) {
+			header[2] |= IsKeyDown((ImGuiKey)k) ? 1 << (k - ImGuiKey_GamepadStart) : 0;
+		}
+	}
+	float analog[6] = {};
+	if (flags & ImGuiGamepadFlags_ShowTriggers) {
+		analog[0] = GetKeyAnalogValue(ImGuiKey_GamepadL2);
+		analog[1] = GetKeyAnalogValue(ImGuiKey_GamepadR2);
+	}
+	if (flags & ImGuiGamepadFlags_ShowSticks) {
+		const ImVec2 left = GetStickValue(ImGuiGamepadStick_Left);
+		const ImVec2 right = GetStickValue(ImGuiGamepadStick_Right);
+		analog[2] = left.x;
+		analog[3] = left.y;
+		analog[4] = right.x;
+		analog[5] = right.y;
+	}
+	ImGuiID h = ImHashData(header, sizeof(header), ctx->StateHash);
+	h = ImHashData(&scale, sizeof(scale), h);
+	h = ImHashData(analog, sizeof(analog), h);
+	h = ImHashData(&ctx->Style, sizeof(ctx->Style), h);
+	h = ImHashData(&ctx->HighlightedButtons, sizeof(ctx->HighlightedButtons), h);
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	if (flags & ImGuiGamepadFlags_Recordable) {
+		h = ImHashData(&ctx->RecordedBits, sizeof(ctx->RecordedBits), h);
+	}
+#endif
+	if (flags & ImGuiGamepadFlags_ShowStickHistogram) {
+		for (int i = 0; i < ImGuiGamepadStick_COUNT; i++) {
+			h = ImHashData(&ctx->StickHistograms[i].SampleCount, sizeof(ImU32), h);
+		}
+	}
+	ctx->StateHash = h;
+}
+
+ImGuiID GetStateHash() {
+	return GetContext()->StateHash;
+}
+
+bool WantsRedraw() {
+	const GamepadContext *ctx = GetContext();
+	return ctx->StateHash != ctx->PrevStateHash;
+}
+
+void Gamepad(ImGuiGamepadLayout layout, ImGuiGamepadFlags flags) {
+	IM_INPUT_TRACE_SCOPE("ImGamepad::Gamepad");
+	GamepadContext *ctx = GetContext();
+	IM_ASSERT(layout >= 0 && layout < ctx->Layouts.Size);
+	const ImGuiGamepadStyle &style = ctx->Style;
+	const float scale = style.Scale * (ImGui::GetFontSize() / 13.0f);
 
 	const bool showPressed = (flags & ImGuiGamepadFlags_ShowPressed);
 	const bool showSticks = (flags & ImGuiGamepadFlags_ShowSticks);
 	const bool showTriggers = (flags & ImGuiGamepadFlags_ShowTriggers);
-	const bool hideDPad = (flags & ImGuiGamepadFlags_HideDPad);
-	const bool hideFaceButtons = (flags & ImGuiGamepadFlags_HideFaceButtons);
-	const bool hideShoulderButtons = (flags & ImGuiGamepadFlags_HideShoulderButtons);
-	const bool hideTriggerButtons = (flags & ImGuiGamepadFlags_HideTriggers);
-	const bool hideSticks = (flags & ImGuiGamepadFlags_HideSticks);
-	const bool hideCenterButtons = (flags & ImGuiGamepadFlags_HideCenterButtons);
+	const bool showStickHistogram = (flags & ImGuiGamepadFlags_ShowStickHistogram);
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	const bool recordable = (flags & ImGuiGamepadFlags_Recordable) != 0;
+#else
+	const bool recordable = false;
+#endif
 
-	ImVec2 canvas_size(body_width + 20.0f * scale, body_height + trigger_height + 20.0f * scale);
-	ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+	{
+		IM_INPUT_TRACE_SCOPE("ImGamepad::Input");
+		UpdateAxisHistory();
+		UpdateInputEvents();
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+		if (recordable) {
+			RecordInputEvents();
+		}
+#endif
 
-	ImGui::Dummy(canvas_size);
-	ImDrawList *draw_list = ImGui::GetWindowDrawList();
-	draw_list->PushClipRect(canvas_pos, ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y), true);
+		// Accumulate the current stick positions once per frame, even with several widgets on screen. A stick at rest
+		// (inside the deadzone the backend applies) reads exactly 0 and is skipped, it would saturate the center bins.
+		if (showStickHistogram && ctx->StickHistogramFrame != ImGui::GetFrameCount()) {
+			ctx->StickHistogramFrame = ImGui::GetFrameCount();
+			for (int i = 0; i < ImGuiGamepadStick_COUNT; i++) {
+				const ImVec2 value = GetStickValue(i);
+				if (value.x != 0.0f || value.y != 0.0f) {
+					ctx->StickHistograms[i].Add(value.x, value.y);
+				}
+			}
+		}
+	}
 
-	ImVec2 body_pos(canvas_pos.x + 10.0f * scale, canvas_pos.y + trigger_height + 10.0f * scale);
+	GamepadLayout &gamepad_layout = *ctx->Layouts[layout];
+	GamepadLayoutGeometry &geo = gamepad_layout.Geometry;
+	if (!IsGeometryValid(geo, style, scale)) {
+		IM_INPUT_TRACE_SCOPE("ImGamepad::BuildGeometry");
+		BuildGeometry(gamepad_layout, style, scale);
+	}
 
-	// Draw triggers at top
-	if (!hideTriggerButtons) {
-		RenderTrigger(draw_list, ImVec2(body_pos.x + 15.0f * scale, canvas_pos.y + 5.0f * scale), trigger_width,
-					  trigger_height, ImGuiKey_GamepadL2, scale, showPressed, showTriggers);
-		RenderTrigger(draw_list,
-					  ImVec2(body_pos.x + body_width - trigger_width - 15.0f * scale, canvas_pos.y + 5.0f * scale),
-					  trigger_width, trigger_height, ImGuiKey_GamepadR2, scale, showPressed, showTriggers);
+	const ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+	ImGui::Dummy(geo.CanvasSize);
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	const bool clicked = recordable && ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left);
+#endif
+	if (!ImGui::IsItemVisible()) {
+		return;
 	}
+	ImDrawList *draw_list = ImGui::GetWindowDrawList();
+	draw_list->PushClipRect(canvas_pos, ImVec2(canvas_pos.x + geo.CanvasSize.x, canvas_pos.y + geo.CanvasSize.y),
+							true);
 
 	// Draw controller body
-	draw_list->AddRectFilled(body_pos, ImVec2(body_pos.x + body_width, body_pos.y + body_height),
-							 GetColorU32(ImGuiGamepadCol_Background), body_rounding);
-	draw_list->AddRect(body_pos, ImVec2(body_pos.x + body_width, body_pos.y + body_height),
-					   GetColorU32(ImGuiGamepadCol_Border), body_rounding, 0, 2.0f * scale);
-
-	// Shoulder buttons
-	if (!hideShoulderButtons) {
-		RenderShoulderButton(draw_list, ImVec2(body_pos.x + 10.0f * scale, body_pos.y + 5.0f * scale), trigger_width,
-							 trigger_height * 0.8f, ImGuiKey_GamepadL1, "L1", scale, showPressed);
-		RenderShoulderButton(draw_list,
-							 ImVec2(body_pos.x + body_width - trigger_width - 10.0f * scale, body_pos.y + 5.0f * scale),
-							 trigger_width, trigger_height * 0.8f, ImGuiKey_GamepadR1, "R1", scale, showPressed);
-	}
-
-	// D-pad (left side)
-	if (!hideDPad) {
-		ImVec2 dpad_center(body_pos.x + body_width * 0.22f, body_pos.y + body_height * 0.55f);
-		RenderDPad(draw_list, dpad_center, dpad_size, scale, showPressed);
-	}
-
-	// Analog sticks
-	if (!hideSticks) {
-		// Left analog stick
-		ImVec2 left_stick_center(body_pos.x + body_width * 0.35f, body_pos.y + body_height * 0.35f);
-		RenderAnalogStick(draw_list, left_stick_center, stick_size * 0.5f, ImGuiKey_GamepadL3, scale, showPressed,
-						  showSticks);
-
-		// Right analog stick
-		ImVec2 right_stick_center(body_pos.x + body_width * 0.65f, body_pos.y + body_height * 0.65f);
-		RenderAnalogStick(draw_list, right_stick_center, stick_size * 0.5f, ImGuiKey_GamepadR3, scale, showPressed,
-						  showSticks);
-	}
-
-	// Face buttons (right side) - layout varies by controller type
-	if (!hideFaceButtons) {
-		ImVec2 face_center(body_pos.x + body_width * 0.78f, body_pos.y + body_height * 0.45f);
-		float face_spacing = button_size * 1.3f;
-
-		const char *btn_top;
-		const char *btn_right;
-		const char *btn_bottom;
-		const char *btn_left;
-
-		switch (layout) {
-		case ImGuiGamepadLayout_PlayStation:
-			btn_top = "tri"; // Triangle
-			btn_right = "O"; // Circle
-			btn_bottom = "X";
-			btn_left = "sq"; // Square
-			break;
-		case ImGuiGamepadLayout_SwitchPro:
-			btn_top = "X";
-			btn_right = "A";
-			btn_bottom = "B";
-			btn_left = "Y";
-			break;
-		case ImGuiGamepadLayout_Steam:
-		case ImGuiGamepadLayout_Xbox:
-		default:
-			btn_top = "Y";
-			btn_right = "B";
-			btn_bottom = "A";
-			btn_left = "X";
-			break;
+	{
+		IM_INPUT_TRACE_SCOPE("ImGamepad::Background");
+		const float body_rounding = style.BodyRounding * scale;
+		const ImVec2 body_min(canvas_pos.x + geo.BodyMin.x, canvas_pos.y + geo.BodyMin.y);
+		const ImVec2 body_max(canvas_pos.x + geo.BodyMax.x, canvas_pos.y + geo.BodyMax.y);
+		draw_list->AddRectFilled(body_min, body_max, GetColorU32(ImGuiGamepadCol_Background), body_rounding);
+		draw_list->AddRect(body_min, body_max, GetColorU32(ImGuiGamepadCol_Border), body_rounding, 0, 2.0f * scale);
+	}
+
+	{
+		IM_INPUT_TRACE_SCOPE("ImGamepad::Elements");
+		for (int i = 0; i < gamepad_layout.Elements.Size; i++) {
+			const ImGuiGamepadElementDesc &desc = gamepad_layout.Elements[i];
+			if (IsElementHidden(desc.Type, flags)) {
+				continue;
+			}
+			const GamepadElementGeometry &el = geo.Elements[i];
+			const ImVec2 center(canvas_pos.x + el.Center.x, canvas_pos.y + el.Center.y);
+			const ImVec2 min(canvas_pos.x + el.Min.x, canvas_pos.y + el.Min.y);
+			const float width = el.Max.x - el.Min.x;
+			const float height = el.Max.y - el.Min.y;
+			switch (desc.Type) {
+			case ImGuiGamepadElementType_Button:
+			case ImGuiGamepadElementType_CenterButton:
+				RenderButton(draw_list, center, el.Radius, desc.Label, desc.Key, scale, showPressed, recordable);
+				break;
+			case ImGuiGamepadElementType_Shoulder:
+				RenderShoulderButton(draw_list, min, width, height, desc.Key, desc.Label, scale, showPressed,
+									 recordable);
+				break;
+			case ImGuiGamepadElementType_Trigger:
+				RenderTrigger(draw_list, min, width, height, desc.Key, scale, showPressed, showTriggers, recordable);
+				break;
+			case ImGuiGamepadElementType_Stick:
+				RenderAnalogStick(draw_list, center, el.Radius, desc.Stick, desc.Key, scale, showPressed, showSticks,
+								  showStickHistogram, recordable);
+				break;
+			case ImGuiGamepadElementType_DPad:
+				RenderDPad(draw_list, center, width, scale, showPressed, recordable);
+				break;
+			}
+		}
+	}
+
+	draw_list->PopClipRect();
+	AddStateHash(layout, flags, scale);
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	// Toggle the clicked button, the overlay shows up next frame
+	if (clicked) {
+		IM_INPUT_TRACE_SCOPE("ImGamepad::Recording");
+		const ImVec2 mouse_pos = ImGui::GetIO().MousePos;
+		const ImGuiKey key = HitTest(geo, flags, ImVec2(mouse_pos.x - canvas_pos.x, mouse_pos.y - canvas_pos.y));
+		if (key != ImGuiKey_None) {
+			Record(key, !IsButtonRecorded(key));
 		}
+	}
+#endif
+}
 
-		// Top button (Y/Triangle/X)
-		RenderButton(draw_list, ImVec2(face_center.x, face_center.y - face_spacing * 0.5f), button_size * 0.5f, btn_top,
-					 ImGuiKey_GamepadFaceUp, scale, showPressed);
-		// Right button (B/Circle/A)
-		RenderButton(draw_list, ImVec2(face_center.x + face_spacing * 0.5f, face_center.y), button_size * 0.5f, btn_right,
-					 ImGuiKey_GamepadFaceRight, scale, showPressed);
-		// Bottom button (A/Cross/B)
-		RenderButton(draw_list, ImVec2(face_center.x, face_center.y + face_spacing * 0.5f), button_size * 0.5f, btn_bottom,
-					 ImGuiKey_GamepadFaceDown, scale, showPressed);
-		// Left button (X/Square/Y)
-		RenderButton(draw_list, ImVec2(face_center.x - face_spacing * 0.5f, face_center.y), button_size * 0.5f, btn_left,
-					 ImGuiKey_GamepadFaceLeft, scale, showPressed);
+void AxisScope(ImGuiGamepadAxis axis, const ImVec2 &size, float history) {
+	IM_INPUT_TRACE_SCOPE("ImGamepad::AxisScope");
+	IM_ASSERT(axis >= 0 && axis < ImGuiGamepadAxis_COUNT);
+	IM_ASSERT(history > 0.0f);
+	UpdateAxisHistory();
+
+	GamepadContext *ctx = GetContext();
+	const ImGuiGamepadStyle &style = ctx->Style;
+	const float scale = style.Scale * (ImGui::GetFontSize() / 13.0f);
+	const ImVec2 scope_size(size.x > 0.0f ? size.x : style.BodyWidth * scale,
+							size.y > 0.0f ? size.y : style.TriggerHeight * 3.0f * scale);
+	const ImVec2 pos = ImGui::GetCursorScreenPos();
+	ImGui::Dummy(scope_size);
+	if (!ImGui::IsItemVisible()) {
+		return;
 	}
 
-	// Center buttons (Start/Select or equivalent)
-	if (!hideCenterButtons) {
-		float center_y = body_pos.y + body_height * 0.35f;
-		float center_btn_size = button_size * 0.4f;
+	// Same look as the trigger: background, border and the fill color for the trace
+	ImDrawList *draw_list = ImGui::GetWindowDrawList();
+	const ImVec2 pos_max(pos.x + scope_size.x, pos.y + scope_size.y);
+	draw_list->AddRectFilled(pos, pos_max, GetColorU32(ImGuiGamepadCol_TriggerBackground), 3.0f * scale);
+	draw_list->AddRect(pos, pos_max, GetColorU32(ImGuiGamepadCol_Border), 3.0f * scale);
 
-		// Back/Select/Share
-		ImVec2 back_center(body_pos.x + body_width * 0.42f, center_y);
-		RenderButton(draw_list, back_center, center_btn_size, nullptr, ImGuiKey_GamepadBack, scale, showPressed);
+	const bool is_trigger = (axis == ImGuiGamepadAxis_L2 || axis == ImGuiGamepadAxis_R2);
+	const float value_min = is_trigger ? 0.0f : -1.0f;
+	const float value_max = 1.0f;
+	const float plot_min_y = pos.y + 2.0f * scale;
+	const float plot_height = scope_size.y - 4.0f * scale;
+	if (!is_trigger) {
+		const float zero_y = plot_min_y + plot_height * 0.5f;
+		draw_list->AddLine(ImVec2(pos.x, zero_y), ImVec2(pos_max.x, zero_y), GetColorU32(ImGuiGamepadCol_Border));
+	}
 
-		// Start/Options
-		ImVec2 start_center(body_pos.x + body_width * 0.58f, center_y);
-		RenderButton(draw_list, start_center, center_btn_size, nullptr, ImGuiKey_GamepadStart, scale, showPressed);
+	// Decimate the samples of the visible time window to a min/max range per pixel column
+	const AxisHistory &h = ctx->AxisHistories[axis];
+	const int columns = ImMax(1, (int)scope_size.x);
+	const double time_end = ctx->AxisHistoryTime;
+	const double time_begin = time_end - history;
+	ctx->ScopeMin.resize(columns);
+	ctx->ScopeMax.resize(columns);
+	ctx->ScopeLast.resize(columns);
+	for (int c = 0; c < columns; c++) {
+		ctx->ScopeMin[c] = FLT_MAX;
+		ctx->ScopeMax[c] = -FLT_MAX;
+	}
+	// Walk back to the newest sample before the window, its value holds until the first sample inside
+	int first = h.Count;
+	while (first > 0 && h.Times[h.Index(first - 1)] >= time_begin) {
+		first--;
+	}
+	float current = first > 0 ? h.Values[h.Index(first - 1)] : (h.Count > 0 ? h.Values[h.Index(0)] : 0.0f);
+	for (int i = first; i < h.Count; i++) {
+		const int idx = h.Index(i);
+		const int c = ImClamp((int)((h.Times[idx] - time_begin) / history * columns), 0, columns - 1);
+		const float v = h.Values[idx];
+		ctx->ScopeMin[c] = ImMin(ctx->ScopeMin[c], v);
+		ctx->ScopeMax[c] = ImMax(ctx->ScopeMax[c], v);
+		ctx->ScopeLast[c] = v;
 	}
 
-	draw_list->PopClipRect();
+	// One rect per run of identical columns, so the vertex count only depends on the width
+	const ImU32 trace_color = GetColorU32(ImGuiGamepadCol_TriggerForeground);
+	const float thickness = ImMax(1.0f, scale);
+	const float value_to_y = plot_height / (value_max - value_min);
+	float run_lo = 0.0f, run_hi = 0.0f;
+	int run_start = 0;
+	for (int c = 0; c <= columns; c++) {
+		float lo = 0.0f, hi = 0.0f;
+		if (c < columns) {
+			lo = current;
+			hi = current;
+			if (ctx->ScopeMin[c] <= ctx->ScopeMax[c]) {
+				lo = ImMin(lo, ctx->ScopeMin[c]);
+				hi = ImMax(hi, ctx->ScopeMax[c]);
+				current = ctx->ScopeLast[c];
+			}
+			if (c > 0 && lo == run_lo && hi == run_hi) {
+				continue;
+			}
+		}
+		if (c > 0) {
+			const float y_top = plot_min_y + (value_max - ImClamp(run_hi, value_min, value_max)) * value_to_y;
+			const float y_bottom = plot_min_y + (value_max - ImClamp(run_lo, value_min, value_max)) * value_to_y;
+			draw_list->AddRectFilled(ImVec2(pos.x + run_start, y_top - thickness * 0.5f),
+									 ImVec2(pos.x + c, y_bottom + thickness * 0.5f), trace_color);
+		}
+		run_start = c;
+		run_lo = lo;
+		run_hi = hi;
+	}
+
+	const char *axis_names[] = {"L2", "R2", "LX", "LY", "RX", "RY"};
+	IM_STATIC_ASSERT(IM_ARRAYSIZE(axis_names) == ImGuiGamepadAxis_COUNT);
+	char label[32];
+	ImFormatString(label, IM_ARRAYSIZE(label), "%s %+.3f", axis_names[axis], GetAxisValue(ctx, axis));
+	draw_list->AddText(ImVec2(pos.x + 3.0f * scale, pos.y + 1.0f * scale), GetColorU32(ImGuiGamepadCol_ButtonLabel),
+					   label);
+}
+
+#ifndef IMKEYBOARD_DISABLE_DEMO
+// Custom layout example: an arcade stick with two rows of four buttons
+static const ImGuiGamepadElementDesc arcade_elements[] = {
+	{ImGuiGamepadElementType_Stick, ImVec2(0.2f, 0.5f), ImVec2(1.6f, 1.6f), nullptr, ImGuiKey_GamepadL3,
+	 ImGuiGamepadStick_Left},
+	{ImGuiGamepadElementType_Button, ImVec2(0.5f, 0.38f), ImVec2(0.0f, 0.0f), "X", ImGuiKey_GamepadFaceLeft,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.63f, 0.32f), ImVec2(0.0f, 0.0f), "Y", ImGuiKey_GamepadFaceUp,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.76f, 0.32f), ImVec2(0.0f, 0.0f), "RB", ImGuiKey_GamepadR1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.89f, 0.35f), ImVec2(0.0f, 0.0f), "LB", ImGuiKey_GamepadL1,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.5f, 0.68f), ImVec2(0.0f, 0.0f), "A", ImGuiKey_GamepadFaceDown,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.63f, 0.62f), ImVec2(0.0f, 0.0f), "B", ImGuiKey_GamepadFaceRight,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.76f, 0.62f), ImVec2(0.0f, 0.0f), "RT", ImGuiKey_GamepadR2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_Button, ImVec2(0.89f, 0.65f), ImVec2(0.0f, 0.0f), "LT", ImGuiKey_GamepadL2,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.42f, 0.12f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadBack,
+	 ImGuiGamepadStick_None},
+	{ImGuiGamepadElementType_CenterButton, ImVec2(0.58f, 0.12f), ImVec2(0.0f, 0.0f), nullptr, ImGuiKey_GamepadStart,
+	 ImGuiGamepadStick_None},
+};
+
+ImGuiGamepadLayout RegisterDemoLayout() {
+	static ImGuiGamepadLayout layout = -1;
+	if (layout == -1) {
+		ImGuiGamepadLayoutDesc desc;
+		desc.Name = "Arcade Stick";
+		desc.Elements = arcade_elements;
+		desc.ElementCount = IM_ARRAYSIZE(arcade_elements);
+		layout = RegisterLayout(desc);
+	}
+	return layout;
 }
 
-#ifndef IMGUI_DISABLE_DEMO_WINDOWS
 void GamepadDemo() {
 	static bool showPressed = true;
 	static bool showSticks = true;
 	static bool showTriggers = true;
+	static bool showStickHistogram = false;
+	static bool showAxisScopes = false;
+	static bool recordable = false;
+	static float axisScopeHistory = 2.0f;
 	static int currentLayout = ImGuiGamepadLayout_Xbox;
 
 	ImGui::Text("Gamepad Widget Demo");
@@ -403,11 +1275,10 @@ void GamepadDemo() {
 	// Layout selection
 	ImGui::Text("Layout:");
 	ImGui::SameLine();
-	const char *layoutNames[] = {"Xbox", "PlayStation", "Steam", "Switch Pro"};
-	if (ImGui::BeginCombo("##GamepadLayout", layoutNames[currentLayout])) {
-		for (int i = 0; i < ImGuiGamepadLayout_Count; i++) {
+	if (ImGui::BeginCombo("##GamepadLayout", GetLayoutName(currentLayout))) {
+		for (int i = 0; i < GetLayoutCount(); i++) {
 			const bool isSelected = (currentLayout == i);
-			if (ImGui::Selectable(layoutNames[i], isSelected)) {
+			if (ImGui::Selectable(GetLayoutName(i), isSelected)) {
 				currentLayout = i;
 			}
 			if (isSelected) {
@@ -416,12 +1287,46 @@ void GamepadDemo() {
 		}
 		ImGui::EndCombo();
 	}
+	if (GetLayoutCount() == ImGuiGamepadLayout_Count) {
+		ImGui::SameLine();
+		ImGui::TextDisabled("(RegisterDemoLayout() adds a custom layout)");
+	}
 
 	// Flags
 	ImGui::Text("Options:");
 	ImGui::Checkbox("Show Pressed Buttons", &showPressed);
 	ImGui::Checkbox("Show Stick Positions", &showSticks);
 	ImGui::Checkbox("Show Trigger Levels", &showTriggers);
+	ImGui::Checkbox("Show Stick Histogram", &showStickHistogram);
+	if (showStickHistogram) {
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Clear##StickHistogram")) {
+			ClearStickHistograms();
+		}
+	}
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	ImGui::Checkbox("Recordable Buttons (Blue)", &recordable);
+#endif
+
+	// Show recorded buttons when recordable mode is enabled
+	if (recordable) {
+		const ImVector<ImGuiKey> &recordedButtons = GetRecordedButtons();
+		if (recordedButtons.Size > 0) {
+			ImGui::Text("Recorded Buttons (%d):", recordedButtons.Size);
+			ImGui::SameLine();
+			for (int i = 0; i < recordedButtons.Size; i++) {
+				if (i > 0)
+					ImGui::SameLine();
+				ImGui::Text("%s%s", ImGui::GetKeyName(recordedButtons[i]), i < recordedButtons.Size - 1 ? "," : "");
+			}
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Clear##GamepadClear")) {
+				ClearRecorded();
+			}
+		} else {
+			ImGui::Text("Click or press gamepad buttons to record them");
+		}
+	}
 
 	ImGui::Separator();
 
@@ -436,9 +1341,30 @@ void GamepadDemo() {
 	if (showTriggers) {
 		flags |= ImGuiGamepadFlags_ShowTriggers;
 	}
+	if (showStickHistogram) {
+		flags |= ImGuiGamepadFlags_ShowStickHistogram;
+	}
+	if (recordable) {
+		flags |= ImGuiGamepadFlags_Recordable;
+	}
 	Gamepad((ImGuiGamepadLayout)currentLayout, flags);
+
+	ImGui::Separator();
+	ImGui::Checkbox("Show Axis Scopes", &showAxisScopes);
+	if (showAxisScopes) {
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(120);
+		ImGui::SliderFloat("History (s)", &axisScopeHistory, 0.25f, 10.0f, "%.2f");
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Clear##AxisHistory")) {
+			ClearAxisHistory();
+		}
+		for (int axis = 0; axis < ImGuiGamepadAxis_COUNT; axis++) {
+			AxisScope(axis, ImVec2(0.0f, 0.0f), axisScopeHistory);
+		}
+	}
 }
-#endif // IMGUI_DISABLE_DEMO_WINDOWS
-#endif // IMGUI_DISABLE
+#endif // IMKEYBOARD_DISABLE_DEMO
+#endif // !IMGUI_DISABLE && !IMKEYBOARD_DISABLE_GAMEPAD
 
 } // namespace ImGamepad
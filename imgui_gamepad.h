@@ -27,6 +27,8 @@
 #pragma once
 
 #include "imgui.h"
+#include "imgui_keyboard_config.h"
+#include "imgui_input_state.h"
 
 namespace ImGamepad {
 
@@ -36,7 +38,7 @@ enum ImGuiGamepadLayout_ {
 	ImGuiGamepadLayout_Steam,		// Steam controller layout
 	ImGuiGamepadLayout_SwitchPro,	// Nintendo Switch pro controller layout
 
-	ImGuiGamepadLayout_Count
+	ImGuiGamepadLayout_Count // Number of built-in layouts, RegisterLayout() hands out the ids after this
 };
 typedef int ImGuiGamepadLayout;
 
@@ -51,6 +53,8 @@ enum ImGuiGamepadFlags_ {
 	ImGuiGamepadFlags_HideTriggers = 1 << 6,	  // Hide the trigger buttons (L2/R2)
 	ImGuiGamepadFlags_HideSticks = 1 << 7,		  // Hide the analog sticks
 	ImGuiGamepadFlags_HideCenterButtons = 1 << 8,  // Hide the center buttons (Start/Back)
+	ImGuiGamepadFlags_ShowStickHistogram = 1 << 9, // Accumulate stick positions and show them as a density grid
+	ImGuiGamepadFlags_Recordable = 1 << 10,		  // Button recording for keybinding selection (click or press)
 };
 typedef int ImGuiGamepadFlags;
 
@@ -67,11 +71,62 @@ enum ImGuiGamepadCol_ {
 	ImGuiGamepadCol_StickForeground,	// Analog stick position indicator
 	ImGuiGamepadCol_TriggerBackground,	// Trigger background
 	ImGuiGamepadCol_TriggerForeground,	// Trigger fill level
+	ImGuiGamepadCol_StickHistogram,		// Analog stick position density grid (alpha scales with sample count)
+	ImGuiGamepadCol_ButtonRecorded,		// Overlay when button is recorded (for keybinding selection)
 
 	ImGuiGamepadCol_COUNT
 };
 typedef int ImGuiGamepadCol;
 
+enum ImGuiGamepadStick_ {
+	ImGuiGamepadStick_None = -1, // Elements other than ImGuiGamepadElementType_Stick
+	ImGuiGamepadStick_Left,
+	ImGuiGamepadStick_Right,
+
+	ImGuiGamepadStick_COUNT
+};
+typedef int ImGuiGamepadStick;
+
+// Analog axes recorded for the axis scope (see AxisScope())
+enum ImGuiGamepadAxis_ {
+	ImGuiGamepadAxis_L2,		  // Left trigger [0, 1]
+	ImGuiGamepadAxis_R2,		  // Right trigger [0, 1]
+	ImGuiGamepadAxis_LeftStickX,  // Left stick horizontal [-1, 1]
+	ImGuiGamepadAxis_LeftStickY,  // Left stick vertical [-1, 1], down is positive
+	ImGuiGamepadAxis_RightStickX, // Right stick horizontal [-1, 1]
+	ImGuiGamepadAxis_RightStickY, // Right stick vertical [-1, 1], down is positive
+
+	ImGuiGamepadAxis_COUNT
+};
+typedef int ImGuiGamepadAxis;
+
+enum ImGuiGamepadElementType_ {
+	ImGuiGamepadElementType_Button,		  // Round face button (ImGuiGamepadStyle::ButtonSize)
+	ImGuiGamepadElementType_CenterButton, // Small round button like Start/Back (0.8 * ImGuiGamepadStyle::ButtonSize)
+	ImGuiGamepadElementType_Shoulder,	  // Rectangular button (TriggerWidth x 0.8 * TriggerHeight)
+	ImGuiGamepadElementType_Trigger,	  // Analog trigger with fill level (TriggerWidth x TriggerHeight)
+	ImGuiGamepadElementType_Stick,		  // Analog stick, the key is the stick click (ImGuiGamepadStyle::StickSize)
+	ImGuiGamepadElementType_DPad,		  // D-pad cross bound to the ImGuiKey_GamepadDpad* keys (DPadSize)
+};
+typedef int ImGuiGamepadElementType;
+
+// One element of a controller layout. Pos is the element center relative to the controller body: (0,0) is the top
+// left and (1,1) the bottom right corner, elements may be placed outside of the body (e.g. triggers above it).
+struct ImGuiGamepadElementDesc {
+	ImGuiGamepadElementType Type;
+	ImVec2 Pos;
+	ImVec2 Size;			 // Multiplier for the style size of the element type, (0,0) for the style size
+	const char *Label;		 // Can be nullptr
+	ImGuiKey Key;			 // Button key, unused for the D-pad
+	ImGuiGamepadStick Stick; // Axes shown by ImGuiGamepadElementType_Stick, ImGuiGamepadStick_None for the others
+};
+
+struct ImGuiGamepadLayoutDesc {
+	const char *Name;
+	const ImGuiGamepadElementDesc *Elements; // Drawn in order on top of the controller body
+	int ElementCount;
+};
+
 struct ImGuiGamepadStyle {
 	float Scale;		  // Overall scale factor (default: 1.0f)
 	float BodyWidth;	  // Controller body width (default: 200.0f)
@@ -92,7 +147,41 @@ struct ImGuiGamepadStyle {
 ImGuiGamepadStyle &GetStyle();
 void HighlightButton(ImGuiKey button, bool highlight);
 void ClearHighlights();
+void ClearRecorded();
+const ImVector<ImGuiKey> &GetRecordedButtons();
+// Stick position histogram (see ImGuiGamepadFlags_ShowStickHistogram). x and y are in [-1, 1].
+// Samples can be fed at input polling rate, adding a sample never allocates. Gamepad() adds the stick positions once
+// per frame and skips sticks at rest (0, 0), AddStickSample() records every sample it is given.
+void AddStickSample(ImGuiGamepadStick stick, float x, float y);
+void ClearStickHistograms();
+// Render buttons, sticks and triggers from an input state instead of the ImGui input (e.g. another process, see
+// imgui_input_mirror.h). The state must stay valid until Gamepad()/AxisScope() return, nullptr switches back to the
+// ImGui input. The axis history gets one sample per frame from it. Recording always uses the ImGui input.
+void SetInputState(const ImInputState *state);
 void Gamepad(ImGuiGamepadLayout layout, ImGuiGamepadFlags flags = 0);
+// Hash of what the Gamepad() calls of the frame drew, WantsRedraw() compares it with the previous frame (see
+// ImKeyboard::WantsRedraw()). ImGuiGamepadFlags_ShowStickHistogram changes it every frame, AxisScope() isn't covered.
+ImGuiID GetStateHash();
+bool WantsRedraw();
+// Axis history. Every analog key event of the frame is recorded (not just the value at frame time) while Gamepad() or
+// AxisScope() is called each frame. AddAxisSample() feeds an axis from another source instead (e.g. a polling loop
+// with a finer timestamp): it must be called from the ImGui thread with times in ImGui::GetTime() units, and the axis
+// is no longer recorded from the ImGui input until ClearAxisHistory(). Queue samples of an own input thread and pass
+// them on before NewFrame().
+void AddAxisSample(ImGuiGamepadAxis axis, float value, double time);
+void ClearAxisHistory();
+// Scrolling trace of the last 'history' seconds of an axis, decimated to per-pixel min/max.
+// A zero size uses the controller body width and three times the trigger height.
+void AxisScope(ImGuiGamepadAxis axis, const ImVec2 &size = ImVec2(0.0f, 0.0f), float history = 2.0f);
+// Custom controllers (fight sticks, flight sticks, arcade panels, ...). The elements are copied, the name and the
+// labels must stay valid. Returns the layout id to pass to Gamepad().
+ImGuiGamepadLayout RegisterLayout(const ImGuiGamepadLayoutDesc &desc);
+int GetLayoutCount();
+const char *GetLayoutName(ImGuiGamepadLayout layout);
+#ifndef IMKEYBOARD_DISABLE_DEMO
+// Registers the "Arcade Stick" example layout of GamepadDemo() once, call it from the demo setup to list it there
+ImGuiGamepadLayout RegisterDemoLayout();
 void GamepadDemo();
+#endif
 
 } // namespace ImGamepad
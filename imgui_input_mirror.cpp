@@ -0,0 +1,221 @@
+#include "imgui_input_mirror.h"
+#include <atomic>
+#include <string.h>
+
+#ifndef IM_INPUT_MIRROR_ASSERT
+#include <assert.h>
+#define IM_INPUT_MIRROR_ASSERT(_EXPR) assert(_EXPR)
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define IM_INPUT_MIRROR_POSIX
+#endif
+
+// The shared layout is a plain C struct, so the counters are accessed with word sized atomic loads and stores and
+// the ordering comes from explicit fences. MSVC keeps aligned 32 bit volatile accesses whole.
+#if defined(_MSC_VER) && !defined(__clang__)
+static uint32_t LoadRelaxed(const uint32_t *ptr) {
+	return *(const volatile uint32_t *)ptr;
+}
+
+static void StoreRelaxed(uint32_t *ptr, uint32_t value) {
+	*(volatile uint32_t *)ptr = value;
+}
+#else
+static uint32_t LoadRelaxed(const uint32_t *ptr) {
+	return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+}
+
+static void StoreRelaxed(uint32_t *ptr, uint32_t value) {
+	__atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+}
+#endif
+
+static uint32_t LoadAcquire(const uint32_t *ptr) {
+	const uint32_t value = LoadRelaxed(ptr);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return value;
+}
+
+static void StoreRelease(uint32_t *ptr, uint32_t value) {
+	std::atomic_thread_fence(std::memory_order_release);
+	StoreRelaxed(ptr, value);
+}
+
+ImInputMirrorWriter::ImInputMirrorWriter() {
+	Shared = nullptr;
+	Fd = -1;
+	Name[0] = '\0';
+}
+
+ImInputMirrorWriter::~ImInputMirrorWriter() {
+	Close();
+}
+
+bool ImInputMirrorWriter::Open(const char *name) {
+#ifdef IM_INPUT_MIRROR_POSIX
+	Close();
+	if (name == nullptr || name[0] != '/' || strlen(name) >= sizeof(Name)) {
+		return false;
+	}
+	Fd = shm_open(name, O_CREAT | O_RDWR, 0600);
+	if (Fd == -1) {
+		return false;
+	}
+	strcpy(Name, name); // From here on Close() unlinks the object
+	if (ftruncate(Fd, (off_t)sizeof(ImInputMirrorShared)) == -1) {
+		Close();
+		return false;
+	}
+	void *mem = mmap(nullptr, sizeof(ImInputMirrorShared), PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+	if (mem == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	Shared = (ImInputMirrorShared *)mem;
+	// A writer that died inside BeginWrite() left an odd sequence and a half written buffer. Roll back to the last
+	// complete state, the next BeginWrite() overwrites the broken buffer before it is published.
+	const uint32_t sequence = LoadRelaxed(&Shared->Sequence);
+	StoreRelease(&Shared->Sequence, sequence & ~1u);
+	// Readers check the magic, write it last
+	Shared->Version = IM_INPUT_STATE_VERSION;
+	StoreRelease(&Shared->Magic, IM_INPUT_MIRROR_MAGIC);
+	return true;
+#else
+	(void)name;
+	return false;
+#endif
+}
+
+void ImInputMirrorWriter::Close() {
+#ifdef IM_INPUT_MIRROR_POSIX
+	if (Shared != nullptr) {
+		munmap(Shared, sizeof(ImInputMirrorShared));
+		Shared = nullptr;
+	}
+	if (Fd != -1) {
+		close(Fd);
+		Fd = -1;
+	}
+	if (Name[0] != '\0') {
+		shm_unlink(Name);
+		Name[0] = '\0';
+	}
+#endif
+}
+
+ImInputState *ImInputMirrorWriter::BeginWrite() {
+	if (Shared == nullptr) {
+		return nullptr;
+	}
+	// Single writer, no need for an atomic load of our own counter
+	const uint32_t sequence = Shared->Sequence;
+	IM_INPUT_MIRROR_ASSERT((sequence & 1) == 0 && "BeginWrite() called twice");
+	StoreRelaxed(&Shared->Sequence, sequence + 1);
+	// Keeps the buffer writes from becoming visible before the odd sequence
+	std::atomic_thread_fence(std::memory_order_release);
+	return &Shared->Buffers[((sequence >> 1) + 1) & 1];
+}
+
+void ImInputMirrorWriter::EndWrite() {
+	if (Shared == nullptr) {
+		return;
+	}
+	const uint32_t sequence = Shared->Sequence;
+	IM_INPUT_MIRROR_ASSERT((sequence & 1) == 1 && "EndWrite() without BeginWrite()");
+	ImInputState *state = &Shared->Buffers[((sequence >> 1) + 1) & 1];
+	state->Version = IM_INPUT_STATE_VERSION;
+	state->Size = (uint32_t)sizeof(ImInputState);
+	StoreRelease(&Shared->Sequence, sequence + 1);
+}
+
+void ImInputMirrorWriter::Publish(const ImInputState &state) {
+	ImInputState *dest = BeginWrite();
+	if (dest == nullptr) {
+		return;
+	}
+	memcpy(dest, &state, sizeof(state));
+	EndWrite();
+}
+
+ImInputMirrorReader::ImInputMirrorReader() {
+	Shared = nullptr;
+	Fd = -1;
+	AcquiredSequence = 0;
+}
+
+ImInputMirrorReader::~ImInputMirrorReader() {
+	Close();
+}
+
+bool ImInputMirrorReader::Open(const char *name) {
+#ifdef IM_INPUT_MIRROR_POSIX
+	Close();
+	if (name == nullptr) {
+		return false;
+	}
+	Fd = shm_open(name, O_RDONLY, 0);
+	if (Fd == -1) {
+		return false;
+	}
+	struct stat st;
+	if (fstat(Fd, &st) == -1 || st.st_size < (off_t)sizeof(ImInputMirrorShared)) {
+		Close();
+		return false;
+	}
+	void *mem = mmap(nullptr, sizeof(ImInputMirrorShared), PROT_READ, MAP_SHARED, Fd, 0);
+	if (mem == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	Shared = (const ImInputMirrorShared *)mem;
+	if (LoadAcquire(&Shared->Magic) != IM_INPUT_MIRROR_MAGIC ||
+		Shared->Version != IM_INPUT_STATE_VERSION) {
+		Close();
+		return false;
+	}
+	return true;
+#else
+	(void)name;
+	return false;
+#endif
+}
+
+void ImInputMirrorReader::Close() {
+#ifdef IM_INPUT_MIRROR_POSIX
+	if (Shared != nullptr) {
+		munmap((void *)Shared, sizeof(ImInputMirrorShared));
+		Shared = nullptr;
+	}
+	if (Fd != -1) {
+		close(Fd);
+		Fd = -1;
+	}
+#endif
+}
+
+const ImInputState *ImInputMirrorReader::Acquire() {
+	if (Shared == nullptr) {
+		return nullptr;
+	}
+	AcquiredSequence = LoadAcquire(&Shared->Sequence);
+	if ((AcquiredSequence >> 1) == 0) {
+		return nullptr;
+	}
+	return &Shared->Buffers[(AcquiredSequence >> 1) & 1];
+}
+
+bool ImInputMirrorReader::IsConsistent() const {
+	if (Shared == nullptr) {
+		return false;
+	}
+	// The writer starts on our buffer again when it begins the second state after the acquired one
+	const uint32_t acquired_end = (AcquiredSequence & ~1u) + 2;
+	// Keeps the caller's buffer reads from moving after the sequence check
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return (int32_t)(LoadRelaxed(&Shared->Sequence) - acquired_end) <= 0;
+}
@@ -0,0 +1,109 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Publish an ImInputState from one process and render it in another one on the same machine, without serializing.
+// Uses a POSIX shared memory object (shm_open) holding two state buffers and a sequence counter. The writer fills the
+// buffer the readers are not looking at, the readers use the last complete buffer in place. The sequence is incremented
+// when a write begins and when it ends (odd while writing), so readers can tell if their buffer was written to.
+// Doesn't depend on Dear ImGui, the game side only needs this file, imgui_input_mirror.cpp and imgui_input_state.h.
+//
+// Shared memory layout (native byte order, 16 + 2 * sizeof(ImInputState) bytes):
+//
+//   offset  size                  field
+//        0     4                  Magic     IM_INPUT_MIRROR_MAGIC
+//        4     4                  Version   IM_INPUT_STATE_VERSION
+//        8     4                  Sequence  Twice the number of published states, +1 while writing (fenced stores)
+//       12     4                  Reserved
+//       16     sizeof(ImInputState)  Buffers[0]
+//     1112     sizeof(ImInputState)  Buffers[1]
+//
+// Buffers[(Sequence >> 1) & 1] is the last complete state, the writer fills Buffers[((Sequence >> 1) + 1) & 1].
+//
+// Usage:
+//
+//   // Game process
+//   ImInputMirrorWriter writer;
+//   writer.Open("/mygame_input");
+//   ImInputState *state = writer.BeginWrite();
+//   ... fill the whole state (or ImInputStateCapture(state)) ...
+//   writer.EndWrite();
+//
+//   // Tools process, every frame
+//   ImInputMirrorReader reader;
+//   reader.Open("/mygame_input");
+//   ImKeyboard::SetInputState(reader.Acquire());
+
+#include "imgui_input_state.h"
+
+#define IM_INPUT_MIRROR_MAGIC 0x524D4E49u // "INMR"
+
+typedef struct ImInputMirrorShared {
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t Sequence;
+	uint32_t Reserved;
+	ImInputState Buffers[2];
+} ImInputMirrorShared;
+
+#ifdef __cplusplus
+
+struct ImInputMirrorWriter {
+	ImInputMirrorShared *Shared;
+	int Fd;
+	char Name[64];
+
+	ImInputMirrorWriter();
+	~ImInputMirrorWriter();
+	// Creates (or reuses) the shared memory object, name must start with '/'
+	bool Open(const char *name);
+	// Unmaps and removes the shared memory object
+	void Close();
+	// The buffer to fill, it is not visible to readers until EndWrite(). The previous content is undefined.
+	ImInputState *BeginWrite();
+	void EndWrite();
+	void Publish(const ImInputState &state);
+};
+
+struct ImInputMirrorReader {
+	const ImInputMirrorShared *Shared;
+	int Fd;
+	uint32_t AcquiredSequence;
+
+	ImInputMirrorReader();
+	~ImInputMirrorReader();
+	// Fails if the writer didn't create the object yet or it has a different version
+	bool Open(const char *name);
+	void Close();
+	// The last published state in place, nullptr if none was published yet. It stays intact until the writer begins
+	// the second state after it - a writer faster than the reader can mix newer values into it, see IsConsistent().
+	const ImInputState *Acquire();
+	// True if the state returned by the last Acquire() was not overwritten in the meantime
+	bool IsConsistent() const;
+};
+
+#endif
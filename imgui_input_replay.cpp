@@ -0,0 +1,424 @@
+#include "imgui_input_replay.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef IM_INPUT_REPLAY_ASSERT
+#include <assert.h>
+#define IM_INPUT_REPLAY_ASSERT(_EXPR) assert(_EXPR)
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define IM_INPUT_REPLAY_POSIX
+#endif
+
+enum ImInputReplayRecord_ {
+	ImInputReplayRecord_Keyframe = 'K',
+	ImInputReplayRecord_Delta = 'D',
+};
+
+static const size_t HeaderSize = 16;
+
+// Same conversion as ImInputStateEncodeDelta(), so the deltas add up to the exact keyframe times
+static int64_t ToMicroseconds(double time) {
+	return (int64_t)llround(time * 1000000.0);
+}
+
+static unsigned char *WriteVarint(unsigned char *out, uint64_t value) {
+	while (value >= 0x80) {
+		*out++ = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	*out++ = (unsigned char)value;
+	return out;
+}
+
+static const unsigned char *ReadVarint(const unsigned char *data, const unsigned char *end, uint64_t *value) {
+	uint64_t result = 0;
+	for (int shift = 0; shift < 64 && data < end; shift += 7) {
+		const unsigned char byte = *data++;
+		result |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			*value = result;
+			return data;
+		}
+	}
+	return nullptr;
+}
+
+ImInputReplayWriter::ImInputReplayWriter() {
+	File = nullptr;
+	ImInputStateInit(&Prev);
+	HasPrev = false;
+	KeyframeInterval = 1.0;
+	LastKeyframeTime = 0.0;
+	Offset = 0;
+	Index = nullptr;
+	IndexCount = IndexCapacity = 0;
+	Failed = false;
+}
+
+ImInputReplayWriter::~ImInputReplayWriter() {
+	Close();
+}
+
+static void WriteBytes(ImInputReplayWriter *writer, const void *data, size_t size) {
+	if (fwrite(data, 1, size, writer->File) != size) {
+		writer->Failed = true;
+	}
+	writer->Offset += size;
+}
+
+bool ImInputReplayWriter::Open(const char *path, double keyframe_interval) {
+	Close();
+	IM_INPUT_REPLAY_ASSERT(keyframe_interval > 0.0);
+	File = fopen(path, "wb");
+	if (File == nullptr) {
+		return false;
+	}
+	HasPrev = false;
+	KeyframeInterval = keyframe_interval;
+	Offset = 0;
+	IndexCount = 0;
+	Failed = false;
+	const uint32_t header[4] = {IM_INPUT_REPLAY_MAGIC, IM_INPUT_STATE_VERSION, (uint32_t)sizeof(ImInputState), 0};
+	WriteBytes(this, header, sizeof(header));
+	return !Failed;
+}
+
+bool ImInputReplayWriter::Close() {
+	if (File == nullptr) {
+		return true;
+	}
+	ImInputReplayFooter footer;
+	footer.EndTime = HasPrev ? Prev.Time : 0.0;
+	footer.RecordsEnd = Offset;
+	const unsigned char padding[8] = {};
+	WriteBytes(this, padding, (size_t)((8 - (Offset & 7)) & 7));
+	footer.IndexOffset = Offset;
+	footer.IndexCount = (uint32_t)IndexCount;
+	footer.Magic = IM_INPUT_REPLAY_MAGIC;
+	WriteBytes(this, Index, sizeof(ImInputReplayIndexEntry) * IndexCount);
+	WriteBytes(this, &footer, sizeof(footer));
+	if (fclose(File) != 0) {
+		Failed = true;
+	}
+	File = nullptr;
+	free(Index);
+	Index = nullptr;
+	IndexCount = IndexCapacity = 0;
+	return !Failed;
+}
+
+bool ImInputReplayWriter::Add(const ImInputState &state) {
+	if (File == nullptr) {
+		return false;
+	}
+	if (HasPrev) {
+		IM_INPUT_REPLAY_ASSERT(state.Time >= Prev.Time && "Times must not go backwards");
+		ImInputState same_time = state;
+		same_time.Time = Prev.Time;
+		if (memcmp(&same_time, &Prev, sizeof(ImInputState)) == 0) {
+			return true;
+		}
+	}
+
+	if (!HasPrev || state.Time - LastKeyframeTime >= KeyframeInterval) {
+		if (IndexCount == IndexCapacity) {
+			const int capacity = IndexCapacity > 0 ? IndexCapacity * 2 : 64;
+			ImInputReplayIndexEntry *index =
+				(ImInputReplayIndexEntry *)realloc(Index, sizeof(ImInputReplayIndexEntry) * capacity);
+			if (index == nullptr) {
+				Failed = true;
+				return false;
+			}
+			Index = index;
+			IndexCapacity = capacity;
+		}
+		Index[IndexCount].Time = state.Time;
+		Index[IndexCount].Offset = Offset;
+		IndexCount++;
+		const unsigned char tag = ImInputReplayRecord_Keyframe;
+		WriteBytes(this, &tag, 1);
+		WriteBytes(this, &state, sizeof(state));
+		LastKeyframeTime = state.Time;
+	} else {
+		unsigned char record[1 + 10 + IM_INPUT_STATE_MAX_DELTA_SIZE];
+		unsigned char delta[IM_INPUT_STATE_MAX_DELTA_SIZE];
+		const int delta_size = ImInputStateEncodeDelta(&Prev, &state, delta);
+		record[0] = ImInputReplayRecord_Delta;
+		unsigned char *p = WriteVarint(record + 1, (uint64_t)delta_size);
+		memcpy(p, delta, delta_size);
+		WriteBytes(this, record, (size_t)(p - record) + delta_size);
+	}
+	Prev = state;
+	HasPrev = true;
+	return !Failed;
+}
+
+ImInputReplayReader::ImInputReplayReader() {
+	Data = nullptr;
+	Size = 0;
+	Fd = -1;
+	Index = nullptr;
+	OwnedIndex = nullptr;
+	IndexCount = 0;
+	RecordsEnd = 0;
+	EndTime = 0.0;
+	ImInputStateInit(&State);
+	TimeUs = 0;
+	Cursor = 0;
+	StateValid = false;
+}
+
+ImInputReplayReader::~ImInputReplayReader() {
+	Close();
+}
+
+// Time change of a delta record without decoding it
+static bool PeekDeltaTime(const unsigned char *data, const unsigned char *end, int64_t *out_dt) {
+	uint64_t value;
+	if (ReadVarint(data, end, &value) == nullptr) {
+		return false;
+	}
+	*out_dt = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	return true;
+}
+
+// Parses the record at offset: its type, payload and size. Returns false for unknown or truncated records.
+static bool ParseRecord(const ImInputReplayReader *reader, size_t offset, unsigned char *out_tag,
+						const unsigned char **out_payload, size_t *out_payload_size) {
+	const unsigned char *data = reader->Data + offset;
+	const unsigned char *end = reader->Data + reader->RecordsEnd;
+	if (data >= end) {
+		return false;
+	}
+	*out_tag = *data++;
+	if (*out_tag == ImInputReplayRecord_Keyframe) {
+		*out_payload = data;
+		*out_payload_size = sizeof(ImInputState);
+	} else if (*out_tag == ImInputReplayRecord_Delta) {
+		uint64_t size;
+		if ((data = ReadVarint(data, end, &size)) == nullptr || size > IM_INPUT_STATE_MAX_DELTA_SIZE) {
+			return false;
+		}
+		*out_payload = data;
+		*out_payload_size = (size_t)size;
+	} else {
+		return false;
+	}
+	return (size_t)(end - *out_payload) >= *out_payload_size;
+}
+
+// Index of a file whose recording wasn't closed, from a scan of the records. Stops at the first truncated record.
+static bool RebuildIndex(ImInputReplayReader *reader) {
+	reader->RecordsEnd = reader->Size;
+	int capacity = 0;
+	int64_t time_us = 0;
+	size_t offset = HeaderSize;
+	unsigned char tag;
+	const unsigned char *payload;
+	size_t payload_size;
+	while (ParseRecord(reader, offset, &tag, &payload, &payload_size)) {
+		if (tag == ImInputReplayRecord_Keyframe) {
+			double time;
+			memcpy(&time, payload + offsetof(ImInputState, Time), sizeof(time));
+			if (reader->IndexCount == capacity) {
+				capacity = capacity > 0 ? capacity * 2 : 64;
+				ImInputReplayIndexEntry *index =
+					(ImInputReplayIndexEntry *)realloc(reader->OwnedIndex, sizeof(ImInputReplayIndexEntry) * capacity);
+				if (index == nullptr) {
+					return false;
+				}
+				reader->OwnedIndex = index;
+			}
+			reader->OwnedIndex[reader->IndexCount].Time = time;
+			reader->OwnedIndex[reader->IndexCount].Offset = offset;
+			reader->IndexCount++;
+			time_us = ToMicroseconds(time);
+		} else {
+			int64_t dt;
+			if (reader->IndexCount == 0 || !PeekDeltaTime(payload, payload + payload_size, &dt)) {
+				break;
+			}
+			time_us += dt;
+		}
+		offset = (size_t)(payload - reader->Data) + payload_size;
+	}
+	reader->RecordsEnd = offset;
+	reader->EndTime = (double)time_us / 1000000.0;
+	reader->Index = reader->OwnedIndex;
+	return true;
+}
+
+bool ImInputReplayReader::Open(const char *path) {
+	Close();
+#ifdef IM_INPUT_REPLAY_POSIX
+	Fd = open(path, O_RDONLY);
+	if (Fd == -1) {
+		return false;
+	}
+	struct stat st;
+	if (fstat(Fd, &st) == -1 || st.st_size < (off_t)HeaderSize) {
+		Close();
+		return false;
+	}
+	Size = (size_t)st.st_size;
+	void *mem = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Fd, 0);
+	if (mem == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	Data = (const unsigned char *)mem;
+#else
+	FILE *file = fopen(path, "rb");
+	if (file == nullptr) {
+		return false;
+	}
+	unsigned char *data = nullptr;
+	long size = -1;
+	if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= (long)HeaderSize && fseek(file, 0, SEEK_SET) == 0 &&
+		(data = (unsigned char *)malloc((size_t)size)) != nullptr &&
+		fread(data, 1, (size_t)size, file) != (size_t)size) {
+		free(data);
+		data = nullptr;
+	}
+	fclose(file);
+	if (data == nullptr) {
+		return false;
+	}
+	Data = data;
+	Size = (size_t)size;
+#endif
+
+	uint32_t header[4];
+	memcpy(header, Data, sizeof(header));
+	if (header[0] != IM_INPUT_REPLAY_MAGIC || header[1] != IM_INPUT_STATE_VERSION ||
+		header[2] != sizeof(ImInputState)) {
+		Close();
+		return false;
+	}
+	ImInputReplayFooter footer;
+	bool has_footer = false;
+	if (Size >= HeaderSize + sizeof(footer)) {
+		memcpy(&footer, Data + Size - sizeof(footer), sizeof(footer));
+		has_footer = footer.Magic == IM_INPUT_REPLAY_MAGIC && (footer.IndexOffset & 7) == 0 &&
+					 footer.RecordsEnd >= HeaderSize && footer.RecordsEnd <= footer.IndexOffset &&
+					 footer.IndexOffset + sizeof(ImInputReplayIndexEntry) * (uint64_t)footer.IndexCount ==
+						 Size - sizeof(footer);
+	}
+	if (has_footer) {
+		Index = (const ImInputReplayIndexEntry *)(Data + footer.IndexOffset);
+		IndexCount = (int)footer.IndexCount;
+		RecordsEnd = (size_t)footer.RecordsEnd;
+		EndTime = footer.EndTime;
+	} else if (!RebuildIndex(this)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void ImInputReplayReader::Close() {
+#ifdef IM_INPUT_REPLAY_POSIX
+	if (Data != nullptr) {
+		munmap((void *)Data, Size);
+	}
+	if (Fd != -1) {
+		close(Fd);
+	}
+#else
+	free((void *)Data);
+#endif
+	free(OwnedIndex);
+	Data = nullptr;
+	Size = 0;
+	Fd = -1;
+	Index = nullptr;
+	OwnedIndex = nullptr;
+	IndexCount = 0;
+	RecordsEnd = 0;
+	EndTime = 0.0;
+	StateValid = false;
+}
+
+static bool LoadKeyframe(ImInputReplayReader *reader, size_t offset) {
+	unsigned char tag;
+	const unsigned char *payload;
+	size_t payload_size;
+	if (!ParseRecord(reader, offset, &tag, &payload, &payload_size) || tag != ImInputReplayRecord_Keyframe) {
+		return false;
+	}
+	memcpy(&reader->State, payload, sizeof(ImInputState));
+	if (reader->State.Version != IM_INPUT_STATE_VERSION || reader->State.Size != sizeof(ImInputState)) {
+		return false;
+	}
+	reader->TimeUs = ToMicroseconds(reader->State.Time);
+	reader->Cursor = (size_t)(payload - reader->Data) + payload_size;
+	return true;
+}
+
+const ImInputState *ImInputReplayReader::Seek(double time) {
+	if (Data == nullptr || IndexCount == 0) {
+		return nullptr;
+	}
+	const int64_t target = ToMicroseconds(time);
+
+	// Last keyframe at or before the time, the first one if the time is before the recording
+	int lo = 0;
+	int hi = IndexCount - 1;
+	while (lo < hi) {
+		const int mid = (lo + hi + 1) / 2;
+		if (ToMicroseconds(Index[mid].Time) <= target) {
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	const size_t keyframe = (size_t)Index[lo].Offset;
+	if (!(StateValid && TimeUs <= target && Cursor > keyframe)) {
+		StateValid = LoadKeyframe(this, keyframe);
+		if (!StateValid) {
+			return nullptr;
+		}
+	}
+
+	unsigned char tag;
+	const unsigned char *payload;
+	size_t payload_size;
+	while (Cursor < RecordsEnd) {
+		if (!ParseRecord(this, Cursor, &tag, &payload, &payload_size)) {
+			StateValid = false;
+			return nullptr;
+		}
+		if (tag == ImInputReplayRecord_Keyframe) {
+			double keyframe_time;
+			memcpy(&keyframe_time, payload + offsetof(ImInputState, Time), sizeof(keyframe_time));
+			if (ToMicroseconds(keyframe_time) > target) {
+				break;
+			}
+			StateValid = LoadKeyframe(this, Cursor);
+		} else {
+			int64_t dt;
+			if (!PeekDeltaTime(payload, payload + payload_size, &dt)) {
+				StateValid = false;
+				return nullptr;
+			}
+			if (TimeUs + dt > target) {
+				break;
+			}
+			StateValid = ImInputStateDecodeDelta(&State, payload, (int)payload_size);
+			TimeUs += dt;
+			State.Time = (double)TimeUs / 1000000.0;
+			Cursor = (size_t)(payload - Data) + payload_size;
+		}
+		if (!StateValid) {
+			return nullptr;
+		}
+	}
+	return &State;
+}
@@ -0,0 +1,135 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Record ImInputState snapshots to a compact file and replay them with random access, e.g. to review QA sessions or
+// reproduce input bugs. Records are the deltas of ImInputStateEncodeDelta() (zigzag varint microsecond timestamps,
+// varint key indices with down/up ops), with a full state keyframe every KeyframeInterval seconds. An index of the
+// keyframes at the end of the file makes seeking O(log keyframes + records since the keyframe). The reader maps the
+// file (mmap on POSIX, read into memory elsewhere), so multi-hour sessions open instantly. Files of a recording that
+// was never closed have no index, the reader rebuilds it by scanning the records.
+//
+// File layout (native byte order):
+//
+//   Header        16 bytes   Magic IM_INPUT_REPLAY_MAGIC, Version IM_INPUT_STATE_VERSION, StateSize, Reserved
+//   Records       ...        'K' + ImInputState (keyframe, absolute Time)
+//                            'D' + varint size + delta to the previous record (ImInputStateEncodeDelta())
+//   Padding       0-7 bytes  Zeros up to a multiple of 8, so the mapped index is aligned
+//   Index         16 bytes   per keyframe: Time (double), Offset of its record (uint64)
+//   Footer        32 bytes   EndTime (double), RecordsEnd (uint64), IndexOffset (uint64), IndexCount, Magic
+//
+// Usage:
+//
+//   // Recording, once per frame
+//   ImInputReplayWriter writer;
+//   writer.Open("session.inrp");
+//   ImInputState state;
+//   ImInputStateCapture(&state);
+//   writer.Add(state);
+//   ...
+//   writer.Close();
+//
+//   // Playback
+//   ImInputReplayReader reader;
+//   reader.Open("session.inrp");
+//   ImKeyboard::SetInputState(reader.Seek(reader.GetStartTime() + playback_time));
+
+#include "imgui_input_state.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define IM_INPUT_REPLAY_MAGIC 0x50524E49u // "INRP"
+
+typedef struct ImInputReplayIndexEntry {
+	double Time;
+	uint64_t Offset;
+} ImInputReplayIndexEntry;
+
+typedef struct ImInputReplayFooter {
+	double EndTime;		  // Time of the last record
+	uint64_t RecordsEnd;  // Offset after the last record
+	uint64_t IndexOffset; // Aligned to 8 bytes
+	uint32_t IndexCount;
+	uint32_t Magic;
+} ImInputReplayFooter;
+
+#ifdef __cplusplus
+
+struct ImInputReplayWriter {
+	FILE *File;
+	ImInputState Prev; // Last written state
+	bool HasPrev;
+	double KeyframeInterval;
+	double LastKeyframeTime;
+	uint64_t Offset; // Of the next record
+	ImInputReplayIndexEntry *Index;
+	int IndexCount;
+	int IndexCapacity;
+	bool Failed; // A write failed
+
+	ImInputReplayWriter();
+	~ImInputReplayWriter();
+	// Creates or truncates the file. Shorter keyframe intervals make seeking faster and the file larger.
+	bool Open(const char *path, double keyframe_interval = 1.0);
+	// Writes the index and closes the file. Returns false if a write failed.
+	bool Close();
+	// Appends a state, times must not go backwards. States equal to the previous one (apart from Time) are skipped.
+	bool Add(const ImInputState &state);
+};
+
+struct ImInputReplayReader {
+	const unsigned char *Data;
+	size_t Size;
+	int Fd;						   // -1 when Data was read into memory instead of mapped
+	const ImInputReplayIndexEntry *Index; // Points into Data, or to OwnedIndex
+	ImInputReplayIndexEntry *OwnedIndex;  // Rebuilt index of a file without footer
+	int IndexCount;
+	size_t RecordsEnd;
+	double EndTime;
+	ImInputState State; // State at the last Seek() time
+	int64_t TimeUs;		// Time of State in microseconds, kept exact instead of going through State.Time
+	size_t Cursor;		// Offset of the record after State
+	bool StateValid;
+
+	ImInputReplayReader();
+	~ImInputReplayReader();
+	bool Open(const char *path);
+	void Close();
+	double GetStartTime() const {
+		return IndexCount > 0 ? Index[0].Time : 0.0;
+	}
+	double GetEndTime() const {
+		return EndTime;
+	}
+	// State at a recording time (clamped to the recording), nullptr if the file has no records or is corrupt. Seeking
+	// forward from the current position only decodes the records in between, other seeks start at the last keyframe
+	// before the time. The state stays valid until the next Seek() or Close().
+	const ImInputState *Seek(double time);
+};
+
+#endif
@@ -0,0 +1,239 @@
+#include "imgui_input_state.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <math.h>
+
+#ifndef IMGUI_DISABLE
+
+IM_STATIC_ASSERT(sizeof(ImInputState) == 1096);
+IM_STATIC_ASSERT(ImInputKey_COUNT <= IM_INPUT_STATE_MAX_KEYS);
+IM_STATIC_ASSERT(ImGuiMouseButton_COUNT <= 32);
+
+// ImGuiKey of each ImInputKey id
+static const ImGuiKey input_state_keys[] = {
+	ImGuiKey_Tab, ImGuiKey_LeftArrow, ImGuiKey_RightArrow, ImGuiKey_UpArrow, ImGuiKey_DownArrow, ImGuiKey_PageUp,
+	ImGuiKey_PageDown, ImGuiKey_Home, ImGuiKey_End, ImGuiKey_Insert, ImGuiKey_Delete, ImGuiKey_Backspace,
+	ImGuiKey_Space, ImGuiKey_Enter, ImGuiKey_Escape, ImGuiKey_LeftCtrl, ImGuiKey_LeftShift, ImGuiKey_LeftAlt,
+	ImGuiKey_LeftSuper, ImGuiKey_RightCtrl, ImGuiKey_RightShift, ImGuiKey_RightAlt, ImGuiKey_RightSuper, ImGuiKey_Menu,
+	ImGuiKey_0, ImGuiKey_1, ImGuiKey_2, ImGuiKey_3, ImGuiKey_4, ImGuiKey_5, ImGuiKey_6, ImGuiKey_7, ImGuiKey_8,
+	ImGuiKey_9, ImGuiKey_A, ImGuiKey_B, ImGuiKey_C, ImGuiKey_D, ImGuiKey_E, ImGuiKey_F, ImGuiKey_G, ImGuiKey_H,
+	ImGuiKey_I, ImGuiKey_J, ImGuiKey_K, ImGuiKey_L, ImGuiKey_M, ImGuiKey_N, ImGuiKey_O, ImGuiKey_P, ImGuiKey_Q,
+	ImGuiKey_R, ImGuiKey_S, ImGuiKey_T, ImGuiKey_U, ImGuiKey_V, ImGuiKey_W, ImGuiKey_X, ImGuiKey_Y, ImGuiKey_Z,
+	ImGuiKey_F1, ImGuiKey_F2, ImGuiKey_F3, ImGuiKey_F4, ImGuiKey_F5, ImGuiKey_F6, ImGuiKey_F7, ImGuiKey_F8,
+	ImGuiKey_F9, ImGuiKey_F10, ImGuiKey_F11, ImGuiKey_F12, ImGuiKey_F13, ImGuiKey_F14, ImGuiKey_F15, ImGuiKey_F16,
+	ImGuiKey_F17, ImGuiKey_F18, ImGuiKey_F19, ImGuiKey_F20, ImGuiKey_F21, ImGuiKey_F22, ImGuiKey_F23, ImGuiKey_F24,
+	ImGuiKey_Apostrophe, ImGuiKey_Comma, ImGuiKey_Minus, ImGuiKey_Period, ImGuiKey_Slash, ImGuiKey_Semicolon,
+	ImGuiKey_Equal, ImGuiKey_LeftBracket, ImGuiKey_Backslash, ImGuiKey_RightBracket, ImGuiKey_GraveAccent,
+	ImGuiKey_CapsLock, ImGuiKey_ScrollLock, ImGuiKey_NumLock, ImGuiKey_PrintScreen, ImGuiKey_Pause, ImGuiKey_Keypad0,
+	ImGuiKey_Keypad1, ImGuiKey_Keypad2, ImGuiKey_Keypad3, ImGuiKey_Keypad4, ImGuiKey_Keypad5, ImGuiKey_Keypad6,
+	ImGuiKey_Keypad7, ImGuiKey_Keypad8, ImGuiKey_Keypad9, ImGuiKey_KeypadDecimal, ImGuiKey_KeypadDivide,
+	ImGuiKey_KeypadMultiply, ImGuiKey_KeypadSubtract, ImGuiKey_KeypadAdd, ImGuiKey_KeypadEnter, ImGuiKey_KeypadEqual,
+	ImGuiKey_AppBack, ImGuiKey_AppForward, ImGuiKey_Oem102, ImGuiKey_GamepadStart, ImGuiKey_GamepadBack,
+	ImGuiKey_GamepadFaceLeft, ImGuiKey_GamepadFaceRight, ImGuiKey_GamepadFaceUp, ImGuiKey_GamepadFaceDown,
+	ImGuiKey_GamepadDpadLeft, ImGuiKey_GamepadDpadRight, ImGuiKey_GamepadDpadUp, ImGuiKey_GamepadDpadDown,
+	ImGuiKey_GamepadL1, ImGuiKey_GamepadR1, ImGuiKey_GamepadL2, ImGuiKey_GamepadR2, ImGuiKey_GamepadL3,
+	ImGuiKey_GamepadR3, ImGuiKey_GamepadLStickLeft, ImGuiKey_GamepadLStickRight, ImGuiKey_GamepadLStickUp,
+	ImGuiKey_GamepadLStickDown, ImGuiKey_GamepadRStickLeft, ImGuiKey_GamepadRStickRight, ImGuiKey_GamepadRStickUp,
+	ImGuiKey_GamepadRStickDown, ImGuiKey_MouseLeft, ImGuiKey_MouseRight, ImGuiKey_MouseMiddle, ImGuiKey_MouseX1,
+	ImGuiKey_MouseX2, ImGuiKey_MouseWheelX, ImGuiKey_MouseWheelY,
+};
+IM_STATIC_ASSERT(IM_ARRAYSIZE(input_state_keys) == ImInputKey_COUNT);
+
+// Key index of each named ImGuiKey, built once
+struct ImInputStateKeyIndices {
+	short Indices[ImGuiKey_NamedKey_COUNT];
+
+	ImInputStateKeyIndices() {
+		for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+			Indices[k] = -1;
+		}
+		for (int i = 0; i < ImInputKey_COUNT; i++) {
+			Indices[input_state_keys[i] - ImGuiKey_NamedKey_BEGIN] = (short)i;
+		}
+	}
+};
+
+int ImInputStateGetKeyIndex(ImGuiKey key) {
+	static const ImInputStateKeyIndices key_indices;
+	if (key < ImGuiKey_NamedKey_BEGIN || key >= ImGuiKey_NamedKey_END) {
+		return -1;
+	}
+	return key_indices.Indices[key - ImGuiKey_NamedKey_BEGIN];
+}
+
+ImGuiKey ImInputStateGetKey(int key_index) {
+	return key_index >= 0 && key_index < ImInputKey_COUNT ? input_state_keys[key_index] : ImGuiKey_None;
+}
+
+void ImInputStateCapture(ImInputState *state) {
+	memset(state, 0, sizeof(*state));
+	state->Version = IM_INPUT_STATE_VERSION;
+	state->Size = (uint32_t)sizeof(*state);
+	state->Time = ImGui::GetTime();
+	for (int key_index = 0; key_index < ImInputKey_COUNT; key_index++) {
+		const ImGuiKeyData *data = ImGui::GetKeyData(input_state_keys[key_index]);
+		ImInputStateSetKeyDown(state, key_index, data->Down);
+		state->KeysAnalog[key_index] = data->AnalogValue;
+	}
+	const ImGuiIO &io = ImGui::GetIO();
+	for (int button = 0; button < ImGuiMouseButton_COUNT; button++) {
+		if (io.MouseDown[button]) {
+			state->MouseButtons |= (uint32_t)1 << button;
+		}
+	}
+	state->MousePos[0] = io.MousePos.x;
+	state->MousePos[1] = io.MousePos.y;
+	state->MouseWheel[0] = io.MouseWheelH;
+	state->MouseWheel[1] = io.MouseWheel;
+}
+
+enum ImInputDeltaOp_ {
+	ImInputDeltaOp_KeyDown = 1,		 // varint key index
+	ImInputDeltaOp_KeyUp = 2,		 // varint key index
+	ImInputDeltaOp_KeyAnalog = 3,	 // varint key index, float
+	ImInputDeltaOp_MouseButtons = 4, // varint button mask
+	ImInputDeltaOp_MousePos = 5,	 // float x, float y
+	ImInputDeltaOp_MouseWheel = 6,	 // float x, float y
+};
+
+static unsigned char *WriteVarint(unsigned char *out, uint64_t value) {
+	while (value >= 0x80) {
+		*out++ = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	*out++ = (unsigned char)value;
+	return out;
+}
+
+static const unsigned char *ReadVarint(const unsigned char *data, const unsigned char *end, uint64_t *value) {
+	uint64_t result = 0;
+	for (int shift = 0; shift < 64 && data < end; shift += 7) {
+		const unsigned char byte = *data++;
+		result |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			*value = result;
+			return data;
+		}
+	}
+	return nullptr;
+}
+
+static unsigned char *WriteFloats(unsigned char *out, const float *values, int count) {
+	memcpy(out, values, sizeof(float) * count);
+	return out + sizeof(float) * count;
+}
+
+static const unsigned char *ReadFloats(const unsigned char *data, const unsigned char *end, float *values, int count) {
+	if (end - data < (ptrdiff_t)(sizeof(float) * count)) {
+		return nullptr;
+	}
+	memcpy(values, data, sizeof(float) * count);
+	return data + sizeof(float) * count;
+}
+
+// Rounded, so a time decoded from whole microseconds converts back to exactly them and long streams don't drift
+static int64_t ToMicroseconds(double time) {
+	return (int64_t)llround(time * 1000000.0);
+}
+
+void ImInputStateInit(ImInputState *state) {
+	memset(state, 0, sizeof(*state));
+	state->Version = IM_INPUT_STATE_VERSION;
+	state->Size = (uint32_t)sizeof(*state);
+}
+
+int ImInputStateEncodeDelta(const ImInputState *prev, const ImInputState *cur, unsigned char *out) {
+	unsigned char *p = out;
+	// Zigzag encoded, the clock might go backwards when the writer restarts
+	const int64_t dt = ToMicroseconds(cur->Time) - ToMicroseconds(prev->Time);
+	p = WriteVarint(p, ((uint64_t)dt << 1) ^ (uint64_t)(dt >> 63));
+
+	for (int word = 0; word < IM_INPUT_STATE_MAX_KEYS / 32; word++) {
+		const uint32_t changed = prev->KeysDown[word] ^ cur->KeysDown[word];
+		if (changed == 0) {
+			continue;
+		}
+		for (int bit = 0; bit < 32; bit++) {
+			if (((changed >> bit) & 1) == 0) {
+				continue;
+			}
+			const int key_index = word * 32 + bit;
+			*p++ = (cur->KeysDown[word] >> bit) & 1 ? ImInputDeltaOp_KeyDown : ImInputDeltaOp_KeyUp;
+			p = WriteVarint(p, (uint64_t)key_index);
+		}
+	}
+	for (int key_index = 0; key_index < IM_INPUT_STATE_MAX_KEYS; key_index++) {
+		const float value = cur->KeysAnalog[key_index];
+		const bool down_changed = ImInputStateIsKeyDown(prev, key_index) != ImInputStateIsKeyDown(cur, key_index);
+		const float expected = down_changed ? (ImInputStateIsKeyDown(cur, key_index) ? 1.0f : 0.0f)
+											: prev->KeysAnalog[key_index];
+		if (value != expected) {
+			*p++ = ImInputDeltaOp_KeyAnalog;
+			p = WriteVarint(p, (uint64_t)key_index);
+			p = WriteFloats(p, &value, 1);
+		}
+	}
+	if (prev->MouseButtons != cur->MouseButtons) {
+		*p++ = ImInputDeltaOp_MouseButtons;
+		p = WriteVarint(p, cur->MouseButtons);
+	}
+	if (prev->MousePos[0] != cur->MousePos[0] || prev->MousePos[1] != cur->MousePos[1]) {
+		*p++ = ImInputDeltaOp_MousePos;
+		p = WriteFloats(p, cur->MousePos, 2);
+	}
+	if (prev->MouseWheel[0] != cur->MouseWheel[0] || prev->MouseWheel[1] != cur->MouseWheel[1]) {
+		*p++ = ImInputDeltaOp_MouseWheel;
+		p = WriteFloats(p, cur->MouseWheel, 2);
+	}
+	IM_ASSERT(p - out <= IM_INPUT_STATE_MAX_DELTA_SIZE);
+	return (int)(p - out);
+}
+
+bool ImInputStateDecodeDelta(ImInputState *state, const unsigned char *data, int size) {
+	const unsigned char *end = data + size;
+	uint64_t value;
+	if ((data = ReadVarint(data, end, &value)) == nullptr) {
+		return false;
+	}
+	const int64_t dt = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	state->Time = (double)(ToMicroseconds(state->Time) + dt) / 1000000.0;
+
+	while (data < end) {
+		const unsigned char op = *data++;
+		switch (op) {
+		case ImInputDeltaOp_KeyDown:
+		case ImInputDeltaOp_KeyUp:
+		case ImInputDeltaOp_KeyAnalog:
+			if ((data = ReadVarint(data, end, &value)) == nullptr || value >= IM_INPUT_STATE_MAX_KEYS) {
+				return false;
+			}
+			if (op == ImInputDeltaOp_KeyAnalog) {
+				data = ReadFloats(data, end, &state->KeysAnalog[value], 1);
+			} else {
+				ImInputStateSetKeyDown(state, (int)value, op == ImInputDeltaOp_KeyDown);
+				state->KeysAnalog[value] = op == ImInputDeltaOp_KeyDown ? 1.0f : 0.0f;
+			}
+			break;
+		case ImInputDeltaOp_MouseButtons:
+			if ((data = ReadVarint(data, end, &value)) != nullptr) {
+				state->MouseButtons = (uint32_t)value;
+			}
+			break;
+		case ImInputDeltaOp_MousePos:
+			data = ReadFloats(data, end, state->MousePos, 2);
+			break;
+		case ImInputDeltaOp_MouseWheel:
+			data = ReadFloats(data, end, state->MouseWheel, 2);
+			break;
+		default:
+			return false;
+		}
+		if (data == nullptr) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif // IMGUI_DISABLE
@@ -0,0 +1,142 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Snapshot of keyboard, mouse and gamepad state with a fixed binary layout. It doesn't depend on Dear ImGui, so another
+// process (or language) can fill it without linking ImGui - see imgui_input_mirror.h for sharing it between processes.
+// The widgets render from it with ImKeyboard::SetInputState(), ImMouse::SetInputState() and ImGamepad::SetInputState().
+//
+// Layout (native byte order, no padding, 1096 bytes):
+//
+//   offset  size  field
+//        0     4  Version       IM_INPUT_STATE_VERSION
+//        4     4  Size          sizeof(ImInputState)
+//        8     8  Time          Seconds (double), any monotonic clock of the writer
+//       16    32  KeysDown      256 bits, bit i of word i / 32 is the key ImInputKey i
+//       48  1024  KeysAnalog    256 floats in [0, 1], same index as KeysDown (ImGuiKeyData::AnalogValue)
+//     1072     4  MouseButtons  Bit n is ImGuiMouseButton n
+//     1076     8  MousePos      x, y (floats)
+//     1084     8  MouseWheel    Horizontal and vertical wheel delta of the frame (floats)
+//     1092     4  Reserved      Must be 0
+//
+// Key indices are the ImInputKey ids below, which are fixed: they don't follow the ImGuiKey enum of the ImGui version
+// the widgets are built with, new keys are only appended. ImInputStateGetKeyIndex() and ImInputStateGetKey() map them
+// to ImGuiKey. Version is increased whenever the layout changes.
+
+#include <stdint.h>
+
+#define IM_INPUT_STATE_VERSION 1
+#define IM_INPUT_STATE_MAX_KEYS 256
+
+// Stable key ids of KeysDown and KeysAnalog, named like ImGuiKey. The ids are the ImGuiKey order of Dear ImGui 1.91.9
+// minus ImGuiKey_NamedKey_BEGIN, so states written by version 1 widgets read the same.
+typedef enum ImInputKey_ {
+	ImInputKey_Tab = 0, ImInputKey_LeftArrow, ImInputKey_RightArrow, ImInputKey_UpArrow, ImInputKey_DownArrow,
+	ImInputKey_PageUp, ImInputKey_PageDown, ImInputKey_Home, ImInputKey_End, ImInputKey_Insert, ImInputKey_Delete,
+	ImInputKey_Backspace, ImInputKey_Space, ImInputKey_Enter, ImInputKey_Escape, ImInputKey_LeftCtrl,
+	ImInputKey_LeftShift, ImInputKey_LeftAlt, ImInputKey_LeftSuper, ImInputKey_RightCtrl, ImInputKey_RightShift,
+	ImInputKey_RightAlt, ImInputKey_RightSuper, ImInputKey_Menu,
+	ImInputKey_0 = 24, ImInputKey_1, ImInputKey_2, ImInputKey_3, ImInputKey_4, ImInputKey_5, ImInputKey_6,
+	ImInputKey_7, ImInputKey_8, ImInputKey_9,
+	ImInputKey_A = 34, ImInputKey_B, ImInputKey_C, ImInputKey_D, ImInputKey_E, ImInputKey_F, ImInputKey_G,
+	ImInputKey_H, ImInputKey_I, ImInputKey_J, ImInputKey_K, ImInputKey_L, ImInputKey_M, ImInputKey_N, ImInputKey_O,
+	ImInputKey_P, ImInputKey_Q, ImInputKey_R, ImInputKey_S, ImInputKey_T, ImInputKey_U, ImInputKey_V, ImInputKey_W,
+	ImInputKey_X, ImInputKey_Y, ImInputKey_Z,
+	ImInputKey_F1 = 60, ImInputKey_F2, ImInputKey_F3, ImInputKey_F4, ImInputKey_F5, ImInputKey_F6, ImInputKey_F7,
+	ImInputKey_F8, ImInputKey_F9, ImInputKey_F10, ImInputKey_F11, ImInputKey_F12, ImInputKey_F13, ImInputKey_F14,
+	ImInputKey_F15, ImInputKey_F16, ImInputKey_F17, ImInputKey_F18, ImInputKey_F19, ImInputKey_F20, ImInputKey_F21,
+	ImInputKey_F22, ImInputKey_F23, ImInputKey_F24,
+	ImInputKey_Apostrophe = 84, ImInputKey_Comma, ImInputKey_Minus, ImInputKey_Period, ImInputKey_Slash,
+	ImInputKey_Semicolon, ImInputKey_Equal, ImInputKey_LeftBracket, ImInputKey_Backslash, ImInputKey_RightBracket,
+	ImInputKey_GraveAccent, ImInputKey_CapsLock, ImInputKey_ScrollLock, ImInputKey_NumLock, ImInputKey_PrintScreen,
+	ImInputKey_Pause,
+	ImInputKey_Keypad0 = 100, ImInputKey_Keypad1, ImInputKey_Keypad2, ImInputKey_Keypad3, ImInputKey_Keypad4,
+	ImInputKey_Keypad5, ImInputKey_Keypad6, ImInputKey_Keypad7, ImInputKey_Keypad8, ImInputKey_Keypad9,
+	ImInputKey_KeypadDecimal, ImInputKey_KeypadDivide, ImInputKey_KeypadMultiply, ImInputKey_KeypadSubtract,
+	ImInputKey_KeypadAdd, ImInputKey_KeypadEnter, ImInputKey_KeypadEqual,
+	ImInputKey_AppBack = 117, ImInputKey_AppForward, ImInputKey_Oem102,
+	ImInputKey_GamepadStart = 120, ImInputKey_GamepadBack, ImInputKey_GamepadFaceLeft, ImInputKey_GamepadFaceRight,
+	ImInputKey_GamepadFaceUp, ImInputKey_GamepadFaceDown, ImInputKey_GamepadDpadLeft, ImInputKey_GamepadDpadRight,
+	ImInputKey_GamepadDpadUp, ImInputKey_GamepadDpadDown, ImInputKey_GamepadL1, ImInputKey_GamepadR1,
+	ImInputKey_GamepadL2, ImInputKey_GamepadR2, ImInputKey_GamepadL3, ImInputKey_GamepadR3,
+	ImInputKey_GamepadLStickLeft, ImInputKey_GamepadLStickRight, ImInputKey_GamepadLStickUp,
+	ImInputKey_GamepadLStickDown, ImInputKey_GamepadRStickLeft, ImInputKey_GamepadRStickRight,
+	ImInputKey_GamepadRStickUp, ImInputKey_GamepadRStickDown,
+	ImInputKey_MouseLeft = 144, ImInputKey_MouseRight, ImInputKey_MouseMiddle, ImInputKey_MouseX1, ImInputKey_MouseX2,
+	ImInputKey_MouseWheelX, ImInputKey_MouseWheelY,
+	ImInputKey_COUNT
+} ImInputKey_;
+
+typedef struct ImInputState {
+	uint32_t Version;
+	uint32_t Size;
+	double Time;
+	uint32_t KeysDown[IM_INPUT_STATE_MAX_KEYS / 32];
+	float KeysAnalog[IM_INPUT_STATE_MAX_KEYS];
+	uint32_t MouseButtons;
+	float MousePos[2];
+	float MouseWheel[2];
+	uint32_t Reserved;
+} ImInputState;
+
+static inline int ImInputStateIsKeyDown(const ImInputState *state, int key_index) {
+	return (state->KeysDown[key_index >> 5] >> (key_index & 31)) & 1;
+}
+
+static inline void ImInputStateSetKeyDown(ImInputState *state, int key_index, int down) {
+	if (down) {
+		state->KeysDown[key_index >> 5] |= (uint32_t)1 << (key_index & 31);
+	} else {
+		state->KeysDown[key_index >> 5] &= ~((uint32_t)1 << (key_index & 31));
+	}
+}
+
+static inline int ImInputStateIsMouseDown(const ImInputState *state, int button) {
+	return (state->MouseButtons >> button) & 1;
+}
+
+// Upper bound of an encoded delta, see ImInputStateEncodeDelta()
+#define IM_INPUT_STATE_MAX_DELTA_SIZE 3072
+
+#ifdef __cplusplus
+enum ImGuiKey : int;
+// Fill the state from the current ImGui input (implemented in imgui_input_state.cpp, needs ImGui)
+void ImInputStateCapture(ImInputState *state);
+// Key index of a named ImGuiKey, -1 for keys without an ImInputKey id
+int ImInputStateGetKeyIndex(ImGuiKey key);
+// ImGuiKey of a key index, ImGuiKey_None for indices the ImGui version doesn't have
+ImGuiKey ImInputStateGetKey(int key_index);
+// Zero state with Version and Size set, the base for the first delta of a stream
+void ImInputStateInit(ImInputState *state);
+// Compact encoding of the changes from prev to cur: the time difference followed by one op per changed key, mouse
+// button mask, position or wheel. Key ops imply the analog value 0/1, analog values are only sent if they differ from
+// that. Floats are in native byte order. Returns the number of bytes written to out (at least
+// IM_INPUT_STATE_MAX_DELTA_SIZE bytes).
+int ImInputStateEncodeDelta(const ImInputState *prev, const ImInputState *cur, unsigned char *out);
+// Apply an encoded delta of the given size to state. Returns false for malformed data, state is partially updated then.
+bool ImInputStateDecodeDelta(ImInputState *state, const unsigned char *data, int size);
+#endif
@@ -0,0 +1,305 @@
+#include "imgui_input_stream.h"
+
+#ifndef IMGUI_DISABLE
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define IM_INPUT_STREAM_POSIX
+#endif
+
+#ifdef IM_INPUT_STREAM_POSIX
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // Apple: SO_NOSIGPIPE is set on the socket instead
+#endif
+
+static bool SetNonBlocking(int fd) {
+	const int flags = fcntl(fd, F_GETFL, 0);
+	if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+		return false;
+	}
+#ifdef SO_NOSIGPIPE
+	const int on = 1;
+	setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+	return true;
+}
+
+static bool FillAddress(struct sockaddr_un *addr, const char *path) {
+	if (path == nullptr || strlen(path) >= sizeof(addr->sun_path)) {
+		return false;
+	}
+	memset(addr, 0, sizeof(*addr));
+	addr->sun_family = AF_UNIX;
+	strcpy(addr->sun_path, path);
+	return true;
+}
+
+// Sends as much of the queued data as the socket takes, false if the connection is broken
+static bool Flush(ImInputStreamWriter::Client &client) {
+	int sent_total = 0;
+	while (sent_total < client.Pending.Size) {
+		const ssize_t sent =
+			send(client.Fd, client.Pending.Data + sent_total, (size_t)(client.Pending.Size - sent_total), MSG_NOSIGNAL);
+		if (sent < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				break;
+			}
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		sent_total += (int)sent;
+	}
+	if (sent_total > 0) {
+		client.Pending.erase(client.Pending.Data, client.Pending.Data + sent_total);
+	}
+	return true;
+}
+
+#endif // IM_INPUT_STREAM_POSIX
+
+// Encodes a frame (varint payload size + delta) into out
+static void EncodeFrame(const ImInputState &prev, const ImInputState &cur, ImVector<unsigned char> &out) {
+	unsigned char payload[IM_INPUT_STATE_MAX_DELTA_SIZE];
+	const int size = ImInputStateEncodeDelta(&prev, &cur, payload);
+	out.resize(0);
+	for (unsigned int v = (unsigned int)size; ; v >>= 7) {
+		out.push_back((unsigned char)(v >= 0x80 ? (v & 0x7F) | 0x80 : v));
+		if (v < 0x80) {
+			break;
+		}
+	}
+	const int header_size = out.Size;
+	out.resize(header_size + size);
+	memcpy(out.Data + header_size, payload, (size_t)size);
+}
+
+ImInputStreamWriter::ImInputStreamWriter() {
+	ListenFd = -1;
+	Path[0] = '\0';
+	ImInputStateInit(&LastState);
+	MaxPendingBytes = 64 * 1024;
+}
+
+ImInputStreamWriter::~ImInputStreamWriter() {
+	Close();
+}
+
+bool ImInputStreamWriter::Open(const char *path) {
+#ifdef IM_INPUT_STREAM_POSIX
+	Close();
+	struct sockaddr_un addr;
+	if (!FillAddress(&addr, path)) {
+		return false;
+	}
+	ListenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (ListenFd == -1) {
+		return false;
+	}
+	unlink(path);
+	if (!SetNonBlocking(ListenFd) || bind(ListenFd, (const struct sockaddr *)&addr, sizeof(addr)) == -1 ||
+		listen(ListenFd, 8) == -1) {
+		Close();
+		return false;
+	}
+	strcpy(Path, path);
+	return true;
+#else
+	(void)path;
+	return false;
+#endif
+}
+
+void ImInputStreamWriter::Close() {
+#ifdef IM_INPUT_STREAM_POSIX
+	for (int i = 0; i < Clients.Size; i++) {
+		close(Clients[i]->Fd);
+		IM_DELETE(Clients[i]);
+	}
+	Clients.clear();
+	if (ListenFd != -1) {
+		close(ListenFd);
+		ListenFd = -1;
+	}
+	if (Path[0] != '\0') {
+		unlink(Path);
+		Path[0] = '\0';
+	}
+#endif
+}
+
+void ImInputStreamWriter::Publish(const ImInputState &state) {
+#ifdef IM_INPUT_STREAM_POSIX
+	if (ListenFd == -1) {
+		return;
+	}
+
+	// New readers start from the zero state
+	const int old_client_count = Clients.Size;
+	for (;;) {
+		const int fd = accept(ListenFd, nullptr, nullptr);
+		if (fd == -1) {
+			break;
+		}
+		if (!SetNonBlocking(fd)) {
+			close(fd);
+			continue;
+		}
+		Client *client = IM_NEW(Client)();
+		client->Fd = fd;
+		Clients.push_back(client);
+	}
+	if (Clients.Size > old_client_count) {
+		ImInputState zero;
+		ImInputStateInit(&zero);
+		EncodeFrame(zero, state, Frame);
+		for (int i = old_client_count; i < Clients.Size; i++) {
+			Clients[i]->Pending.resize(Frame.Size);
+			memcpy(Clients[i]->Pending.Data, Frame.Data, (size_t)Frame.Size);
+		}
+	}
+
+	// The delta is the same for everybody else, encode it once
+	if (old_client_count > 0) {
+		EncodeFrame(LastState, state, Frame);
+	}
+	for (int i = 0; i < Clients.Size; i++) {
+		Client *client = Clients[i];
+		if (i < old_client_count) {
+			const int offset = client->Pending.Size;
+			client->Pending.resize(offset + Frame.Size);
+			memcpy(client->Pending.Data + offset, Frame.Data, (size_t)Frame.Size);
+		}
+		if (client->Pending.Size > MaxPendingBytes || !Flush(*client)) {
+			close(client->Fd);
+			IM_DELETE(client);
+			Clients.erase(&Clients[i]);
+			i--;
+		}
+	}
+	LastState = state;
+#else
+	(void)state;
+#endif
+}
+
+ImInputStreamReader::ImInputStreamReader() {
+	Fd = -1;
+	ImInputStateInit(&State);
+	HasState = false;
+}
+
+ImInputStreamReader::~ImInputStreamReader() {
+	Close();
+}
+
+bool ImInputStreamReader::Connect(const char *path) {
+#ifdef IM_INPUT_STREAM_POSIX
+	Close();
+	struct sockaddr_un addr;
+	if (!FillAddress(&addr, path)) {
+		return false;
+	}
+	Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Fd == -1) {
+		return false;
+	}
+	// Non-blocking before connecting, a writer that doesn't accept must not stall the caller. A pending connection
+	// reads as no data in Update() and fails there if it's refused.
+	if (!SetNonBlocking(Fd) ||
+		(connect(Fd, (const struct sockaddr *)&addr, sizeof(addr)) == -1 && errno != EINPROGRESS)) {
+		Close();
+		return false;
+	}
+	return true;
+#else
+	(void)path;
+	return false;
+#endif
+}
+
+void ImInputStreamReader::Close() {
+#ifdef IM_INPUT_STREAM_POSIX
+	if (Fd != -1) {
+		close(Fd);
+		Fd = -1;
+	}
+#endif
+	// The writer starts over with a delta against the zero state
+	Received.clear();
+	ImInputStateInit(&State);
+	HasState = false;
+}
+
+bool ImInputStreamReader::Update() {
+#ifdef IM_INPUT_STREAM_POSIX
+	if (Fd == -1) {
+		return false;
+	}
+	for (;;) {
+		unsigned char buf[4096];
+		const ssize_t received = recv(Fd, buf, sizeof(buf), 0);
+		if (received > 0) {
+			const int offset = Received.Size;
+			Received.resize(offset + (int)received);
+			memcpy(Received.Data + offset, buf, (size_t)received);
+			continue;
+		}
+		if (received < 0 && errno == EINTR) {
+			continue;
+		}
+		if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			break;
+		}
+		// Closed by the writer or broken
+		Close();
+		return false;
+	}
+
+	// Apply all complete frames
+	int pos = 0;
+	while (pos < Received.Size) {
+		unsigned int size = 0;
+		int header_size = 0;
+		bool complete = false;
+		for (int shift = 0; shift < 32 && pos + header_size < Received.Size; shift += 7) {
+			const unsigned char byte = Received[pos + header_size++];
+			size |= (unsigned int)(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				complete = true;
+				break;
+			}
+		}
+		if (!complete || size > IM_INPUT_STATE_MAX_DELTA_SIZE) {
+			if (header_size >= 5 || size > IM_INPUT_STATE_MAX_DELTA_SIZE) {
+				Close();
+				return false;
+			}
+			break; // Header not fully received yet
+		}
+		if (Received.Size - pos - header_size < (int)size) {
+			break;
+		}
+		if (!ImInputStateDecodeDelta(&State, Received.Data + pos + header_size, (int)size)) {
+			Close();
+			return false;
+		}
+		HasState = true;
+		pos += header_size + (int)size;
+	}
+	if (pos > 0) {
+		Received.erase(Received.Data, Received.Data + pos);
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+#endif // IMGUI_DISABLE
@@ -0,0 +1,99 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Stream input state changes to other local processes (e.g. a broadcast overlay) over a UNIX domain socket.
+//
+// The writer sends one frame per Publish() call: a varint payload size followed by an ImInputStateEncodeDelta()
+// payload. New readers first get a delta against the zero state (ImInputStateInit()), all following frames are deltas
+// against the previous one. Sockets are non-blocking: frames are queued per reader and a reader that falls more than
+// MaxPendingBytes behind is disconnected instead of stalling the writer.
+//
+// Usage:
+//
+//   // Game process, once per frame
+//   ImInputStreamWriter writer;
+//   writer.Open("/tmp/mygame_input.sock");
+//   ImInputState state;
+//   ImInputStateCapture(&state);
+//   writer.Publish(state);
+//
+//   // Overlay process, once per frame
+//   ImInputStreamReader reader;
+//   reader.Connect("/tmp/mygame_input.sock");
+//   reader.Update();
+//   ImKeyboard::SetInputState(reader.GetState());
+
+#include "imgui.h"
+#include "imgui_input_state.h"
+
+struct ImInputStreamWriter {
+	struct Client {
+		int Fd;
+		ImVector<unsigned char> Pending; // Queued bytes the socket didn't accept yet
+	};
+
+	int ListenFd;
+	char Path[108]; // sockaddr_un::sun_path
+	ImVector<Client *> Clients;
+	ImInputState LastState;
+	ImVector<unsigned char> Frame; // Scratch buffer for the encoded frame
+	int MaxPendingBytes;		   // Readers with more queued bytes are dropped (default: 64 KiB)
+
+	ImInputStreamWriter();
+	~ImInputStreamWriter();
+	// Creates the socket file, replacing a stale one
+	bool Open(const char *path);
+	void Close();
+	// Accepts new readers and sends the changes since the last call to all of them, never blocks
+	void Publish(const ImInputState &state);
+	int GetClientCount() const {
+		return Clients.Size;
+	}
+};
+
+struct ImInputStreamReader {
+	int Fd;
+	ImVector<unsigned char> Received; // Bytes of an incomplete frame
+	ImInputState State;
+	bool HasState;
+
+	ImInputStreamReader();
+	~ImInputStreamReader();
+	bool Connect(const char *path);
+	void Close();
+	bool IsConnected() const {
+		return Fd != -1;
+	}
+	// Applies all frames received since the last call, never blocks. Returns false once the connection is gone (or
+	// the data was malformed), call Connect() again to reconnect.
+	bool Update();
+	// The received state for SetInputState(), nullptr until the first frame arrived
+	const ImInputState *GetState() const {
+		return HasState ? &State : nullptr;
+	}
+};
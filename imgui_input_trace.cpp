@@ -0,0 +1,75 @@
+#include "imgui_input_trace.h"
+#include "imgui_internal.h"
+
+#if !defined(IMGUI_DISABLE) && defined(IM_INPUT_TRACE_BUILTIN)
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+
+namespace ImInputTrace {
+
+IM_STATIC_ASSERT((IM_INPUT_TRACE_CAPACITY & (IM_INPUT_TRACE_CAPACITY - 1)) == 0);
+
+struct Zone {
+	const char *Name;
+	ImU64 Begin; // Nanoseconds
+	ImU64 Duration;
+	unsigned int Thread;
+};
+
+static Zone Zones[IM_INPUT_TRACE_CAPACITY];
+static std::atomic<unsigned int> ZoneHead(0);
+static std::atomic<unsigned int> ThreadCounter(0);
+
+static ImU64 Now() {
+	return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+// Small sequential ids read better in the trace viewers than native thread ids
+static unsigned int GetThreadId() {
+	static thread_local unsigned int id = ThreadCounter.fetch_add(1) + 1;
+	return id;
+}
+
+Scope::Scope(const char *name) {
+	Name = name;
+	Begin = Now();
+}
+
+Scope::~Scope() {
+	const ImU64 end = Now();
+	Zone &zone = Zones[ZoneHead.fetch_add(1, std::memory_order_relaxed) & (IM_INPUT_TRACE_CAPACITY - 1)];
+	zone.Name = Name;
+	zone.Begin = Begin;
+	zone.Duration = end - Begin;
+	zone.Thread = GetThreadId();
+}
+
+void Clear() {
+	ZoneHead.store(0);
+}
+
+bool DumpChromeJson(const char *filename) {
+	FILE *file = fopen(filename, "w");
+	if (file == nullptr) {
+		return false;
+	}
+	const unsigned int head = ZoneHead.load();
+	const unsigned int count = head < IM_INPUT_TRACE_CAPACITY ? head : IM_INPUT_TRACE_CAPACITY;
+	fputs("{\"traceEvents\":[\n", file);
+	for (unsigned int i = 0; i < count; i++) {
+		const Zone &zone = Zones[(head - count + i) & (IM_INPUT_TRACE_CAPACITY - 1)];
+		// Chrome trace timestamps are in microseconds
+		fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}\n",
+				i == 0 ? "" : ",", zone.Name, (double)zone.Begin / 1000.0, (double)zone.Duration / 1000.0, zone.Thread);
+	}
+	fputs("]}\n", file);
+	return fclose(file) == 0;
+}
+
+} // namespace ImInputTrace
+
+#endif // !IMGUI_DISABLE && IM_INPUT_TRACE_BUILTIN
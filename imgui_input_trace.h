@@ -0,0 +1,72 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Trace zones around the phases of Keyboard(), Mouse() and Gamepad(). They compile to nothing unless a tracer is
+// plugged in, either by defining IM_INPUT_TRACE_SCOPE(name) - name is a string literal - e.g. in imconfig.h:
+//
+//   #include "tracy/Tracy.hpp"
+//   #define IM_INPUT_TRACE_SCOPE(name) ZoneScopedN(name)
+//
+// or by defining IM_INPUT_TRACE_BUILTIN to use the built-in ring buffer tracer below, which writes Chrome trace JSON
+// (chrome://tracing or https://ui.perfetto.dev).
+
+#include "imgui.h"
+
+#ifndef IM_INPUT_TRACE_SCOPE
+#ifdef IM_INPUT_TRACE_BUILTIN
+#define IM_INPUT_TRACE_CONCAT_(a, b) a##b
+#define IM_INPUT_TRACE_CONCAT(a, b) IM_INPUT_TRACE_CONCAT_(a, b)
+#define IM_INPUT_TRACE_SCOPE(name) ImInputTrace::Scope IM_INPUT_TRACE_CONCAT(im_input_trace_scope_, __LINE__)(name)
+#else
+#define IM_INPUT_TRACE_SCOPE(name)
+#endif
+#endif
+
+#ifdef IM_INPUT_TRACE_BUILTIN
+
+#ifndef IM_INPUT_TRACE_CAPACITY
+#define IM_INPUT_TRACE_CAPACITY 65536 // Number of zones kept, must be a power of two
+#endif
+
+namespace ImInputTrace {
+
+struct Scope {
+	const char *Name;
+	ImU64 Begin;
+
+	Scope(const char *name);
+	~Scope();
+};
+
+void Clear();
+// Writes the last IM_INPUT_TRACE_CAPACITY zones, don't call it while zones are recorded on other threads
+bool DumpChromeJson(const char *filename);
+
+} // namespace ImInputTrace
+
+#endif // IM_INPUT_TRACE_BUILTIN
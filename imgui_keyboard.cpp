@@ -1,5 +1,22 @@
 #include "imgui_keyboard.h"
+#include "imgui_input_trace.h"
 #include "imgui_internal.h"
+#include "imgui_keyboard_internal.h"
+
+#if !defined(IMKEYBOARD_DISABLE_LATENCY) || !defined(IMKEYBOARD_DISABLE_TIMING)
+#include <chrono>
+#endif
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(IMGUI_DISABLE_SSE)
+#define IMKEYBOARD_ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX__) && defined(IMKEYBOARD_ENABLE_SSE2)
+#define IMKEYBOARD_ENABLE_AVX
+#include <immintrin.h>
+#endif
+#ifdef IMKEYBOARD_HAS_KEY_HIT_TEST
+#include <math.h> // nextafterf
+#endif
 
 namespace ImKeyboard {
 
@@ -16,6 +33,8 @@ ImGuiKeyboardStyle::ImGuiKeyboardStyle() {
 	KeyLabelOffset = ImVec2(6.0f, 4.0f);
 	BoardPadding = 5.0f;
 	BoardRounding = 5.0f;
+	PressLatchTime = 0.1f;
+	PressFadeTime = 0.15f;
 
 	Colors[ImGuiKeyboardCol_BoardBackground] = ImVec4(0.2f, 0.2f, 0.2f, 0.0f);		 // Dark gray
 	Colors[ImGuiKeyboardCol_KeyBackground] = ImVec4(0.8f, 0.8f, 0.8f, 1.0f);		 // Light gray
@@ -37,12 +56,186 @@ struct KeyLayoutData {
 	ImGuiKey Key;
 };
 
+// Key of a composed row, the position follows from the widths of the keys before it
+struct KeyDef {
+	float Width;
+	const char *Label;
+	const char *ShiftLabel;
+	ImGuiKey Key;
+};
+
+// Compact form of ImGuiKeyboardKeyEdit for the built-in tables
+struct KeyEdit {
+	ImS8 Row; // ImGuiKeyboardRow_
+	ImS8 Op;  // ImGuiKeyboardEditOp_
+	ImS8 Index;
+	KeyDef Key;
+};
+
+// Flat rows of a layout, expanded on first use
+struct KeyboardLayoutRows {
+	ImVector<KeyLayoutData> Rows[ImGuiKeyboardRow_COUNT];
+	bool ISO; // Enter is the L-shaped ISO key, rendered separately
+	bool Expanded;
+
+	KeyboardLayoutRows() {
+		ISO = false;
+		Expanded = false;
+	}
+};
+
+// Entry of the reverse index from characters to keys, sorted by code point
+struct KeyChar {
+	unsigned int Codepoint;
+	ImGuiKey Key;
+	bool Shift;
+	int Order; // Position in the layout, the first key wins when several type the same character
+};
+
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+#define IMKEYBOARD_LATENCY_PROBES 64   // Probes in flight between Keyboard() and the renderer
+#define IMKEYBOARD_LATENCY_SAMPLES 128 // Rolling window per key
+
+// Press of a key that was drawn, waiting for its draw callback
+struct LatencyProbe {
+	ImGuiKey Key; // ImGuiKey_None once processed
+	ImU64 PressTime;
+};
+
+struct LatencyTrack {
+	ImGuiKey Key;
+	int Count;
+	int Head;
+	float Samples[IMKEYBOARD_LATENCY_SAMPLES]; // Milliseconds
+};
+#endif
+
+#ifndef IMKEYBOARD_DISABLE_TIMING
+#define IMKEYBOARD_TIMING_BUCKETS 96 // Quarter-octave buckets of microseconds, the last one takes everything from ~33 s
+
+// Presses of a key sent through AddKeyEvent(), see EnableKeyTiming()
+struct KeyTiming {
+	ImU64 PressTime; // Nanoseconds, of the last press
+	bool Down;
+	int PressCount;
+	int ChatterCount;
+	ImU32 HoldBuckets[IMKEYBOARD_TIMING_BUCKETS];
+	ImU32 IntervalBuckets[IMKEYBOARD_TIMING_BUCKETS];
+};
+#endif
+
+struct HighlightLayer {
+	char Name[32];
+	ImVec4 Color;
+	int Priority;
+	bool Used;
+	bool Active;
+};
+
+#ifdef IMKEYBOARD_HAS_KEY_HIT_TEST
+// Key rects of a board for hit tests, one array per side so they are tested several keys at a time. Rects are in
+// pixels relative to the top left corner of the board, the rest is what they were built for.
+struct BoardKeyRects {
+	ImVector<float> MinX, MinY, MaxX, MaxY; // Padded to a multiple of 8 with rects nothing is inside of
+	ImVector<ImGuiKey> Keys;
+	ImVector<ImU32> HitMask; // Bit per rect, result of the last hit test
+	bool NoNumpad;
+	float Scale;
+	int LayoutEditCount;
+	float KeyUnit, SectionGap, BoardPadding, KeyBorderSize;
+};
+#endif
+
+// Bits of KeyboardContext::KeyHighlights
+enum KeyHighlight_ {
+	KeyHighlight_Key = 1 << 0,	// Highlight()
+	KeyHighlight_Text = 1 << 1, // HighlightText(), resolved on TextKeysLayout
+};
+
 struct KeyboardContext {
-	ImVector<ImGuiKey> HighlightedKeys;
+	ImU8 KeyHighlights[ImGuiKey_NamedKey_COUNT]; // KeyHighlight_ bits of each key
+	HighlightLayer HighlightLayers[IMKEYBOARD_HIGHLIGHT_LAYERS];
+	// Key masks are ordered by priority so the top layer of a key is its highest set bit. Ids given out by
+	// AddHighlightLayer() stay stable, LayerBits and BitLayers map between both.
+	ImU16 KeyLayerBits[ImGuiKey_NamedKey_COUNT];
+	ImU8 LayerBits[IMKEYBOARD_HIGHLIGHT_LAYERS];
+	ImU8 BitLayers[IMKEYBOARD_HIGHLIGHT_LAYERS];
+	ImU16 ActiveLayerBits;
 	ImVector<ImGuiKey> RecordedKeys;
+	const ImInputState *InputState; // nullptr for the ImGui input
 	ImGuiKeyboardStyle Style;
+	KeyboardLayoutRows Layouts[ImGuiKeyboardLayout_Count];
+	ImVector<KeyEdit> LayoutEdits[ImGuiKeyboardLayout_Count]; // Set by SetLayoutEdits()
+	ImVector<KeyChar> CharIndex[ImGuiKeyboardLayout_Count]; // Built on first use
+	ImVector<ImWchar32> HighlightedText;					  // Code points set by HighlightText()
+	ImVector<ImGuiKey> TextKeys;							  // HighlightedText resolved on TextKeysLayout
+	ImGuiKeyboardLayout TextKeysLayout;						  // -1 when TextKeys needs to be resolved
+	const ImU32 *KeyColors; // Caller-owned, set by SetKeyColors()
+	int KeyColorCount;
+	ImU32 KeyFaceColors[ImGuiKey_NamedKey_COUNT]; // KeyColors blended over the face color, per Keyboard() call
+#ifndef IMKEYBOARD_DISABLE_KEY_OWNERS
+	ImU32 KeyOwnerColors[ImGuiKey_NamedKey_COUNT]; // For ImGuiKeyboardFlags_ShowKeyOwners, replaces KeyColors
+#endif
+	const ImU16 *KeyCounts; // Caller-owned, set by SetKeyCounts()
+	int KeyCountCount;
+	int LayoutEditCount;   // Bumped by SetLayoutEdits(), layouts can change without changing their id
+	ImGuiID StateHash;	   // What the boards of StateHashFrame drew, see GetStateHash()
+	ImGuiID PrevStateHash; // Same for the previous frame that drew boards
+	int StateHashFrame;
+#ifdef IMKEYBOARD_HAS_KEY_HIT_TEST
+	BoardKeyRects KeyRects[ImGuiKeyboardLayout_Count]; // Built on first use, see GetBoardKeyRects()
+#endif
+	// ImGui time a key was last seen down, for ImGuiKeyboardFlags_LatchPresses
+	double KeyDownTimes[ImGuiKey_NamedKey_COUNT];
+	ImU8 KeyPressAlphas[ImGuiKey_NamedKey_COUNT]; // 255 while down or latched, then fading to 0
+	int PressLatchFrame;
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+	ImU64 PressTimes[ImGuiKey_NamedKey_COUNT]; // AddKeyEvent() time of presses that weren't drawn yet, 0 if none
+	bool KeyEventDown[ImGuiKey_NamedKey_COUNT]; // Last state passed to AddKeyEvent(), to skip key repeats
+	LatencyProbe Probes[IMKEYBOARD_LATENCY_PROBES];
+	int ProbeHead;
+	ImVector<LatencyTrack> LatencyTracks;
+	ImVector<float> LatencyScratch; // Sorted samples for GetKeyLatency()
+#endif
+#ifndef IMKEYBOARD_DISABLE_TIMING
+	ImVector<KeyTiming> KeyTimings; // By named key index while the analyzer is enabled, empty otherwise
+	ImU64 ChatterWindow;			// Nanoseconds
+	ImU32 KeyChatterColors[ImGuiKey_NamedKey_COUNT]; // For ImGuiKeyboardFlags_ShowKeyTiming, replaces KeyColors
+#endif
 
 	KeyboardContext() {
+		memset(KeyHighlights, 0, sizeof(KeyHighlights));
+		memset(KeyLayerBits, 0, sizeof(KeyLayerBits));
+		for (int i = 0; i < IMKEYBOARD_HIGHLIGHT_LAYERS; i++) {
+			HighlightLayers[i].Name[0] = '\0';
+			HighlightLayers[i].Priority = 0;
+			HighlightLayers[i].Used = HighlightLayers[i].Active = false;
+			LayerBits[i] = BitLayers[i] = (ImU8)i;
+		}
+		ActiveLayerBits = 0;
+		InputState = nullptr;
+		TextKeysLayout = -1;
+		KeyColors = nullptr;
+		KeyColorCount = 0;
+		KeyCounts = nullptr;
+		KeyCountCount = 0;
+		LayoutEditCount = 0;
+		StateHash = PrevStateHash = 0;
+		StateHashFrame = -1;
+		for (int i = 0; i < ImGuiKey_NamedKey_COUNT; i++) {
+			KeyDownTimes[i] = -FLT_MAX;
+		}
+		memset(KeyPressAlphas, 0, sizeof(KeyPressAlphas));
+		PressLatchFrame = -1;
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+		memset(PressTimes, 0, sizeof(PressTimes));
+		memset(KeyEventDown, 0, sizeof(KeyEventDown));
+		memset(Probes, 0, sizeof(Probes));
+		ProbeHead = 0;
+#endif
+#ifndef IMKEYBOARD_DISABLE_TIMING
+		ChatterWindow = 0;
+#endif
 	}
 };
 
@@ -55,20 +248,188 @@ ImGuiKeyboardStyle &GetStyle() {
 	return GetContext()->Style;
 }
 
+// Everything the render functions read. Keyboard() points it at the context and the current ImGui font,
+// BuildGeometry() at the snapshot of an ImGuiKeyboardGeometry, so boards can be built on worker threads.
+struct DrawSource {
+	const ImGuiKeyboardStyle *Style;
+	const ImInputState *InputState; // nullptr for the ImGui input
+	const ImU8 *KeyHighlights; // By named key index, non-zero for Highlight() and HighlightText() keys
+	const ImVector<ImGuiKey> *RecordedKeys;
+	const ImU16 *KeyLayerBits;
+	ImU16 ActiveLayerBits;
+	const ImU32 *LayerColors; // By bit
+	const ImU32 *KeyFaceColors; // By named key index, nullptr without SetKeyColors()
+	int KeyFaceColorCount;
+	const ImU16 *KeyCounts; // By named key index, nullptr without SetKeyCounts()
+	int KeyCountCount;
+	const ImU8 *KeyPressAlphas; // By named key index, nullptr without ImGuiKeyboardFlags_LatchPresses
+	ImFont *Font;
+	float FontSize;
+	float FontAscent; // Baseline offset at FontSize for SVG text, 0.0f when drawing into a window
+};
+
+static thread_local const DrawSource *CurrentDrawSource = nullptr;
+
+static const DrawSource *GetDrawSource() {
+	IM_ASSERT(CurrentDrawSource != nullptr && "Only valid while rendering a board");
+	return CurrentDrawSource;
+}
+
 static ImU32 GetColorU32(ImGuiKeyboardCol idx) {
-	return ImGui::ColorConvertFloat4ToU32(GetContext()->Style.Colors[idx]);
+	return ImGui::ColorConvertFloat4ToU32(GetDrawSource()->Style->Colors[idx]);
 }
 
-static bool IsKeyHighlighted(ImGuiKey key) {
-	KeyboardContext *ctx = GetContext();
-	for (int i = 0; i < ctx->HighlightedKeys.Size; i++) {
-		if (ctx->HighlightedKeys[i] == key) {
+static void AddKeyText(ImDrawList *draw_list, const ImVec2 &pos, const char *text) {
+	const DrawSource *src = GetDrawSource();
+	draw_list->AddText(src->Font, src->FontSize, pos, GetColorU32(ImGuiKeyboardCol_KeyLabel), text);
+}
+
+static ImVec2 CalcKeyTextSize(const char *text) {
+	const DrawSource *src = GetDrawSource();
+	return src->Font->CalcTextSizeA(src->FontSize, FLT_MAX, 0.0f, text);
+}
+
+void SetInputState(const ImInputState *state) {
+	GetContext()->InputState = state;
+}
+
+static bool IsKeyDown(ImGuiKey key) {
+	const ImInputState *state = GetDrawSource()->InputState;
+	if (state == nullptr) {
+		return ImGui::IsKeyDown(key);
+	}
+	const int key_index = ImInputStateGetKeyIndex(key);
+	return key_index != -1 && ImInputStateIsKeyDown(state, key_index);
+}
+
+// Opacity of the pressed overlay of a key: 255 while down, or with latching while the press is held or fading
+static int GetKeyPressAlpha(ImGuiKey key) {
+	const ImU8 *alphas = GetDrawSource()->KeyPressAlphas;
+	if (alphas != nullptr && ImGui::IsNamedKey(key)) {
+		return alphas[key - ImGuiKey_NamedKey_BEGIN];
+	}
+	return IsKeyDown(key) ? 255 : 0;
+}
+
+static ImU32 ScaleAlpha(ImU32 color, int alpha) {
+	const ImU32 a = ((color >> IM_COL32_A_SHIFT) & 0xFF) * (ImU32)alpha / 255;
+	return (color & ~IM_COL32_A_MASK) | (a << IM_COL32_A_SHIFT);
+}
+
+static bool ContainsKey(const ImVector<ImGuiKey> &keys, ImGuiKey key) {
+	for (int i = 0; i < keys.Size; i++) {
+		if (keys[i] == key) {
 			return true;
 		}
 	}
 	return false;
 }
 
+static bool IsKeyShownHighlighted(ImGuiKey key) {
+	return GetDrawSource()->KeyHighlights[key - ImGuiKey_NamedKey_BEGIN] != 0;
+}
+
+// Color of the top highlight layer of a key, 0 if it's in none
+static ImU32 GetKeyLayerColor(ImGuiKey key) {
+	if (!ImGui::IsNamedKey(key)) {
+		return 0;
+	}
+	const DrawSource *src = GetDrawSource();
+	const ImU16 bits = src->KeyLayerBits[key - ImGuiKey_NamedKey_BEGIN] & src->ActiveLayerBits;
+	return bits != 0 ? src->LayerColors[FindHighestBit(bits)] : 0;
+}
+
+void SetKeyColors(const ImU32 *colors_by_key, int count) {
+	IM_ASSERT((colors_by_key != nullptr || count == 0) && count >= 0);
+	KeyboardContext *ctx = GetContext();
+	ctx->KeyColors = colors_by_key;
+	ctx->KeyColorCount = ImMin(count, (int)ImGuiKey_NamedKey_COUNT);
+}
+
+// Blend each color over base by its alpha, keeping the alpha of base. A zero color leaves base as is.
+static ImU32 BlendKeyColor(ImU32 base, ImU32 color) {
+	const ImU32 a = color >> IM_COL32_A_SHIFT;
+	ImU32 out = base & IM_COL32_A_MASK;
+	for (int shift = 0; shift < 32; shift += 8) {
+		if (shift == IM_COL32_A_SHIFT) {
+			continue;
+		}
+		const ImU32 x = ((base >> shift) & 0xFF) * (255 - a) + ((color >> shift) & 0xFF) * a + 128;
+		out |= ((x + (x >> 8)) >> 8) << shift; // x / 255, rounded
+	}
+	return out;
+}
+
+static void BlendKeyColors(ImU32 *out_colors, const ImU32 *colors, int count, ImU32 base) {
+	int i = 0;
+#ifdef IMKEYBOARD_ENABLE_SSE2
+	// 4 colors per step, the channels widened to 16 bits
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i base_alpha = _mm_set1_epi32((int)(base & IM_COL32_A_MASK));
+	const __m128i color_mask = _mm_set1_epi32((int)~IM_COL32_A_MASK);
+	const __m128i ff = _mm_set1_epi16(255);
+	const __m128i half = _mm_set1_epi16(128);
+	const __m128i base16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)base), zero);
+	for (; i + 4 <= count; i += 4) {
+		const __m128i c = _mm_loadu_si128((const __m128i *)(colors + i));
+		__m128i a = _mm_srli_epi32(c, IM_COL32_A_SHIFT);
+		a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+		a = _mm_or_si128(a, _mm_slli_epi32(a, 16)); // Alpha in every byte
+		const __m128i c_lo = _mm_unpacklo_epi8(c, zero), c_hi = _mm_unpackhi_epi8(c, zero);
+		const __m128i a_lo = _mm_unpacklo_epi8(a, zero), a_hi = _mm_unpackhi_epi8(a, zero);
+		__m128i x_lo = _mm_add_epi16(_mm_mullo_epi16(base16, _mm_sub_epi16(ff, a_lo)), _mm_mullo_epi16(c_lo, a_lo));
+		__m128i x_hi = _mm_add_epi16(_mm_mullo_epi16(base16, _mm_sub_epi16(ff, a_hi)), _mm_mullo_epi16(c_hi, a_hi));
+		x_lo = _mm_add_epi16(x_lo, half);
+		x_hi = _mm_add_epi16(x_hi, half);
+		x_lo = _mm_srli_epi16(_mm_add_epi16(x_lo, _mm_srli_epi16(x_lo, 8)), 8);
+		x_hi = _mm_srli_epi16(_mm_add_epi16(x_hi, _mm_srli_epi16(x_hi, 8)), 8);
+		const __m128i blended = _mm_packus_epi16(x_lo, x_hi);
+		_mm_storeu_si128((__m128i *)(out_colors + i), _mm_or_si128(_mm_and_si128(blended, color_mask), base_alpha));
+	}
+#endif
+	for (; i < count; i++) {
+		out_colors[i] = BlendKeyColor(base, colors[i]);
+	}
+}
+
+void SetKeyCounts(const ImU16 *counts_by_key, int count) {
+	IM_ASSERT((counts_by_key != nullptr || count == 0) && count >= 0);
+	KeyboardContext *ctx = GetContext();
+	ctx->KeyCounts = counts_by_key;
+	ctx->KeyCountCount = ImMin(count, (int)ImGuiKey_NamedKey_COUNT);
+}
+
+// Number in the bottom right corner of the key face, for SetKeyCounts()
+static void RenderKeyCount(ImDrawList *draw_list, const ImVec2 &face_max, ImGuiKey key) {
+	const DrawSource *src = GetDrawSource();
+	const int index = key - ImGuiKey_NamedKey_BEGIN;
+	if (src->KeyCounts == nullptr || index < 0 || index >= src->KeyCountCount || src->KeyCounts[index] == 0) {
+		return;
+	}
+	char buf[8];
+	ImFormatString(buf, IM_ARRAYSIZE(buf), "%d", (int)src->KeyCounts[index]);
+	const float font_size = src->FontSize * 0.75f;
+	const ImVec2 size = src->Font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, buf);
+	draw_list->AddText(src->Font, font_size, ImVec2(face_max.x - size.x - 1.0f, face_max.y - size.y),
+					   GetColorU32(ImGuiKeyboardCol_KeyLabel), buf);
+}
+
+static ImU32 GetKeyFaceColor(ImGuiKey key) {
+	const DrawSource *src = GetDrawSource();
+	const int index = key - ImGuiKey_NamedKey_BEGIN;
+	if (src->KeyFaceColors != nullptr && index >= 0 && index < src->KeyFaceColorCount) {
+		return src->KeyFaceColors[index];
+	}
+	return GetColorU32(ImGuiKeyboardCol_KeyFace);
+}
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+static bool IsKeyShownRecorded(ImGuiKey key) {
+	return ContainsKey(*GetDrawSource()->RecordedKeys, key);
+}
+#endif
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
 static bool IsKeyRecorded(ImGuiKey key) {
 	KeyboardContext *ctx = GetContext();
 	for (int i = 0; i < ctx->RecordedKeys.Size; i++) {
@@ -78,6 +439,7 @@ static bool IsKeyRecorded(ImGuiKey key) {
 	}
 	return false;
 }
+#endif
 
 // Numeric keypad layout
 static const KeyLayoutData numpad_keys[] = {
@@ -125,20 +487,6 @@ static const KeyLayoutData function_row_keys[] = {
 	{14.0f, 0.0f, 1.0f, 1.0f, "F12", nullptr, ImGuiKey_F12},
 };
 
-// Print, Scroll, Pause - rendered separately to align with nav cluster using section_gap
-static const KeyLayoutData function_row_nav_keys[] = {
-	{0.0f, 0.0f, 1.0f, 1.0f, "Prt", nullptr, ImGuiKey_PrintScreen},
-	{1.0f, 0.0f, 1.0f, 1.0f, "Scr", nullptr, ImGuiKey_ScrollLock},
-	{2.0f, 0.0f, 1.0f, 1.0f, "Pse", nullptr, ImGuiKey_Pause},
-};
-
-// Apple layout: F13, F14, F15 instead of Print Screen, Scroll Lock, Pause
-static const KeyLayoutData apple_function_row_nav_keys[] = {
-	{0.0f, 0.0f, 1.0f, 1.0f, "F13", nullptr, ImGuiKey_PrintScreen},
-	{1.0f, 0.0f, 1.0f, 1.0f, "F14", nullptr, ImGuiKey_ScrollLock},
-	{2.0f, 0.0f, 1.0f, 1.0f, "F15", nullptr, ImGuiKey_Pause},
-};
-
 // Navigation cluster (Insert, Delete, Home, End, PageUp, PageDown, Arrows)
 static const KeyLayoutData nav_cluster_keys[] = {
 	// Row 0 - Insert, Home, PageUp
@@ -157,596 +505,469 @@ static const KeyLayoutData nav_cluster_keys[] = {
 	{2.0f, 4.0f, 1.0f, 1.0f, ">", nullptr, ImGuiKey_RightArrow},
 };
 
-// Main keyboard - Number row (US layout shift symbols)
-static const KeyLayoutData number_row_keys[] = {
-	{0.0f, 0.0f, 1.0f, 1.0f, "`", "~", ImGuiKey_GraveAccent},
-	{1.0f, 0.0f, 1.0f, 1.0f, "1", "!", ImGuiKey_1},
-	{2.0f, 0.0f, 1.0f, 1.0f, "2", "@", ImGuiKey_2},
-	{3.0f, 0.0f, 1.0f, 1.0f, "3", "#", ImGuiKey_3},
-	{4.0f, 0.0f, 1.0f, 1.0f, "4", "$", ImGuiKey_4},
-	{5.0f, 0.0f, 1.0f, 1.0f, "5", "%", ImGuiKey_5},
-	{6.0f, 0.0f, 1.0f, 1.0f, "6", "^", ImGuiKey_6},
-	{7.0f, 0.0f, 1.0f, 1.0f, "7", "&", ImGuiKey_7},
-	{8.0f, 0.0f, 1.0f, 1.0f, "8", "*", ImGuiKey_8},
-	{9.0f, 0.0f, 1.0f, 1.0f, "9", "(", ImGuiKey_9},
-	{10.0f, 0.0f, 1.0f, 1.0f, "0", ")", ImGuiKey_0},
-	{11.0f, 0.0f, 1.0f, 1.0f, "-", "_", ImGuiKey_Minus},
-	{12.0f, 0.0f, 1.0f, 1.0f, "=", "+", ImGuiKey_Equal},
-	{13.0f, 0.0f, 2.0f, 1.0f, "Back", nullptr, ImGuiKey_Backspace},
-};
+// Rows that differ between layouts are composed at runtime: every layout starts from the ANSI QWERTY rows below, then
+// applies its language/vendor edits, then for ISO variants the generic ISO edits and the language specific ISO edits.
+// Keys of a composed row are laid out left to right without gaps.
 
-// German number row (QWERTZ layout shift symbols)
-static const KeyLayoutData number_row_qwertz_keys[] = {
-	{0.0f, 0.0f, 1.0f, 1.0f, "^", nullptr, ImGuiKey_GraveAccent},
-	{1.0f, 0.0f, 1.0f, 1.0f, "1", "!", ImGuiKey_1},
-	{2.0f, 0.0f, 1.0f, 1.0f, "2", "\"", ImGuiKey_2},
-	{3.0f, 0.0f, 1.0f, 1.0f, "3", "\xc2\xa7", ImGuiKey_3},
-	{4.0f, 0.0f, 1.0f, 1.0f, "4", "$", ImGuiKey_4},
-	{5.0f, 0.0f, 1.0f, 1.0f, "5", "%", ImGuiKey_5},
-	{6.0f, 0.0f, 1.0f, 1.0f, "6", "&", ImGuiKey_6},
-	{7.0f, 0.0f, 1.0f, 1.0f, "7", "/", ImGuiKey_7},
-	{8.0f, 0.0f, 1.0f, 1.0f, "8", "(", ImGuiKey_8},
-	{9.0f, 0.0f, 1.0f, 1.0f, "9", ")", ImGuiKey_9},
-	{10.0f, 0.0f, 1.0f, 1.0f, "0", "=", ImGuiKey_0},
-	{11.0f, 0.0f, 1.0f, 1.0f, "\xc3\x9f", "?", ImGuiKey_Minus},
-	{12.0f, 0.0f, 1.0f, 1.0f, "'", "`", ImGuiKey_Equal},
-	{13.0f, 0.0f, 2.0f, 1.0f, "Back", nullptr, ImGuiKey_Backspace},
+// Print, Scroll, Pause - rendered separately to align with nav cluster using section_gap
+static const KeyDef function_row_nav_keys[] = {
+	{1.0f, "Prt", nullptr, ImGuiKey_PrintScreen},
+	{1.0f, "Scr", nullptr, ImGuiKey_ScrollLock},
+	{1.0f, "Pse", nullptr, ImGuiKey_Pause},
 };
 
-// French number row (AZERTY layout - numbers require shift)
-static const KeyLayoutData number_row_azerty_keys[] = {
-	{0.0f, 0.0f, 1.0f, 1.0f, "2", nullptr, ImGuiKey_GraveAccent},
-	{1.0f, 0.0f, 1.0f, 1.0f, "&", "1", ImGuiKey_1},
-	{2.0f, 0.0f, 1.0f, 1.0f, "\xc3\xa9", "2", ImGuiKey_2},
-	{3.0f, 0.0f, 1.0f, 1.0f, "\"", "3", ImGuiKey_3},
-	{4.0f, 0.0f, 1.0f, 1.0f, "'", "4", ImGuiKey_4},
-	{5.0f, 0.0f, 1.0f, 1.0f, "(", "5", ImGuiKey_5},
-	{6.0f, 0.0f, 1.0f, 1.0f, "-", "6", ImGuiKey_6},
-	{7.0f, 0.0f, 1.0f, 1.0f, "\xc3\xa8", "7", ImGuiKey_7},
-	{8.0f, 0.0f, 1.0f, 1.0f, "_", "8", ImGuiKey_8},
-	{9.0f, 0.0f, 1.0f, 1.0f, "\xc3\xa7", "9", ImGuiKey_9},
-	{10.0f, 0.0f, 1.0f, 1.0f, "\xc3\xa0", "0", ImGuiKey_0},
-	{11.0f, 0.0f, 1.0f, 1.0f, ")", nullptr, ImGuiKey_Minus},
-	{12.0f, 0.0f, 1.0f, 1.0f, "=", "+", ImGuiKey_Equal},
-	{13.0f, 0.0f, 2.0f, 1.0f, "Back", nullptr, ImGuiKey_Backspace},
+// Number row (US layout shift symbols)
+static const KeyDef number_row_keys[] = {
+	{1.0f, "`", "~", ImGuiKey_GraveAccent},
+	{1.0f, "1", "!", ImGuiKey_1},
+	{1.0f, "2", "@", ImGuiKey_2},
+	{1.0f, "3", "#", ImGuiKey_3},
+	{1.0f, "4", "$", ImGuiKey_4},
+	{1.0f, "5", "%", ImGuiKey_5},
+	{1.0f, "6", "^", ImGuiKey_6},
+	{1.0f, "7", "&", ImGuiKey_7},
+	{1.0f, "8", "*", ImGuiKey_8},
+	{1.0f, "9", "(", ImGuiKey_9},
+	{1.0f, "0", ")", ImGuiKey_0},
+	{1.0f, "-", "_", ImGuiKey_Minus},
+	{1.0f, "=", "+", ImGuiKey_Equal},
+	{2.0f, "Back", nullptr, ImGuiKey_Backspace},
 };
 
 // QWERTY letter rows
-static const KeyLayoutData qwerty_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.5f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "[", "{", ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "]", "}", ImGuiKey_RightBracket},
-	{13.5f, 0.0f, 1.5f, 1.0f, "\\", "|", ImGuiKey_Backslash},
-};
-
-static const KeyLayoutData qwerty_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, ";", ":", ImGuiKey_Semicolon},
-	{11.75f, 0.0f, 1.0f, 1.0f, "'", "\"", ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 2.25f, 1.0f, "Enter", nullptr, ImGuiKey_Enter},
-};
-
-static const KeyLayoutData qwerty_row3_keys[] = {
-	{0.0f, 0.0f, 2.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{2.25f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, ",", "<", ImGuiKey_Comma},
-	{10.25f, 0.0f, 1.0f, 1.0f, ".", ">", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "/", "?", ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
-};
-
-// QWERTZ letter rows (German layout - Y and Z swapped)
-static const KeyLayoutData qwertz_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.5f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "\xc3\x9c", nullptr, ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "+", "*", ImGuiKey_RightBracket},
-	{13.5f, 0.0f, 1.5f, 1.0f, "#", "'", ImGuiKey_Backslash},
+static const KeyDef letter_row1_keys[] = {
+	{1.5f, "Tab", nullptr, ImGuiKey_Tab},
+	{1.0f, "Q", nullptr, ImGuiKey_Q},
+	{1.0f, "W", nullptr, ImGuiKey_W},
+	{1.0f, "E", nullptr, ImGuiKey_E},
+	{1.0f, "R", nullptr, ImGuiKey_R},
+	{1.0f, "T", nullptr, ImGuiKey_T},
+	{1.0f, "Y", nullptr, ImGuiKey_Y},
+	{1.0f, "U", nullptr, ImGuiKey_U},
+	{1.0f, "I", nullptr, ImGuiKey_I},
+	{1.0f, "O", nullptr, ImGuiKey_O},
+	{1.0f, "P", nullptr, ImGuiKey_P},
+	{1.0f, "[", "{", ImGuiKey_LeftBracket},
+	{1.0f, "]", "}", ImGuiKey_RightBracket},
+	{1.5f, "\\", "|", ImGuiKey_Backslash},
 };
 
-static const KeyLayoutData qwertz_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, "\xc3\x96", nullptr, ImGuiKey_Semicolon},
-	{11.75f, 0.0f, 1.0f, 1.0f, "\xc3\x84", nullptr, ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 2.25f, 1.0f, "Enter", nullptr, ImGuiKey_Enter},
+static const KeyDef letter_row2_keys[] = {
+	{1.75f, "Caps", nullptr, ImGuiKey_CapsLock},
+	{1.0f, "A", nullptr, ImGuiKey_A},
+	{1.0f, "S", nullptr, ImGuiKey_S},
+	{1.0f, "D", nullptr, ImGuiKey_D},
+	{1.0f, "F", nullptr, ImGuiKey_F},
+	{1.0f, "G", nullptr, ImGuiKey_G},
+	{1.0f, "H", nullptr, ImGuiKey_H},
+	{1.0f, "J", nullptr, ImGuiKey_J},
+	{1.0f, "K", nullptr, ImGuiKey_K},
+	{1.0f, "L", nullptr, ImGuiKey_L},
+	{1.0f, ";", ":", ImGuiKey_Semicolon},
+	{1.0f, "'", "\"", ImGuiKey_Apostrophe},
+	{2.25f, "Enter", nullptr, ImGuiKey_Enter},
 };
 
-static const KeyLayoutData qwertz_row3_keys[] = {
-	{0.0f, 0.0f, 2.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{2.25f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, ",", ";", ImGuiKey_Comma},
-	{10.25f, 0.0f, 1.0f, 1.0f, ".", ":", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "-", "_", ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
+static const KeyDef letter_row3_keys[] = {
+	{2.25f, "Shift", nullptr, ImGuiKey_LeftShift},
+	{1.0f, "Z", nullptr, ImGuiKey_Z},
+	{1.0f, "X", nullptr, ImGuiKey_X},
+	{1.0f, "C", nullptr, ImGuiKey_C},
+	{1.0f, "V", nullptr, ImGuiKey_V},
+	{1.0f, "B", nullptr, ImGuiKey_B},
+	{1.0f, "N", nullptr, ImGuiKey_N},
+	{1.0f, "M", nullptr, ImGuiKey_M},
+	{1.0f, ",", "<", ImGuiKey_Comma},
+	{1.0f, ".", ">", ImGuiKey_Period},
+	{1.0f, "/", "?", ImGuiKey_Slash},
+	{2.75f, "Shift", nullptr, ImGuiKey_RightShift},
 };
 
-// AZERTY letter rows (French layout)
-static const KeyLayoutData azerty_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.5f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "^", nullptr, ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "$", nullptr, ImGuiKey_RightBracket},
-	{13.5f, 0.0f, 1.5f, 1.0f, "*", nullptr, ImGuiKey_Backslash},
-};
-
-static const KeyLayoutData azerty_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{11.75f, 0.0f, 1.0f, 1.0f, "\xc3\xb9", "%", ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 2.25f, 1.0f, "Enter", nullptr, ImGuiKey_Enter},
+// Bottom row (modifiers + spacebar)
+static const KeyDef bottom_row_keys[] = {
+	{1.25f, "Ctrl", nullptr, ImGuiKey_LeftCtrl},
+	{1.25f, "Win", nullptr, ImGuiKey_LeftSuper},
+	{1.25f, "Alt", nullptr, ImGuiKey_LeftAlt},
+	{6.25f, "Space", nullptr, ImGuiKey_Space},
+	{1.25f, "Alt", nullptr, ImGuiKey_RightAlt},
+	{1.25f, "Win", nullptr, ImGuiKey_RightSuper},
+	{1.25f, "Menu", nullptr, ImGuiKey_Menu},
+	{1.25f, "Ctrl", nullptr, ImGuiKey_RightCtrl},
 };
 
-static const KeyLayoutData azerty_row3_keys[] = {
-	{0.0f, 0.0f, 2.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{2.25f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, ",", "?", ImGuiKey_Comma},
-	{9.25f, 0.0f, 1.0f, 1.0f, ";", ".", ImGuiKey_Semicolon},
-	{10.25f, 0.0f, 1.0f, 1.0f, ":", "/", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "!", nullptr, ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
+static const KeyDef *const base_rows[ImGuiKeyboardRow_COUNT] = {
+	function_row_nav_keys, number_row_keys, letter_row1_keys, letter_row2_keys, letter_row3_keys, bottom_row_keys,
 };
-
-// Colemak letter rows
-static const KeyLayoutData colemak_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.5f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.5f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{4.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{5.5f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.5f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{7.5f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{8.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{9.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{10.5f, 0.0f, 1.0f, 1.0f, ";", ":", ImGuiKey_Semicolon},
-	{11.5f, 0.0f, 1.0f, 1.0f, "[", "{", ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "]", "}", ImGuiKey_RightBracket},
-	{13.5f, 0.0f, 1.5f, 1.0f, "\\", "|", ImGuiKey_Backslash},
+static const int base_row_sizes[ImGuiKeyboardRow_COUNT] = {
+	IM_ARRAYSIZE(function_row_nav_keys), IM_ARRAYSIZE(number_row_keys), IM_ARRAYSIZE(letter_row1_keys),
+	IM_ARRAYSIZE(letter_row2_keys),		 IM_ARRAYSIZE(letter_row3_keys), IM_ARRAYSIZE(bottom_row_keys),
 };
 
-static const KeyLayoutData colemak_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Bksp", nullptr, ImGuiKey_Backspace},
-	{1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{3.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{4.75f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{5.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.75f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{9.75f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{10.75f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{11.75f, 0.0f, 1.0f, 1.0f, "'", "\"", ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 2.25f, 1.0f, "Enter", nullptr, ImGuiKey_Enter},
+#ifndef IMKEYBOARD_DISABLE_QWERTZ
+// German layout - Y and Z swapped, umlauts, German shift symbols
+static const KeyEdit qwertz_edits[] = {
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 0, {1.0f, "^", nullptr, ImGuiKey_GraveAccent}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 2, {1.0f, "2", "\"", ImGuiKey_2}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 3, {1.0f, "3", "\xc2\xa7", ImGuiKey_3}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 6, {1.0f, "6", "&", ImGuiKey_6}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 7, {1.0f, "7", "/", ImGuiKey_7}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 8, {1.0f, "8", "(", ImGuiKey_8}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 9, {1.0f, "9", ")", ImGuiKey_9}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 10, {1.0f, "0", "=", ImGuiKey_0}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 11, {1.0f, "\xc3\x9f", "?", ImGuiKey_Minus}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 12, {1.0f, "'", "`", ImGuiKey_Equal}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 6, {1.0f, "Z", nullptr, ImGuiKey_Z}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 11, {1.0f, "\xc3\x9c", nullptr, ImGuiKey_LeftBracket}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 12, {1.0f, "+", "*", ImGuiKey_RightBracket}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 13, {1.5f, "#", "'", ImGuiKey_Backslash}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 10, {1.0f, "\xc3\x96", nullptr, ImGuiKey_Semicolon}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 11, {1.0f, "\xc3\x84", nullptr, ImGuiKey_Apostrophe}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 1, {1.0f, "Y", nullptr, ImGuiKey_Y}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 8, {1.0f, ",", ";", ImGuiKey_Comma}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 9, {1.0f, ".", ":", ImGuiKey_Period}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 10, {1.0f, "-", "_", ImGuiKey_Slash}},
 };
-
-static const KeyLayoutData colemak_row3_keys[] = {
-	{0.0f, 0.0f, 2.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{2.25f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, ",", "<", ImGuiKey_Comma},
-	{10.25f, 0.0f, 1.0f, 1.0f, ".", ">", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "/", "?", ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
+#endif // IMKEYBOARD_DISABLE_QWERTZ
+
+#ifndef IMKEYBOARD_DISABLE_AZERTY
+// French layout - numbers require shift
+static const KeyEdit azerty_edits[] = {
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 0, {1.0f, "\xc2\xb2", nullptr, ImGuiKey_GraveAccent}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 1, {1.0f, "&", "1", ImGuiKey_1}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 2, {1.0f, "\xc3\xa9", "2", ImGuiKey_2}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 3, {1.0f, "\"", "3", ImGuiKey_3}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 4, {1.0f, "'", "4", ImGuiKey_4}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 5, {1.0f, "(", "5", ImGuiKey_5}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 6, {1.0f, "-", "6", ImGuiKey_6}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 7, {1.0f, "\xc3\xa8", "7", ImGuiKey_7}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 8, {1.0f, "_", "8", ImGuiKey_8}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 9, {1.0f, "\xc3\xa7", "9", ImGuiKey_9}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 10, {1.0f, "\xc3\xa0", "0", ImGuiKey_0}},
+	{ImGuiKeyboardRow_Number, ImGuiKeyboardEditOp_Set, 11, {1.0f, ")", nullptr, ImGuiKey_Minus}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 1, {1.0f, "A", nullptr, ImGuiKey_A}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 2, {1.0f, "Z", nullptr, ImGuiKey_Z}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 11, {1.0f, "^", nullptr, ImGuiKey_LeftBracket}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 12, {1.0f, "$", nullptr, ImGuiKey_RightBracket}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 13, {1.5f, "*", nullptr, ImGuiKey_Backslash}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 1, {1.0f, "Q", nullptr, ImGuiKey_Q}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 10, {1.0f, "M", nullptr, ImGuiKey_M}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 11, {1.0f, "\xc3\xb9", "%", ImGuiKey_Apostrophe}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 1, {1.0f, "W", nullptr, ImGuiKey_W}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 7, {1.0f, ",", "?", ImGuiKey_Comma}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 8, {1.0f, ";", ".", ImGuiKey_Semicolon}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 9, {1.0f, ":", "/", ImGuiKey_Period}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 10, {1.0f, "!", nullptr, ImGuiKey_Slash}},
 };
-
-// Dvorak letter rows
-static const KeyLayoutData dvorak_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab}, {1.5f, 0.0f, 1.0f, 1.0f, "'", "\"", ImGuiKey_Apostrophe},
-	{2.5f, 0.0f, 1.0f, 1.0f, ",", "<", ImGuiKey_Comma},		{3.5f, 0.0f, 1.0f, 1.0f, ".", ">", ImGuiKey_Period},
-	{4.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},		{5.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{6.5f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},		{7.5f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{8.5f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},		{9.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{10.5f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},	{11.5f, 0.0f, 1.0f, 1.0f, "/", "?", ImGuiKey_Slash},
-	{12.5f, 0.0f, 1.0f, 1.0f, "=", "+", ImGuiKey_Equal},	{13.5f, 0.0f, 1.5f, 1.0f, "\\", "|", ImGuiKey_Backslash},
+#endif // IMKEYBOARD_DISABLE_AZERTY
+
+#ifndef IMKEYBOARD_DISABLE_COLEMAK
+static const KeyEdit colemak_edits[] = {
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 3, {1.0f, "F", nullptr, ImGuiKey_F}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 4, {1.0f, "P", nullptr, ImGuiKey_P}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 5, {1.0f, "G", nullptr, ImGuiKey_G}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 6, {1.0f, "J", nullptr, ImGuiKey_J}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 7, {1.0f, "L", nullptr, ImGuiKey_L}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 8, {1.0f, "U", nullptr, ImGuiKey_U}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 9, {1.0f, "Y", nullptr, ImGuiKey_Y}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 10, {1.0f, ";", ":", ImGuiKey_Semicolon}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 0, {1.75f, "Bksp", nullptr, ImGuiKey_Backspace}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 2, {1.0f, "R", nullptr, ImGuiKey_R}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 3, {1.0f, "S", nullptr, ImGuiKey_S}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 4, {1.0f, "T", nullptr, ImGuiKey_T}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 5, {1.0f, "D", nullptr, ImGuiKey_D}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 7, {1.0f, "N", nullptr, ImGuiKey_N}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 8, {1.0f, "E", nullptr, ImGuiKey_E}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 9, {1.0f, "I", nullptr, ImGuiKey_I}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 10, {1.0f, "O", nullptr, ImGuiKey_O}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 6, {1.0f, "K", nullptr, ImGuiKey_K}},
 };
-
-static const KeyLayoutData dvorak_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock}, {1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},		   {3.75f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.75f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},		   {5.75f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{6.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},		   {7.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{8.75f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},		   {9.75f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{10.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},		   {11.75f, 0.0f, 1.0f, 1.0f, "-", "_", ImGuiKey_Minus},
-	{12.75f, 0.0f, 2.25f, 1.0f, "Enter", nullptr, ImGuiKey_Enter},
+#endif // IMKEYBOARD_DISABLE_COLEMAK
+
+#ifndef IMKEYBOARD_DISABLE_DVORAK
+static const KeyEdit dvorak_edits[] = {
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 1, {1.0f, "'", "\"", ImGuiKey_Apostrophe}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 2, {1.0f, ",", "<", ImGuiKey_Comma}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 3, {1.0f, ".", ">", ImGuiKey_Period}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 4, {1.0f, "P", nullptr, ImGuiKey_P}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 5, {1.0f, "Y", nullptr, ImGuiKey_Y}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 6, {1.0f, "F", nullptr, ImGuiKey_F}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 7, {1.0f, "G", nullptr, ImGuiKey_G}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 8, {1.0f, "C", nullptr, ImGuiKey_C}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 9, {1.0f, "R", nullptr, ImGuiKey_R}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 10, {1.0f, "L", nullptr, ImGuiKey_L}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 11, {1.0f, "/", "?", ImGuiKey_Slash}},
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Set, 12, {1.0f, "=", "+", ImGuiKey_Equal}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 2, {1.0f, "O", nullptr, ImGuiKey_O}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 3, {1.0f, "E", nullptr, ImGuiKey_E}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 4, {1.0f, "U", nullptr, ImGuiKey_U}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 5, {1.0f, "I", nullptr, ImGuiKey_I}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 6, {1.0f, "D", nullptr, ImGuiKey_D}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 7, {1.0f, "H", nullptr, ImGuiKey_H}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 8, {1.0f, "T", nullptr, ImGuiKey_T}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 9, {1.0f, "N", nullptr, ImGuiKey_N}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 10, {1.0f, "S", nullptr, ImGuiKey_S}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 11, {1.0f, "-", "_", ImGuiKey_Minus}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 1, {1.0f, ";", ":", ImGuiKey_Semicolon}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 2, {1.0f, "Q", nullptr, ImGuiKey_Q}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 3, {1.0f, "J", nullptr, ImGuiKey_J}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 4, {1.0f, "K", nullptr, ImGuiKey_K}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 5, {1.0f, "X", nullptr, ImGuiKey_X}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 6, {1.0f, "B", nullptr, ImGuiKey_B}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 8, {1.0f, "W", nullptr, ImGuiKey_W}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 9, {1.0f, "V", nullptr, ImGuiKey_V}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 10, {1.0f, "Z", nullptr, ImGuiKey_Z}},
 };
-
-static const KeyLayoutData dvorak_row3_keys[] = {
-	{0.0f, 0.0f, 2.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{2.25f, 0.0f, 1.0f, 1.0f, ";", ":", ImGuiKey_Semicolon},
-	{3.25f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{4.25f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{5.25f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{6.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{7.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{10.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{11.25f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
+#endif // IMKEYBOARD_DISABLE_DVORAK
+
+#ifndef IMKEYBOARD_DISABLE_APPLE
+// Apple keyboards: F13, F14, F15 instead of Print Screen, Scroll Lock, Pause, and a full-size bottom row like the Apple
+// Magic Keyboard with Numeric Keypad (Ctrl, Option, Command, Space, Command, Option, Ctrl - no Fn key)
+static const KeyEdit apple_edits[] = {
+	{ImGuiKeyboardRow_FunctionNav, ImGuiKeyboardEditOp_Set, 0, {1.0f, "F13", nullptr, ImGuiKey_PrintScreen}},
+	{ImGuiKeyboardRow_FunctionNav, ImGuiKeyboardEditOp_Set, 1, {1.0f, "F14", nullptr, ImGuiKey_ScrollLock}},
+	{ImGuiKeyboardRow_FunctionNav, ImGuiKeyboardEditOp_Set, 2, {1.0f, "F15", nullptr, ImGuiKey_Pause}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 12, {2.25f, "Return", nullptr, ImGuiKey_Enter}},
+	{ImGuiKeyboardRow_Bottom, ImGuiKeyboardEditOp_Set, 0, {1.5f, "Ctrl", nullptr, ImGuiKey_LeftCtrl}},
+	{ImGuiKeyboardRow_Bottom, ImGuiKeyboardEditOp_Set, 1, {1.25f, "Opt", nullptr, ImGuiKey_LeftAlt}},
+	{ImGuiKeyboardRow_Bottom, ImGuiKeyboardEditOp_Set, 2, {1.5f, "Cmd", nullptr, ImGuiKey_LeftSuper}},
+	{ImGuiKeyboardRow_Bottom, ImGuiKeyboardEditOp_Set, 4, {1.5f, "Cmd", nullptr, ImGuiKey_RightSuper}},
+	{ImGuiKeyboardRow_Bottom, ImGuiKeyboardEditOp_Set, 5, {1.25f, "Opt", nullptr, ImGuiKey_RightAlt}},
+	{ImGuiKeyboardRow_Bottom, ImGuiKeyboardEditOp_Remove, 6, {0.0f, nullptr, nullptr, ImGuiKey_None}},
+	{ImGuiKeyboardRow_Bottom, ImGuiKeyboardEditOp_Width, 6, {1.75f, nullptr, nullptr, ImGuiKey_None}},
 };
+#endif // IMKEYBOARD_DISABLE_APPLE
 
-// ISO layout rows - ISO keyboards have:
-// - L-shaped Enter key (spans row 1 and row 2)
+#ifndef IMKEYBOARD_DISABLE_ISO
+// ISO keyboards have:
+// - L-shaped Enter key (spans row 1 and row 2), rendered separately as a polygon
+// - No backslash key on row 1, a hash key left of Enter on row 2 instead
 // - Shorter left Shift with extra key next to it
-// - No backslash key on row 1 (it's part of Enter or moved to row 3)
-
-// ISO QWERTY row 1 - Enter key rendered separately as L-shape
-static const KeyLayoutData qwerty_iso_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.5f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "[", "{", ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "]", "}", ImGuiKey_RightBracket},
+static const KeyEdit iso_edits[] = {
+	{ImGuiKeyboardRow_Letters1, ImGuiKeyboardEditOp_Remove, 13, {0.0f, nullptr, nullptr, ImGuiKey_None}},
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 12, {1.0f, "#", "~", ImGuiKey_Backslash}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Width, 0, {1.25f, nullptr, nullptr, ImGuiKey_None}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Insert, 1, {1.0f, "\\", "|", ImGuiKey_Oem102}},
 };
+#endif // IMKEYBOARD_DISABLE_ISO
 
-// ISO QWERTY row 2 - Enter key is rendered separately as L-shape polygon
-static const KeyLayoutData qwerty_iso_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, ";", ":", ImGuiKey_Semicolon},
-	{11.75f, 0.0f, 1.0f, 1.0f, "'", "\"", ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 1.0f, 1.0f, "#", "~", ImGuiKey_Backslash}, // ISO hash key (left of Enter)
+#ifdef IMKEYBOARD_HAS_QWERTZ_ISO
+static const KeyEdit qwertz_iso_edits[] = {
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 12, {1.0f, "#", "'", ImGuiKey_Backslash}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 1, {1.0f, "<", ">", ImGuiKey_Oem102}},
 };
+#endif // IMKEYBOARD_HAS_QWERTZ_ISO
 
-// ISO QWERTY row 3 - shorter left Shift with extra key
-static const KeyLayoutData qwerty_iso_row3_keys[] = {
-	{0.0f, 0.0f, 1.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{1.25f, 0.0f, 1.0f, 1.0f, "\\", "|", ImGuiKey_Oem102}, // ISO extra key
-	{2.25f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, ",", "<", ImGuiKey_Comma},
-	{10.25f, 0.0f, 1.0f, 1.0f, ".", ">", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "/", "?", ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
+#ifdef IMKEYBOARD_HAS_AZERTY_ISO
+static const KeyEdit azerty_iso_edits[] = {
+	{ImGuiKeyboardRow_Letters2, ImGuiKeyboardEditOp_Set, 12, {1.0f, "*", nullptr, ImGuiKey_Backslash}},
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 1, {1.0f, "<", ">", ImGuiKey_Oem102}},
 };
+#endif // IMKEYBOARD_HAS_AZERTY_ISO
 
-// ISO QWERTZ (German) rows
-static const KeyLayoutData qwertz_iso_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.5f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "\xc3\x9c", nullptr, ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "+", "*", ImGuiKey_RightBracket},
-};
-
-static const KeyLayoutData qwertz_iso_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, "\xc3\x96", nullptr, ImGuiKey_Semicolon},
-	{11.75f, 0.0f, 1.0f, 1.0f, "\xc3\x84", nullptr, ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 1.0f, 1.0f, "#", "'", ImGuiKey_Backslash},
-};
-
-static const KeyLayoutData qwertz_iso_row3_keys[] = {
-	{0.0f, 0.0f, 1.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{1.25f, 0.0f, 1.0f, 1.0f, "<", ">", ImGuiKey_Oem102},
-	{2.25f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, ",", ";", ImGuiKey_Comma},
-	{10.25f, 0.0f, 1.0f, 1.0f, ".", ":", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "-", "_", ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
-};
-
-// ISO AZERTY (French) rows
-static const KeyLayoutData azerty_iso_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.5f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "^", nullptr, ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "$", nullptr, ImGuiKey_RightBracket},
-};
-
-static const KeyLayoutData azerty_iso_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{11.75f, 0.0f, 1.0f, 1.0f, "\xc3\xb9", "%", ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 1.0f, 1.0f, "*", nullptr, ImGuiKey_Backslash},
-};
-
-static const KeyLayoutData azerty_iso_row3_keys[] = {
-	{0.0f, 0.0f, 1.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{1.25f, 0.0f, 1.0f, 1.0f, "<", ">", ImGuiKey_Oem102},
-	{2.25f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, ",", "?", ImGuiKey_Comma},
-	{9.25f, 0.0f, 1.0f, 1.0f, ";", ".", ImGuiKey_Semicolon},
-	{10.25f, 0.0f, 1.0f, 1.0f, ":", "/", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "!", nullptr, ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
-};
-
-// Apple ANSI layout rows (US Mac keyboard)
-// Apple keyboards use Command (⌘) instead of Win, Option instead of Alt
-static const KeyLayoutData apple_ansi_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.5f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "[", "{", ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "]", "}", ImGuiKey_RightBracket},
-	{13.5f, 0.0f, 1.5f, 1.0f, "\\", "|", ImGuiKey_Backslash},
-};
-
-static const KeyLayoutData apple_ansi_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, ";", ":", ImGuiKey_Semicolon},
-	{11.75f, 0.0f, 1.0f, 1.0f, "'", "\"", ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 2.25f, 1.0f, "Return", nullptr, ImGuiKey_Enter},
-};
-
-static const KeyLayoutData apple_ansi_row3_keys[] = {
-	{0.0f, 0.0f, 2.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{2.25f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, ",", "<", ImGuiKey_Comma},
-	{10.25f, 0.0f, 1.0f, 1.0f, ".", ">", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "/", "?", ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
-};
-
-// Apple full keyboard bottom row (Ctrl, Option, Command, Space, Command, Option, Ctrl)
-// Full-size layout like Apple Magic Keyboard with Numeric Keypad - no Fn key, wider modifier keys
-static const KeyLayoutData apple_bottom_row_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Ctrl", nullptr, ImGuiKey_LeftCtrl},
-	{1.5f, 0.0f, 1.25f, 1.0f, "Opt", nullptr, ImGuiKey_LeftAlt},
-	{2.75f, 0.0f, 1.5f, 1.0f, "Cmd", nullptr, ImGuiKey_LeftSuper},
-	{4.25f, 0.0f, 6.25f, 1.0f, "Space", nullptr, ImGuiKey_Space},
-	{10.5f, 0.0f, 1.5f, 1.0f, "Cmd", nullptr, ImGuiKey_RightSuper},
-	{12.0f, 0.0f, 1.25f, 1.0f, "Opt", nullptr, ImGuiKey_RightAlt},
-	{13.25f, 0.0f, 1.75f, 1.0f, "Ctrl", nullptr, ImGuiKey_RightCtrl},
-};
-
-// Apple ISO layout rows (UK/International Mac keyboard)
-// Same as Apple ANSI but with ISO Enter key and extra key next to left Shift
-static const KeyLayoutData apple_iso_row1_keys[] = {
-	{0.0f, 0.0f, 1.5f, 1.0f, "Tab", nullptr, ImGuiKey_Tab},
-	{1.5f, 0.0f, 1.0f, 1.0f, "Q", nullptr, ImGuiKey_Q},
-	{2.5f, 0.0f, 1.0f, 1.0f, "W", nullptr, ImGuiKey_W},
-	{3.5f, 0.0f, 1.0f, 1.0f, "E", nullptr, ImGuiKey_E},
-	{4.5f, 0.0f, 1.0f, 1.0f, "R", nullptr, ImGuiKey_R},
-	{5.5f, 0.0f, 1.0f, 1.0f, "T", nullptr, ImGuiKey_T},
-	{6.5f, 0.0f, 1.0f, 1.0f, "Y", nullptr, ImGuiKey_Y},
-	{7.5f, 0.0f, 1.0f, 1.0f, "U", nullptr, ImGuiKey_U},
-	{8.5f, 0.0f, 1.0f, 1.0f, "I", nullptr, ImGuiKey_I},
-	{9.5f, 0.0f, 1.0f, 1.0f, "O", nullptr, ImGuiKey_O},
-	{10.5f, 0.0f, 1.0f, 1.0f, "P", nullptr, ImGuiKey_P},
-	{11.5f, 0.0f, 1.0f, 1.0f, "[", "{", ImGuiKey_LeftBracket},
-	{12.5f, 0.0f, 1.0f, 1.0f, "]", "}", ImGuiKey_RightBracket},
-};
-
-static const KeyLayoutData apple_iso_row2_keys[] = {
-	{0.0f, 0.0f, 1.75f, 1.0f, "Caps", nullptr, ImGuiKey_CapsLock},
-	{1.75f, 0.0f, 1.0f, 1.0f, "A", nullptr, ImGuiKey_A},
-	{2.75f, 0.0f, 1.0f, 1.0f, "S", nullptr, ImGuiKey_S},
-	{3.75f, 0.0f, 1.0f, 1.0f, "D", nullptr, ImGuiKey_D},
-	{4.75f, 0.0f, 1.0f, 1.0f, "F", nullptr, ImGuiKey_F},
-	{5.75f, 0.0f, 1.0f, 1.0f, "G", nullptr, ImGuiKey_G},
-	{6.75f, 0.0f, 1.0f, 1.0f, "H", nullptr, ImGuiKey_H},
-	{7.75f, 0.0f, 1.0f, 1.0f, "J", nullptr, ImGuiKey_J},
-	{8.75f, 0.0f, 1.0f, 1.0f, "K", nullptr, ImGuiKey_K},
-	{9.75f, 0.0f, 1.0f, 1.0f, "L", nullptr, ImGuiKey_L},
-	{10.75f, 0.0f, 1.0f, 1.0f, ";", ":", ImGuiKey_Semicolon},
-	{11.75f, 0.0f, 1.0f, 1.0f, "'", "\"", ImGuiKey_Apostrophe},
-	{12.75f, 0.0f, 1.0f, 1.0f, "#", "~", ImGuiKey_Backslash},
-};
-
-static const KeyLayoutData apple_iso_row3_keys[] = {
-	{0.0f, 0.0f, 1.25f, 1.0f, "Shift", nullptr, ImGuiKey_LeftShift},
-	{1.25f, 0.0f, 1.0f, 1.0f, "`", "~", ImGuiKey_Oem102},
-	{2.25f, 0.0f, 1.0f, 1.0f, "Z", nullptr, ImGuiKey_Z},
-	{3.25f, 0.0f, 1.0f, 1.0f, "X", nullptr, ImGuiKey_X},
-	{4.25f, 0.0f, 1.0f, 1.0f, "C", nullptr, ImGuiKey_C},
-	{5.25f, 0.0f, 1.0f, 1.0f, "V", nullptr, ImGuiKey_V},
-	{6.25f, 0.0f, 1.0f, 1.0f, "B", nullptr, ImGuiKey_B},
-	{7.25f, 0.0f, 1.0f, 1.0f, "N", nullptr, ImGuiKey_N},
-	{8.25f, 0.0f, 1.0f, 1.0f, "M", nullptr, ImGuiKey_M},
-	{9.25f, 0.0f, 1.0f, 1.0f, ",", "<", ImGuiKey_Comma},
-	{10.25f, 0.0f, 1.0f, 1.0f, ".", ">", ImGuiKey_Period},
-	{11.25f, 0.0f, 1.0f, 1.0f, "/", "?", ImGuiKey_Slash},
-	{12.25f, 0.0f, 2.75f, 1.0f, "Shift", nullptr, ImGuiKey_RightShift},
+#ifdef IMKEYBOARD_HAS_APPLE_ISO
+static const KeyEdit apple_iso_edits[] = {
+	{ImGuiKeyboardRow_Letters3, ImGuiKeyboardEditOp_Set, 1, {1.0f, "`", "~", ImGuiKey_Oem102}},
 };
+#endif // IMKEYBOARD_HAS_APPLE_ISO
+
+static void ApplyKeyEdits(ImVector<KeyDef> *rows, const KeyEdit *edits, int edit_count) {
+	for (int i = 0; i < edit_count; i++) {
+		const KeyEdit &edit = edits[i];
+		ImVector<KeyDef> &row = rows[edit.Row];
+		const int max_index = edit.Op == ImGuiKeyboardEditOp_Insert ? row.Size : row.Size - 1;
+		if (edit.Index < 0 || edit.Index > max_index) {
+			continue; // Edits from SetLayoutEdits() may not fit the row
+		}
+		switch (edit.Op) {
+		case ImGuiKeyboardEditOp_Set:
+			row[edit.Index] = edit.Key;
+			break;
+		case ImGuiKeyboardEditOp_Insert:
+			row.insert(row.Data + edit.Index, edit.Key);
+			break;
+		case ImGuiKeyboardEditOp_Remove:
+			row.erase(row.Data + edit.Index);
+			break;
+		case ImGuiKeyboardEditOp_Width:
+			row[edit.Index].Width = edit.Key.Width;
+			break;
+		}
+	}
+}
 
-// Bottom row (modifiers + spacebar)
-static const KeyLayoutData bottom_row_keys[] = {
-	{0.0f, 0.0f, 1.25f, 1.0f, "Ctrl", nullptr, ImGuiKey_LeftCtrl},
-	{1.25f, 0.0f, 1.25f, 1.0f, "Win", nullptr, ImGuiKey_LeftSuper},
-	{2.5f, 0.0f, 1.25f, 1.0f, "Alt", nullptr, ImGuiKey_LeftAlt},
-	{3.75f, 0.0f, 6.25f, 1.0f, "Space", nullptr, ImGuiKey_Space},
-	{10.0f, 0.0f, 1.25f, 1.0f, "Alt", nullptr, ImGuiKey_RightAlt},
-	{11.25f, 0.0f, 1.25f, 1.0f, "Win", nullptr, ImGuiKey_RightSuper},
-	{12.5f, 0.0f, 1.25f, 1.0f, "Menu", nullptr, ImGuiKey_Menu},
-	{13.75f, 0.0f, 1.25f, 1.0f, "Ctrl", nullptr, ImGuiKey_RightCtrl},
-};
+// Flat rows of a layout, composed from the base rows and the edits of the layout on first use
+static const KeyboardLayoutRows &GetLayoutRows(ImGuiKeyboardLayout layout) {
+	IM_ASSERT(layout >= 0 && layout < ImGuiKeyboardLayout_Count && layout != ImGuiKeyboardLayout_NumericPad);
+	KeyboardLayoutRows &rows = GetContext()->Layouts[layout];
+	if (rows.Expanded) {
+		return rows;
+	}
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::ExpandLayout");
+	rows.ISO = false;
+
+	// Language and vendor edits
+	const KeyEdit *layout_edits = nullptr;
+	int layout_edit_count = 0;
+	switch (layout) {
+#ifndef IMKEYBOARD_DISABLE_QWERTZ
+	case ImGuiKeyboardLayout_Qwertz:
+	case ImGuiKeyboardLayout_QwertzISO:
+		layout_edits = qwertz_edits;
+		layout_edit_count = IM_ARRAYSIZE(qwertz_edits);
+		break;
+#endif
+#ifndef IMKEYBOARD_DISABLE_AZERTY
+	case ImGuiKeyboardLayout_Azerty:
+	case ImGuiKeyboardLayout_AzertyISO:
+		layout_edits = azerty_edits;
+		layout_edit_count = IM_ARRAYSIZE(azerty_edits);
+		break;
+#endif
+#ifndef IMKEYBOARD_DISABLE_COLEMAK
+	case ImGuiKeyboardLayout_Colemak:
+		layout_edits = colemak_edits;
+		layout_edit_count = IM_ARRAYSIZE(colemak_edits);
+		break;
+#endif
+#ifndef IMKEYBOARD_DISABLE_DVORAK
+	case ImGuiKeyboardLayout_Dvorak:
+		layout_edits = dvorak_edits;
+		layout_edit_count = IM_ARRAYSIZE(dvorak_edits);
+		break;
+#endif
+#ifndef IMKEYBOARD_DISABLE_APPLE
+	case ImGuiKeyboardLayout_AppleANSI:
+	case ImGuiKeyboardLayout_AppleISO:
+		layout_edits = apple_edits;
+		layout_edit_count = IM_ARRAYSIZE(apple_edits);
+		break;
+#endif
+	default:
+		break;
+	}
 
-static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2 &key_size, const char *label,
-					  const char *shiftLabel, ImGuiKey key, float scale, ImGuiKeyboardFlags flags) {
-	const ImGuiKeyboardStyle &style = GetStyle();
-	const float key_rounding = style.KeyRounding * scale;
-	const float key_face_rounding = style.KeyFaceRounding * scale;
-	const ImVec2 key_face_pos(style.KeyFaceOffset.x * scale, style.KeyFaceOffset.y * scale);
-	const ImVec2 key_label_pos(style.KeyLabelOffset.x * scale, style.KeyLabelOffset.y * scale);
+	// Language specific edits on top of the ISO rows
+	const KeyEdit *iso_tweaks = nullptr;
+	int iso_tweak_count = 0;
+	switch (layout) {
+#ifndef IMKEYBOARD_DISABLE_ISO
+	case ImGuiKeyboardLayout_QwertyISO:
+		rows.ISO = true;
+		break;
+#endif
+#ifdef IMKEYBOARD_HAS_QWERTZ_ISO
+	case ImGuiKeyboardLayout_QwertzISO:
+		rows.ISO = true;
+		iso_tweaks = qwertz_iso_edits;
+		iso_tweak_count = IM_ARRAYSIZE(qwertz_iso_edits);
+		break;
+#endif
+#ifdef IMKEYBOARD_HAS_AZERTY_ISO
+	case ImGuiKeyboardLayout_AzertyISO:
+		rows.ISO = true;
+		iso_tweaks = azerty_iso_edits;
+		iso_tweak_count = IM_ARRAYSIZE(azerty_iso_edits);
+		break;
+#endif
+#ifdef IMKEYBOARD_HAS_APPLE_ISO
+	case ImGuiKeyboardLayout_AppleISO:
+		rows.ISO = true;
+		iso_tweaks = apple_iso_edits;
+		iso_tweak_count = IM_ARRAYSIZE(apple_iso_edits);
+		break;
+#endif
+	default:
+		break;
+	}
 
-	ImVec2 key_max = ImVec2(key_min.x + key_size.x, key_min.y + key_size.y);
-	ImVec2 key_face_size =
-		ImVec2(key_size.x - style.KeyFaceOffset.x * 2.0f * scale, key_size.y - style.KeyFaceOffset.y * 2.0f * scale);
+	ImVector<KeyDef> defs[ImGuiKeyboardRow_COUNT];
+	for (int r = 0; r < ImGuiKeyboardRow_COUNT; r++) {
+		for (int i = 0; i < base_row_sizes[r]; i++) {
+			defs[r].push_back(base_rows[r][i]);
+		}
+	}
+	ApplyKeyEdits(defs, layout_edits, layout_edit_count);
+#ifndef IMKEYBOARD_DISABLE_ISO
+	if (rows.ISO) {
+		ApplyKeyEdits(defs, iso_edits, IM_ARRAYSIZE(iso_edits));
+		ApplyKeyEdits(defs, iso_tweaks, iso_tweak_count);
+	}
+#else
+	IM_UNUSED(iso_tweaks);
+	IM_UNUSED(iso_tweak_count);
+#endif
+	const ImVector<KeyEdit> &user_edits = GetContext()->LayoutEdits[layout];
+	ApplyKeyEdits(defs, user_edits.Data, user_edits.Size);
+
+	for (int r = 0; r < ImGuiKeyboardRow_COUNT; r++) {
+		ImVector<KeyLayoutData> &row = rows.Rows[r];
+		row.resize(defs[r].Size);
+		float x = 0.0f;
+		for (int i = 0; i < defs[r].Size; i++) {
+			const KeyDef &def = defs[r][i];
+			KeyLayoutData &key = row[i];
+			key.X = x;
+			key.Y = 0.0f;
+			key.Width = def.Width;
+			key.Height = 1.0f;
+			key.Label = def.Label;
+			key.ShiftLabel = def.ShiftLabel;
+			key.Key = def.Key;
+			x += def.Width;
+		}
+	}
+	rows.Expanded = true;
+	return rows;
+}
 
-	// Key background
-	draw_list->AddRectFilled(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyBackground), key_rounding);
-	draw_list->AddRect(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyBorder), key_rounding);
+void SetLayoutEdits(ImGuiKeyboardLayout layout, const ImGuiKeyboardKeyEdit *edits, int edit_count) {
+	IM_ASSERT(layout >= 0 && layout < ImGuiKeyboardLayout_Count && layout != ImGuiKeyboardLayout_NumericPad);
+	KeyboardContext *ctx = GetContext();
+	ImVector<KeyEdit> &layout_edits = ctx->LayoutEdits[layout];
+	layout_edits.clear();
+	for (int i = 0; i < edit_count; i++) {
+		const ImGuiKeyboardKeyEdit &src = edits[i];
+		if (src.Row < 0 || src.Row >= ImGuiKeyboardRow_COUNT || src.Op < 0 || src.Op >= ImGuiKeyboardEditOp_COUNT ||
+			src.Index < 0 || src.Index > 127) {
+			continue;
+		}
+		KeyEdit edit = {(ImS8)src.Row, (ImS8)src.Op, (ImS8)src.Index, {src.Width, src.Label, src.ShiftLabel, src.Key}};
+		layout_edits.push_back(edit);
+	}
 
-	// Key face
-	ImVec2 face_min = ImVec2(key_min.x + key_face_pos.x, key_min.y + key_face_pos.y);
-	ImVec2 face_max = ImVec2(face_min.x + key_face_size.x, face_min.y + key_face_size.y);
-	draw_list->AddRect(face_min, face_max, GetColorU32(ImGuiKeyboardCol_KeyFaceBorder), key_face_rounding,
-					   ImDrawFlags_None, style.KeyFaceBorderSize);
-	draw_list->AddRectFilled(face_min, face_max, GetColorU32(ImGuiKeyboardCol_KeyFace), key_face_rounding);
+	// Expand again on next use
+	ctx->LayoutEditCount++;
+	ctx->Layouts[layout].Expanded = false;
+	ctx->CharIndex[layout].clear();
+	ctx->TextKeysLayout = -1;
+}
 
-	// Label rendering
-	ImVec2 label_min = ImVec2(key_min.x + key_label_pos.x, key_min.y + key_label_pos.y);
+// Text lines of a key label, top to bottom
+static int GetKeyLabelLines(const char *label, const char *shiftLabel, ImGuiKeyboardFlags flags,
+							const char *out_lines[2]) {
+	if ((flags & ImGuiKeyboardFlags_ShowBothLabels) && shiftLabel) {
+		// Show both labels: shift label on top, normal label below
+		out_lines[0] = shiftLabel;
+		out_lines[1] = label;
+		return 2;
+	}
+	// Select label based on shift state (unless NoShiftLabels flag is set)
+	const bool shiftPressed = !(flags & ImGuiKeyboardFlags_NoShiftLabels) &&
+							  (IsKeyDown(ImGuiKey_LeftShift) || IsKeyDown(ImGuiKey_RightShift));
+	out_lines[0] = (shiftPressed && shiftLabel) ? shiftLabel : label;
+	return 1;
+}
 
+// Icon or text label of a key
+static void RenderKeyLabel(ImDrawList *draw_list, const ImVec2 &face_min, const ImVec2 &face_max,
+						   const ImVec2 &label_min, const char *label, const char *shiftLabel, ImGuiKey key,
+						   ImGuiKeyboardFlags flags) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::KeyLabel");
+#ifdef IMKEYBOARD_DISABLE_ICONS
+	IM_UNUSED(face_min);
+	IM_UNUSED(face_max);
+	IM_UNUSED(key);
+#else
 	// Check if we should draw icons instead of text
 	const bool showIcons = (flags & ImGuiKeyboardFlags_ShowIcons);
 	const bool isWindowsKey = (key == ImGuiKey_LeftSuper || key == ImGuiKey_RightSuper);
@@ -758,7 +979,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 	const bool isEnterKey = (key == ImGuiKey_Enter || key == ImGuiKey_KeypadEnter);
 	const bool isAppleModifier = (label && (strcmp(label, "Ctrl") == 0 || strcmp(label, "Opt") == 0 || strcmp(label, "Cmd") == 0));
 	// Numpad navigation keys (when NumLock is off, these act as navigation keys)
-	const bool numLockActive = ImGui::IsKeyDown(ImGuiKey_NumLock);
+	const bool numLockActive = IsKeyDown(ImGuiKey_NumLock);
 	const bool isNumpadArrowKey = !numLockActive && (key == ImGuiKey_Keypad8 || key == ImGuiKey_Keypad2 ||
 													 key == ImGuiKey_Keypad4 || key == ImGuiKey_Keypad6);
 	const bool isNumpadNavKey =
@@ -767,7 +988,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 
 	if (showIcons && isWindowsKey && !isAppleModifier) {
 		// Draw Windows logo (4 squares in a 2x2 grid)
-		const float logo_size = ImGui::GetFontSize() * 0.9f;
+		const float logo_size = GetDrawSource()->FontSize * 0.9f;
 		const float quad_size = logo_size * 0.45f;
 		const float gap = logo_size * 0.1f;
 		ImVec2 logo_min = ImVec2(label_min.x, label_min.y);
@@ -787,7 +1008,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 								 logo_color);
 	} else if (showIcons && isArrowKey) {
 		// Draw arrow triangles centered on the key face
-		const float arrow_size = ImGui::GetFontSize() * 0.7f;
+		const float arrow_size = GetDrawSource()->FontSize * 0.7f;
 		ImU32 arrow_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 		ImVec2 center = ImVec2((face_min.x + face_max.x) * 0.5f, (face_min.y + face_max.y) * 0.5f);
 
@@ -818,10 +1039,10 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 		}
 	} else if (showIcons && isNumpadArrowKey) {
 		// Draw number label first, then small arrow icon in corner (when NumLock is off)
-		draw_list->AddText(label_min, GetColorU32(ImGuiKeyboardCol_KeyLabel), label);
+		AddKeyText(draw_list, label_min, label);
 
 		// Draw small arrow in bottom-right corner
-		const float arrow_size = ImGui::GetFontSize() * 0.35f;
+		const float arrow_size = GetDrawSource()->FontSize * 0.35f;
 		ImU32 arrow_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 		ImVec2 center = ImVec2(face_max.x - arrow_size * 0.8f, face_max.y - arrow_size * 0.8f);
 
@@ -852,7 +1073,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 		}
 	} else if (showIcons && isNumpadNavKey) {
 		// Draw number label first, then small nav label in corner (when NumLock is off)
-		draw_list->AddText(label_min, GetColorU32(ImGuiKeyboardCol_KeyLabel), label);
+		AddKeyText(draw_list, label_min, label);
 
 		// Draw small nav label in bottom-right corner
 		const char *navLabel = nullptr;
@@ -869,13 +1090,13 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 		else if (key == ImGuiKey_KeypadDecimal)
 			navLabel = "De";
 		if (navLabel) {
-			ImVec2 text_size = ImGui::CalcTextSize(navLabel);
+			ImVec2 text_size = CalcKeyTextSize(navLabel);
 			ImVec2 nav_pos = ImVec2(face_max.x - text_size.x - 2.0f, face_max.y - text_size.y - 2.0f);
-			draw_list->AddText(nav_pos, GetColorU32(ImGuiKeyboardCol_KeyLabel), navLabel);
+			AddKeyText(draw_list, nav_pos, navLabel);
 		}
 	} else if (showIcons && isAppleModifier) {
 		// Draw Apple modifier icons: Control, Option, Command
-		const float icon_size = ImGui::GetFontSize() * 0.8f;
+		const float icon_size = GetDrawSource()->FontSize * 0.8f;
 		ImU32 icon_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 		ImVec2 center = ImVec2(label_min.x + icon_size * 0.5f, label_min.y + icon_size * 0.5f);
 		const float half = icon_size * 0.5f;
@@ -931,7 +1152,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 		}
 	} else if (showIcons && isShiftKey) {
 		// Draw Shift icon
-		const float icon_size = ImGui::GetFontSize() * 0.8f;
+		const float icon_size = GetDrawSource()->FontSize * 0.8f;
 		ImU32 icon_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 		ImVec2 center = ImVec2(label_min.x + icon_size * 0.5f, label_min.y + icon_size * 0.5f);
 		const float half = icon_size * 0.5f;
@@ -945,7 +1166,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 								 ImVec2(center.x + thickness, center.y + half), icon_color);
 	} else if (showIcons && isTabKey) {
 		// Draw Tab icon (arrow pointing right with vertical bar)
-		const float icon_size = ImGui::GetFontSize() * 0.8f;
+		const float icon_size = GetDrawSource()->FontSize * 0.8f;
 		ImU32 icon_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 		ImVec2 center = ImVec2(label_min.x + icon_size * 0.5f, label_min.y + icon_size * 0.5f);
 		const float half = icon_size * 0.5f;
@@ -963,7 +1184,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 								 ImVec2(center.x + half, center.y + half * 0.5f), icon_color);
 	} else if (showIcons && isCapsLockKey) {
 		// Draw Caps Lock icon (upward arrow with horizontal bar underneath)
-		const float icon_size = ImGui::GetFontSize() * 0.8f;
+		const float icon_size = GetDrawSource()->FontSize * 0.8f;
 		ImU32 icon_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 		ImVec2 center = ImVec2(label_min.x + icon_size * 0.5f, label_min.y + icon_size * 0.5f);
 		const float half = icon_size * 0.5f;
@@ -981,7 +1202,7 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 								 ImVec2(center.x + half * 0.5f, center.y + half * 0.8f), icon_color);
 	} else if (showIcons && isEnterKey) {
 		// Draw Enter icon
-		const float icon_size = ImGui::GetFontSize() * 0.8f;
+		const float icon_size = GetDrawSource()->FontSize * 0.8f;
 		ImU32 icon_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 		ImVec2 start = ImVec2(label_min.x, label_min.y);
 		const float thickness = icon_size * 0.12f;
@@ -997,114 +1218,457 @@ static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2
 			ImVec2(start.x, start.y + icon_size * 0.5f - thickness * 0.5f),
 			ImVec2(start.x + icon_size * 0.25f, start.y + icon_size * 0.5f - icon_size * 0.25f),
 			ImVec2(start.x + icon_size * 0.25f, start.y + icon_size * 0.5f + icon_size * 0.15f), icon_color);
-	} else if ((flags & ImGuiKeyboardFlags_ShowBothLabels) && shiftLabel) {
-		// Show both labels: shift label on top, normal label below
-		const float lineHeight = ImGui::GetFontSize();
-		draw_list->AddText(label_min, GetColorU32(ImGuiKeyboardCol_KeyLabel), shiftLabel);
-		ImVec2 lower_label_min = ImVec2(label_min.x, label_min.y + lineHeight);
-		draw_list->AddText(lower_label_min, GetColorU32(ImGuiKeyboardCol_KeyLabel), label);
-	} else {
-		// Select label based on shift state (unless NoShiftLabels flag is set)
-		const bool shiftPressed = !(flags & ImGuiKeyboardFlags_NoShiftLabels) &&
-								  (ImGui::IsKeyDown(ImGuiKey_LeftShift) || ImGui::IsKeyDown(ImGuiKey_RightShift));
-		const char *displayLabel = (shiftPressed && shiftLabel) ? shiftLabel : label;
-		draw_list->AddText(label_min, GetColorU32(ImGuiKeyboardCol_KeyLabel), displayLabel);
+	} else
+#endif // IMKEYBOARD_DISABLE_ICONS
+	{
+		const char *lines[2];
+		const int line_count = GetKeyLabelLines(label, shiftLabel, flags, lines);
+		const float lineHeight = GetDrawSource()->FontSize;
+		for (int i = 0; i < line_count; i++) {
+			AddKeyText(draw_list, ImVec2(label_min.x, label_min.y + i * lineHeight), lines[i]);
+		}
 	}
+}
 
-	// Highlight if pressed (red) or explicitly highlighted (green) or recorded (blue)
-	const bool isPressed = (flags & ImGuiKeyboardFlags_ShowPressed) && key != ImGuiKey_None && ImGui::IsKeyDown(key);
-	const bool isHighlighted = key != ImGuiKey_None && IsKeyHighlighted(key);
-	const bool isRecorded = (flags & ImGuiKeyboardFlags_Recordable) && key != ImGuiKey_None && IsKeyRecorded(key);
-	if (isPressed && isHighlighted) {
-		draw_list->AddRectFilled(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyPressedHighlighted), key_rounding);
-	} else if (isPressed) {
-		draw_list->AddRectFilled(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyPressed), key_rounding);
-	} else if (isHighlighted) {
-		draw_list->AddRectFilled(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyHighlighted), key_rounding);
-	} else if (isRecorded) {
-		draw_list->AddRectFilled(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyRecorded), key_rounding);
+#if !defined(IMKEYBOARD_DISABLE_LATENCY) || !defined(IMKEYBOARD_DISABLE_TIMING)
+static ImU64 GetTimeNs() {
+	return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+#endif
+
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+
+static void AddLatencySample(ImGuiKey key, float ms) {
+	ImVector<LatencyTrack> &tracks = GetContext()->LatencyTracks;
+	LatencyTrack *track = nullptr;
+	for (int i = 0; i < tracks.Size; i++) {
+		if (tracks[i].Key == key) {
+			track = &tracks[i];
+			break;
+		}
+	}
+	if (track == nullptr) {
+		tracks.resize(tracks.Size + 1);
+		track = &tracks.back();
+		track->Key = key;
+		track->Count = track->Head = 0;
 	}
+	track->Samples[track->Head] = ms;
+	track->Head = (track->Head + 1) % IMKEYBOARD_LATENCY_SAMPLES;
+	track->Count = ImMin(track->Count + 1, IMKEYBOARD_LATENCY_SAMPLES);
 }
 
-// Render ISO L-shaped Enter key as a polygon
-// The ISO Enter key spans row1 and row2 with an L shape:
-//   +--------+
-//   |  Enter |  <- row1: wider top part
-//   +--+     |
-//      |     |  <- row2: narrower bottom part (right-aligned with top)
-//      +-----+
-static void RenderISOEnterKey(ImDrawList *draw_list, const ImVec2 &row1_pos, const ImVec2 &row2_pos,
-							  float key_unit, float scale, ImGuiKeyboardFlags flags) {
-	const ImGuiKeyboardStyle &style = GetStyle();
-	const float key_rounding = style.KeyRounding * scale;
-	const float border_size = style.KeyBorderSize * scale;
+// Called by the renderer when it reaches the command after the pressed overlay
+static void LatencyCallback(const ImDrawList *parent_list, const ImDrawCmd *cmd) {
+	IM_UNUSED(parent_list);
+	LatencyProbe &probe = GetContext()->Probes[(int)(intptr_t)cmd->UserCallbackData];
+	if (probe.Key == ImGuiKey_None) {
+		return; // Draw data rendered twice
+	}
+	AddLatencySample(probe.Key, (float)((double)(GetTimeNs() - probe.PressTime) / 1000000.0));
+	probe.Key = ImGuiKey_None;
+}
 
-	// ISO Enter key position: right edge aligns at 15 units (standard keyboard width)
-	// Top part (row1): starts at 13.5 (after ] key), width 1.5, ends at 15.0
-	// Bottom part (row2): starts at 13.75 (after # key), width 1.25, ends at 15.0
-	const float right_edge = 15.0f;
-	const float top_start = 13.5f;
-	const float bottom_start = 13.75f;
+// Adds the draw callback for the first drawn frame of a press sent through AddKeyEvent()
+static void ProbeLatency(ImDrawList *draw_list, ImGuiKey key) {
+	if (!ImGui::IsNamedKey(key)) {
+		return;
+	}
+	KeyboardContext *ctx = GetContext();
+	ImU64 &press_time = ctx->PressTimes[key - ImGuiKey_NamedKey_BEGIN];
+	if (press_time == 0) {
+		return;
+	}
+	const int slot = ctx->ProbeHead;
+	ctx->ProbeHead = (ctx->ProbeHead + 1) % IMKEYBOARD_LATENCY_PROBES;
+	ctx->Probes[slot].Key = key;
+	ctx->Probes[slot].PressTime = press_time;
+	press_time = 0;
+	draw_list->AddCallback(LatencyCallback, (void *)(intptr_t)slot);
+}
 
-	// Key outer bounds (with border offset)
-	float key_top = row1_pos.y + border_size;
-	float key_row1_bottom = row1_pos.y + key_unit - border_size;
-	float key_bottom = row2_pos.y + key_unit - border_size;
-	float key_left_top = row1_pos.x + top_start * key_unit + border_size;       // Left edge of top part
-	float key_left_bottom = row2_pos.x + bottom_start * key_unit + border_size; // Left edge of bottom part (step)
-	float key_right = row1_pos.x + right_edge * key_unit - border_size;         // Right edge (aligned)
+static int IMGUI_CDECL CompareLatencySamples(const void *lhs, const void *rhs) {
+	const float a = *(const float *)lhs;
+	const float b = *(const float *)rhs;
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+#endif // IMKEYBOARD_DISABLE_LATENCY
 
-	// Draw the L-shape as two overlapping filled rectangles
-	ImU32 bg_color = GetColorU32(ImGuiKeyboardCol_KeyBackground);
-	ImU32 border_color = GetColorU32(ImGuiKeyboardCol_KeyBorder);
+#ifndef IMKEYBOARD_DISABLE_TIMING
+// Histogram bucket of a duration: exact below 4 us, then 4 buckets per power of two
+static int GetTimingBucket(ImU64 us) {
+	if (us < 4) {
+		return (int)us;
+	}
+	if (us >= (1u << 25)) {
+		return IMKEYBOARD_TIMING_BUCKETS - 1;
+	}
+	const int e = FindHighestBit((ImU32)us);
+	return (e - 1) * 4 + (int)((us >> (e - 2)) & 3);
+}
 
-	// Draw main vertical rectangle (right side, full height)
-	draw_list->AddRectFilled(ImVec2(key_left_bottom, key_top), ImVec2(key_right, key_bottom), bg_color, key_rounding);
-	// Draw top-left extension (the wider top part)
-	draw_list->AddRectFilled(ImVec2(key_left_top, key_top), ImVec2(key_left_bottom, key_row1_bottom), bg_color, key_rounding);
+// Middle of a bucket in milliseconds
+static float GetTimingBucketValue(int bucket) {
+	if (bucket < 4) {
+		return (float)bucket / 1000.0f;
+	}
+	const int e = bucket / 4 + 1;
+	const float width = (float)(1u << (e - 2));
+	return ((float)(4 + (bucket & 3)) * width + width * 0.5f) / 1000.0f;
+}
 
-	// Draw the L-shape border using line segments (clockwise from top-left)
-	// 1. Top edge (full width of top part)
-	draw_list->AddLine(ImVec2(key_left_top, key_top), ImVec2(key_right, key_top), border_color);
-	// 2. Right edge (full height)
-	draw_list->AddLine(ImVec2(key_right, key_top), ImVec2(key_right, key_bottom), border_color);
-	// 3. Bottom edge (width of bottom part)
-	draw_list->AddLine(ImVec2(key_right, key_bottom), ImVec2(key_left_bottom, key_bottom), border_color);
-	// 4. Left edge of bottom part (going up to step)
-	draw_list->AddLine(ImVec2(key_left_bottom, key_bottom), ImVec2(key_left_bottom, key_row1_bottom), border_color);
-	// 5. Step edge (horizontal, going left)
-	draw_list->AddLine(ImVec2(key_left_bottom, key_row1_bottom), ImVec2(key_left_top, key_row1_bottom), border_color);
-	// 6. Left edge of top part (going up to close)
-	draw_list->AddLine(ImVec2(key_left_top, key_row1_bottom), ImVec2(key_left_top, key_top), border_color);
+// Nearest-rank percentile of a histogram with count samples
+static float GetTimingPercentile(const ImU32 *buckets, ImU32 count, int percent) {
+	const ImU64 rank = ImMax(((ImU64)count * percent + 99) / 100, (ImU64)1);
+	ImU64 seen = 0;
+	for (int i = 0; i < IMKEYBOARD_TIMING_BUCKETS; i++) {
+		seen += buckets[i];
+		if (seen >= rank) {
+			return GetTimingBucketValue(i);
+		}
+	}
+	return 0.0f;
+}
 
-	// Key face (inner raised area)
-	const ImVec2 face_offset(style.KeyFaceOffset.x * scale, style.KeyFaceOffset.y * scale);
-	ImU32 face_color = GetColorU32(ImGuiKeyboardCol_KeyFace);
+static void AddKeyTiming(KeyTiming *timing, bool down, ImU64 time, ImU64 chatter_window) {
+	if (down == timing->Down) {
+		return; // Key repeat, or a release of a press from before the analyzer was enabled
+	}
+	timing->Down = down;
+	if (down) {
+		if (timing->PressCount > 0) {
+			const ImU64 interval = time - timing->PressTime;
+			timing->IntervalBuckets[GetTimingBucket(interval / 1000)]++;
+			if (interval < chatter_window) {
+				timing->ChatterCount++;
+			}
+		}
+		timing->PressTime = time;
+		timing->PressCount++;
+	} else {
+		timing->HoldBuckets[GetTimingBucket((time - timing->PressTime) / 1000)]++;
+	}
+}
+#endif // IMKEYBOARD_DISABLE_TIMING
+
+void AddKeyEvent(ImGuiKey key, bool down) {
+#if !defined(IMKEYBOARD_DISABLE_LATENCY) || !defined(IMKEYBOARD_DISABLE_TIMING)
+	if (ImGui::IsNamedKey(key)) {
+		KeyboardContext *ctx = GetContext();
+		const int index = key - ImGuiKey_NamedKey_BEGIN;
+		const ImU64 time = GetTimeNs();
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+		bool &was_down = ctx->KeyEventDown[index];
+		if (down && !was_down) {
+			// Replaces the time of a press that was never drawn (e.g. the keyboard was hidden)
+			ctx->PressTimes[index] = time;
+		}
+		was_down = down;
+#endif
+#ifndef IMKEYBOARD_DISABLE_TIMING
+		if (!ctx->KeyTimings.empty()) {
+			AddKeyTiming(&ctx->KeyTimings[index], down, time, ctx->ChatterWindow);
+		}
+#endif
+	}
+#endif
+	ImGui::GetIO().AddKeyEvent(key, down);
+}
 
-	float face_top = key_top + face_offset.y;
-	float face_row1_bottom = key_row1_bottom - face_offset.y;
-	float face_bottom = key_bottom - face_offset.y;
-	float face_left_top = key_left_top + face_offset.x;
-	float face_left_bottom = key_left_bottom + face_offset.x;
-	float face_right = key_right - face_offset.x;
+bool GetKeyLatency(ImGuiKey key, ImGuiKeyboardLatency *out_latency) {
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+	KeyboardContext *ctx = GetContext();
+	ImVector<float> &samples = ctx->LatencyScratch;
+	samples.resize(0);
+	for (int i = 0; i < ctx->LatencyTracks.Size; i++) {
+		const LatencyTrack &track = ctx->LatencyTracks[i];
+		if (key == ImGuiKey_None || track.Key == key) {
+			const int offset = samples.Size;
+			samples.resize(offset + track.Count);
+			memcpy(samples.Data + offset, track.Samples, (size_t)track.Count * sizeof(float));
+		}
+	}
+	if (samples.empty()) {
+		return false;
+	}
+	ImQsort(samples.Data, (size_t)samples.Size, sizeof(float), CompareLatencySamples);
+	// Nearest-rank percentiles
+	const int n = samples.Size;
+	out_latency->Count = n;
+	out_latency->P50 = samples[ImMax((n * 50 + 99) / 100 - 1, 0)];
+	out_latency->P95 = samples[ImMax((n * 95 + 99) / 100 - 1, 0)];
+	out_latency->P99 = samples[ImMax((n * 99 + 99) / 100 - 1, 0)];
+	return true;
+#else
+	IM_UNUSED(key);
+	IM_UNUSED(out_latency);
+	return false;
+#endif
+}
 
-	// Draw face as two rectangles
-	draw_list->AddRectFilled(ImVec2(face_left_bottom, face_top), ImVec2(face_right, face_bottom), face_color);
-	draw_list->AddRectFilled(ImVec2(face_left_top, face_top), ImVec2(face_left_bottom, face_row1_bottom), face_color);
+void ClearLatency() {
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+	GetContext()->LatencyTracks.clear();
+#endif
+}
 
-	// Label "Enter" - position in top part of the L-shape
-	float top_center_x = (key_left_top + key_right) * 0.5f;
-	float top_center_y = (key_top + key_row1_bottom) * 0.5f;
+void ProcessLatencyCallbacks(const ImDrawData *draw_data) {
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+	for (int n = 0; n < draw_data->CmdListsCount; n++) {
+		const ImDrawList *draw_list = draw_data->CmdLists[n];
+		for (int i = 0; i < draw_list->CmdBuffer.Size; i++) {
+			const ImDrawCmd *cmd = &draw_list->CmdBuffer[i];
+			if (cmd->UserCallback == LatencyCallback) {
+				cmd->UserCallback(draw_list, cmd);
+			}
+		}
+	}
+#else
+	IM_UNUSED(draw_data);
+#endif
+}
+
+void EnableKeyTiming(bool enable, float chatter_window_ms) {
+#ifndef IMKEYBOARD_DISABLE_TIMING
+	KeyboardContext *ctx = GetContext();
+	ctx->ChatterWindow = (ImU64)(chatter_window_ms * 1000000.0f);
+	if (!enable) {
+		ctx->KeyTimings.clear();
+	} else if (ctx->KeyTimings.empty()) {
+		ctx->KeyTimings.resize(ImGuiKey_NamedKey_COUNT);
+		ClearKeyTiming();
+	}
+#else
+	IM_UNUSED(enable);
+	IM_UNUSED(chatter_window_ms);
+#endif
+}
+
+bool GetKeyTiming(ImGuiKey key, ImGuiKeyboardKeyTiming *out_timing) {
+#ifndef IMKEYBOARD_DISABLE_TIMING
+	const KeyboardContext *ctx = GetContext();
+	if (ctx->KeyTimings.empty() || !ImGui::IsNamedKey(key)) {
+		return false;
+	}
+	const KeyTiming &timing = ctx->KeyTimings[key - ImGuiKey_NamedKey_BEGIN];
+	if (timing.PressCount == 0) {
+		return false;
+	}
+	// Releases and intervals are counted from the presses, so the histograms don't need their own totals
+	const ImU32 hold_count = (ImU32)timing.PressCount - (timing.Down ? 1 : 0);
+	const ImU32 interval_count = (ImU32)timing.PressCount - 1;
+	out_timing->PressCount = timing.PressCount;
+	out_timing->ChatterCount = timing.ChatterCount;
+	out_timing->HoldP50 = GetTimingPercentile(timing.HoldBuckets, hold_count, 50);
+	out_timing->HoldP99 = GetTimingPercentile(timing.HoldBuckets, hold_count, 99);
+	out_timing->IntervalP50 = GetTimingPercentile(timing.IntervalBuckets, interval_count, 50);
+	out_timing->IntervalP99 = GetTimingPercentile(timing.IntervalBuckets, interval_count, 99);
+	return true;
+#else
+	IM_UNUSED(key);
+	IM_UNUSED(out_timing);
+	return false;
+#endif
+}
+
+void ClearKeyTiming() {
+#ifndef IMKEYBOARD_DISABLE_TIMING
+	ImVector<KeyTiming> &timings = GetContext()->KeyTimings;
+	if (!timings.empty()) {
+		memset(timings.Data, 0, sizeof(KeyTiming) * timings.Size);
+	}
+#endif
+}
+
+// Overlay colors of a key, bottom to top, 0 where there is none: the highlight, layer or recorded color, then the
+// press. A fading press shows what is under it, a full one hides it. Returns whether the key is shown pressed.
+static bool GetKeyOverlayColors(ImGuiKey key, ImGuiKeyboardFlags flags, ImU32 out_colors[2]) {
+	// Highlight if pressed (red) or explicitly highlighted (green) or recorded (blue)
+	const bool showPressed = (flags & ImGuiKeyboardFlags_ShowPressed) && key != ImGuiKey_None;
+	const int press_alpha = showPressed ? GetKeyPressAlpha(key) : 0;
+	const bool isPressed = press_alpha != 0;
+	const bool isHighlighted = key != ImGuiKey_None && IsKeyShownHighlighted(key);
+	const ImU32 layer_color = GetKeyLayerColor(key);
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	const bool isRecorded = (flags & ImGuiKeyboardFlags_Recordable) && key != ImGuiKey_None && IsKeyShownRecorded(key);
+#else
+	const bool isRecorded = false;
+#endif
+	out_colors[0] = 0;
+	out_colors[1] = 0;
+	if (isHighlighted) {
+		out_colors[0] = GetColorU32(ImGuiKeyboardCol_KeyHighlighted);
+	} else if (layer_color != 0) {
+		out_colors[0] = layer_color;
+	} else if (isRecorded) {
+		out_colors[0] = GetColorU32(ImGuiKeyboardCol_KeyRecorded);
+	}
+	if (isPressed) {
+		if (press_alpha == 255) {
+			out_colors[0] = 0;
+		}
+		const ImGuiKeyboardCol pressed_col = isHighlighted || layer_color != 0 ? ImGuiKeyboardCol_KeyPressedHighlighted
+																			   : ImGuiKeyboardCol_KeyPressed;
+		out_colors[1] = ScaleAlpha(GetColorU32(pressed_col), press_alpha);
+	}
+	return isPressed;
+}
+
+// Pressed/highlighted/recorded overlay of a key
+static void RenderKeyOverlay(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2 &key_max, ImGuiKey key,
+							 float key_rounding, ImGuiKeyboardFlags flags) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::KeyOverlay");
+	ImU32 overlay_colors[2];
+	const bool isPressed = GetKeyOverlayColors(key, flags, overlay_colors);
+	for (int i = 0; i < 2; i++) {
+		if (overlay_colors[i] != 0) {
+			draw_list->AddRectFilled(key_min, key_max, overlay_colors[i], key_rounding);
+		}
+	}
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+	if (isPressed && (flags & ImGuiKeyboardFlags_MeasureLatency)) {
+		ProbeLatency(draw_list, key);
+	}
+#else
+	IM_UNUSED(isPressed);
+#endif
+}
+
+// Draws a key, without its background, border and face when RenderKeyBodies() already wrote them
+static void RenderKey(ImDrawList *draw_list, const ImVec2 &key_min, const ImVec2 &key_size, const char *label,
+					  const char *shiftLabel, ImGuiKey key, float scale, ImGuiKeyboardFlags flags, bool draw_body) {
+	const ImGuiKeyboardStyle &style = *GetDrawSource()->Style;
+	const float key_rounding = style.KeyRounding * scale;
+	const float key_face_rounding = style.KeyFaceRounding * scale;
+	const ImVec2 key_face_pos(style.KeyFaceOffset.x * scale, style.KeyFaceOffset.y * scale);
+	const ImVec2 key_label_pos(style.KeyLabelOffset.x * scale, style.KeyLabelOffset.y * scale);
+
+	ImVec2 key_max = ImVec2(key_min.x + key_size.x, key_min.y + key_size.y);
+	ImVec2 key_face_size =
+		ImVec2(key_size.x - style.KeyFaceOffset.x * 2.0f * scale, key_size.y - style.KeyFaceOffset.y * 2.0f * scale);
+
+	ImVec2 face_min = ImVec2(key_min.x + key_face_pos.x, key_min.y + key_face_pos.y);
+	ImVec2 face_max = ImVec2(face_min.x + key_face_size.x, face_min.y + key_face_size.y);
+	if (draw_body) {
+		// Key background
+		draw_list->AddRectFilled(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyBackground), key_rounding);
+		draw_list->AddRect(key_min, key_max, GetColorU32(ImGuiKeyboardCol_KeyBorder), key_rounding);
+
+		// Key face
+		draw_list->AddRect(face_min, face_max, GetColorU32(ImGuiKeyboardCol_KeyFaceBorder), key_face_rounding,
+						   ImDrawFlags_None, style.KeyFaceBorderSize);
+		draw_list->AddRectFilled(face_min, face_max, GetKeyFaceColor(key), key_face_rounding);
+	}
+
+	// Label rendering
+	ImVec2 label_min = ImVec2(key_min.x + key_label_pos.x, key_min.y + key_label_pos.y);
+	RenderKeyLabel(draw_list, face_min, face_max, label_min, label, shiftLabel, key, flags);
+	RenderKeyCount(draw_list, face_max, key);
+
+	RenderKeyOverlay(draw_list, key_min, key_max, key, key_rounding, flags);
+}
+
+#ifndef IMKEYBOARD_DISABLE_ISO
+// Outer edges of the ISO Enter key
+struct ISOEnterShape {
+	float Top, Row1Bottom, Bottom;
+	float LeftTop, LeftBottom; // Left edges of the top part and of the bottom part (step)
+	float Right;
+};
+
+static ISOEnterShape CalcISOEnterShape(const ImVec2 &row1_pos, const ImVec2 &row2_pos, float key_unit,
+									   float border_size) {
+	// ISO Enter key position: right edge aligns at 15 units (standard keyboard width)
+	// Top part (row1): starts at 13.5 (after ] key), width 1.5, ends at 15.0
+	// Bottom part (row2): starts at 13.75 (after # key), width 1.25, ends at 15.0
+	const float right_edge = 15.0f;
+	const float top_start = 13.5f;
+	const float bottom_start = 13.75f;
+
+	// Key outer bounds (with border offset)
+	ISOEnterShape shape;
+	shape.Top = row1_pos.y + border_size;
+	shape.Row1Bottom = row1_pos.y + key_unit - border_size;
+	shape.Bottom = row2_pos.y + key_unit - border_size;
+	shape.LeftTop = row1_pos.x + top_start * key_unit + border_size;
+	shape.LeftBottom = row2_pos.x + bottom_start * key_unit + border_size;
+	shape.Right = row1_pos.x + right_edge * key_unit - border_size;
+	return shape;
+}
+
+// Render ISO L-shaped Enter key as a polygon
+// The ISO Enter key spans row1 and row2 with an L shape:
+//   +--------+
+//   |  Enter |  <- row1: wider top part
+//   +--+     |
+//      |     |  <- row2: narrower bottom part (right-aligned with top)
+//      +-----+
+static void RenderISOEnterKey(ImDrawList *draw_list, const ImVec2 &row1_pos, const ImVec2 &row2_pos,
+							  float key_unit, float scale, ImGuiKeyboardFlags flags) {
+	const ImGuiKeyboardStyle &style = *GetDrawSource()->Style;
+	const float key_rounding = style.KeyRounding * scale;
+	const ISOEnterShape shape = CalcISOEnterShape(row1_pos, row2_pos, key_unit, style.KeyBorderSize * scale);
+	const float key_top = shape.Top;
+	const float key_row1_bottom = shape.Row1Bottom;
+	const float key_bottom = shape.Bottom;
+	const float key_left_top = shape.LeftTop;
+	const float key_left_bottom = shape.LeftBottom;
+	const float key_right = shape.Right;
+
+	// Draw the L-shape as two overlapping filled rectangles
+	ImU32 bg_color = GetColorU32(ImGuiKeyboardCol_KeyBackground);
+	ImU32 border_color = GetColorU32(ImGuiKeyboardCol_KeyBorder);
+
+	// Draw main vertical rectangle (right side, full height)
+	draw_list->AddRectFilled(ImVec2(key_left_bottom, key_top), ImVec2(key_right, key_bottom), bg_color, key_rounding);
+	// Draw top-left extension (the wider top part)
+	draw_list->AddRectFilled(ImVec2(key_left_top, key_top), ImVec2(key_left_bottom, key_row1_bottom), bg_color, key_rounding);
+
+	// Draw the L-shape border using line segments (clockwise from top-left)
+	// 1. Top edge (full width of top part)
+	draw_list->AddLine(ImVec2(key_left_top, key_top), ImVec2(key_right, key_top), border_color);
+	// 2. Right edge (full height)
+	draw_list->AddLine(ImVec2(key_right, key_top), ImVec2(key_right, key_bottom), border_color);
+	// 3. Bottom edge (width of bottom part)
+	draw_list->AddLine(ImVec2(key_right, key_bottom), ImVec2(key_left_bottom, key_bottom), border_color);
+	// 4. Left edge of bottom part (going up to step)
+	draw_list->AddLine(ImVec2(key_left_bottom, key_bottom), ImVec2(key_left_bottom, key_row1_bottom), border_color);
+	// 5. Step edge (horizontal, going left)
+	draw_list->AddLine(ImVec2(key_left_bottom, key_row1_bottom), ImVec2(key_left_top, key_row1_bottom), border_color);
+	// 6. Left edge of top part (going up to close)
+	draw_list->AddLine(ImVec2(key_left_top, key_row1_bottom), ImVec2(key_left_top, key_top), border_color);
+
+	// Key face (inner raised area)
+	const ImVec2 face_offset(style.KeyFaceOffset.x * scale, style.KeyFaceOffset.y * scale);
+	ImU32 face_color = GetKeyFaceColor(ImGuiKey_Enter);
+
+	float face_top = key_top + face_offset.y;
+	float face_row1_bottom = key_row1_bottom - face_offset.y;
+	float face_bottom = key_bottom - face_offset.y;
+	float face_left_top = key_left_top + face_offset.x;
+	float face_left_bottom = key_left_bottom + face_offset.x;
+	float face_right = key_right - face_offset.x;
+
+	// Draw face as two rectangles
+	draw_list->AddRectFilled(ImVec2(face_left_bottom, face_top), ImVec2(face_right, face_bottom), face_color);
+	draw_list->AddRectFilled(ImVec2(face_left_top, face_top), ImVec2(face_left_bottom, face_row1_bottom), face_color);
+
+	// Label "Enter" - position in top part of the L-shape
+	float top_center_x = (key_left_top + key_right) * 0.5f;
+	float top_center_y = (key_top + key_row1_bottom) * 0.5f;
 	const char *label = "Enter";
-	ImVec2 text_size = ImGui::CalcTextSize(label);
+	ImVec2 text_size = CalcKeyTextSize(label);
 	ImVec2 label_pos(top_center_x - text_size.x * 0.5f, top_center_y - text_size.y * 0.5f);
-	draw_list->AddText(label_pos, GetColorU32(ImGuiKeyboardCol_KeyLabel), label);
+	AddKeyText(draw_list, label_pos, label);
+	RenderKeyCount(draw_list, ImVec2(face_right, face_bottom), ImGuiKey_Enter);
 
 	// Draw Enter arrow icon (↵) in the bottom part of the L-shape
 	ImU32 icon_color = GetColorU32(ImGuiKeyboardCol_KeyLabel);
 	float bottom_center_x = (key_left_bottom + key_right) * 0.5f;
 	float bottom_center_y = (key_row1_bottom + key_bottom) * 0.5f;
-	float icon_size = ImGui::GetFontSize() * 0.6f;
+	float icon_size = GetDrawSource()->FontSize * 0.6f;
 
 	// Draw the bent arrow: vertical line going up, then horizontal line going left with arrowhead
 	// Arrow shape: |
@@ -1127,196 +1691,1200 @@ static void RenderISOEnterKey(ImDrawList *draw_list, const ImVec2 &row1_pos, con
 		ImVec2(arrow_left + arrow_head_size, arrow_bend_y + arrow_head_size),
 		icon_color);
 
-	// Highlight overlay if pressed/highlighted/recorded
-	const bool isPressed = (flags & ImGuiKeyboardFlags_ShowPressed) && ImGui::IsKeyDown(ImGuiKey_Enter);
-	const bool isHighlighted = IsKeyHighlighted(ImGuiKey_Enter);
-	const bool isRecorded = (flags & ImGuiKeyboardFlags_Recordable) && IsKeyRecorded(ImGuiKey_Enter);
-
-	ImU32 highlight_color = 0;
-	if (isPressed && isHighlighted) {
-		highlight_color = GetColorU32(ImGuiKeyboardCol_KeyPressedHighlighted);
-	} else if (isPressed) {
-		highlight_color = GetColorU32(ImGuiKeyboardCol_KeyPressed);
-	} else if (isHighlighted) {
-		highlight_color = GetColorU32(ImGuiKeyboardCol_KeyHighlighted);
-	} else if (isRecorded) {
-		highlight_color = GetColorU32(ImGuiKeyboardCol_KeyRecorded);
-	}
+	// Highlight overlay if pressed/highlighted/recorded
+	ImU32 highlight_colors[2];
+	const bool isPressed = GetKeyOverlayColors(ImGuiKey_Enter, flags, highlight_colors);
+	for (int i = 0; i < 2; i++) {
+		const ImU32 highlight_color = highlight_colors[i];
+		if (highlight_color != 0) {
+			draw_list->AddRectFilled(ImVec2(key_left_bottom, key_top), ImVec2(key_right, key_bottom), highlight_color,
+									 key_rounding);
+			draw_list->AddRectFilled(ImVec2(key_left_top, key_top), ImVec2(key_left_bottom, key_row1_bottom),
+									 highlight_color, key_rounding);
+		}
+	}
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+	if (isPressed && (flags & ImGuiKeyboardFlags_MeasureLatency)) {
+		ProbeLatency(draw_list, ImGuiKey_Enter);
+	}
+#else
+	IM_UNUSED(isPressed);
+#endif
+}
+
+#endif // IMKEYBOARD_DISABLE_ISO
+
+static void RenderKeyRow(ImDrawList *draw_list, const KeyLayoutData *keys, int key_count, const ImVec2 &start_pos,
+						 float key_unit, float scale, ImGuiKeyboardFlags flags, bool draw_bodies) {
+	const ImGuiKeyboardStyle &style = *GetDrawSource()->Style;
+	const float border_size = style.KeyBorderSize * scale;
+	for (int i = 0; i < key_count; i++) {
+		const KeyLayoutData *key = &keys[i];
+		ImVec2 key_min =
+			ImVec2(start_pos.x + key->X * key_unit + border_size, start_pos.y + key->Y * key_unit + border_size);
+		ImVec2 key_size =
+			ImVec2(key->Width * key_unit - 2.0f * border_size, key->Height * key_unit - 2.0f * border_size);
+		RenderKey(draw_list, key_min, key_size, key->Label, key->ShiftLabel, key->Key, scale, flags, draw_bodies);
+	}
+}
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+static void Record(ImGuiKey key, bool record) {
+	KeyboardContext *ctx = GetContext();
+	if (record) {
+		// Add key if not already present
+		if (!IsKeyRecorded(key)) {
+			ctx->RecordedKeys.push_back(key);
+		}
+	} else {
+		// Remove key if present
+		for (int i = 0; i < ctx->RecordedKeys.Size; i++) {
+			if (ctx->RecordedKeys[i] == key) {
+				ctx->RecordedKeys.erase(&ctx->RecordedKeys[i]);
+				break;
+			}
+		}
+	}
+}
+#endif // IMKEYBOARD_DISABLE_RECORDING
+
+void Highlight(ImGuiKey key, bool highlight) {
+	IM_ASSERT(ImGui::IsNamedKey(key));
+	KeyboardContext *ctx = GetContext();
+	ImU8 &bits = ctx->KeyHighlights[key - ImGuiKey_NamedKey_BEGIN];
+	if (highlight) {
+		bits |= KeyHighlight_Key;
+	} else {
+		bits &= ~KeyHighlight_Key;
+	}
+}
+
+static void ClearTextKeys(KeyboardContext *ctx) {
+	for (int i = 0; i < ctx->TextKeys.Size; i++) {
+		ctx->KeyHighlights[ctx->TextKeys[i] - ImGuiKey_NamedKey_BEGIN] &= ~KeyHighlight_Text;
+	}
+	ctx->TextKeys.clear();
+}
+
+void ClearHighlights() {
+	KeyboardContext *ctx = GetContext();
+	ctx->HighlightedText.clear();
+	ctx->TextKeys.clear();
+	memset(ctx->KeyHighlights, 0, sizeof(ctx->KeyHighlights));
+}
+
+// Reassigns the bits of the used layers by priority and moves the key masks along
+static void SortHighlightLayers() {
+	KeyboardContext *ctx = GetContext();
+	int order[IMKEYBOARD_HIGHLIGHT_LAYERS];
+	int count = 0;
+	for (int layer = IMKEYBOARD_HIGHLIGHT_LAYERS - 1; layer >= 0; layer--) {
+		if (!ctx->HighlightLayers[layer].Used) {
+			continue;
+		}
+		// Insertion sort by ascending priority, lower ids end up above higher ids of the same priority
+		int i = count++;
+		while (i > 0 && ctx->HighlightLayers[order[i - 1]].Priority > ctx->HighlightLayers[layer].Priority) {
+			order[i] = order[i - 1];
+			i--;
+		}
+		order[i] = layer;
+	}
+	// Unused layers take the bits above, so LayerBits and BitLayers stay a permutation and no unused layer shares a
+	// bit with a used one
+	ImU8 new_bits[IMKEYBOARD_HIGHLIGHT_LAYERS];
+	for (int i = 0; i < count; i++) {
+		new_bits[order[i]] = (ImU8)i;
+	}
+	int unused_bit = count;
+	for (int layer = 0; layer < IMKEYBOARD_HIGHLIGHT_LAYERS; layer++) {
+		if (!ctx->HighlightLayers[layer].Used) {
+			new_bits[layer] = (ImU8)unused_bit++;
+		}
+	}
+	IM_ASSERT(unused_bit == IMKEYBOARD_HIGHLIGHT_LAYERS);
+	for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+		ImU16 old_mask = ctx->KeyLayerBits[k];
+		ImU16 new_mask = 0;
+		while (old_mask != 0) {
+			const int bit = FindHighestBit(old_mask);
+			old_mask &= (ImU16)~(1u << bit);
+			new_mask |= (ImU16)(1u << new_bits[ctx->BitLayers[bit]]);
+		}
+		ctx->KeyLayerBits[k] = new_mask;
+	}
+	ctx->ActiveLayerBits = 0;
+	for (int layer = 0; layer < IMKEYBOARD_HIGHLIGHT_LAYERS; layer++) {
+		ctx->LayerBits[layer] = new_bits[layer];
+		ctx->BitLayers[new_bits[layer]] = (ImU8)layer;
+		if (ctx->HighlightLayers[layer].Used && ctx->HighlightLayers[layer].Active) {
+			ctx->ActiveLayerBits |= (ImU16)(1u << new_bits[layer]);
+		}
+	}
+}
+
+int AddHighlightLayer(const char *name, const ImVec4 &color, int priority) {
+	KeyboardContext *ctx = GetContext();
+	for (int layer = 0; layer < IMKEYBOARD_HIGHLIGHT_LAYERS; layer++) {
+		HighlightLayer &hl = ctx->HighlightLayers[layer];
+		if (hl.Used) {
+			continue;
+		}
+		ImStrncpy(hl.Name, name != nullptr ? name : "", sizeof(hl.Name));
+		hl.Color = color;
+		hl.Priority = priority;
+		hl.Used = true;
+		hl.Active = true;
+		SortHighlightLayers();
+		ClearHighlightLayer(layer); // A reused id never inherits keys
+		return layer;
+	}
+	return -1;
+}
+
+void RemoveHighlightLayer(int layer) {
+	IM_ASSERT(layer >= 0 && layer < IMKEYBOARD_HIGHLIGHT_LAYERS);
+	KeyboardContext *ctx = GetContext();
+	ClearHighlightLayer(layer);
+	ctx->HighlightLayers[layer].Used = false;
+	SortHighlightLayers();
+}
+
+int FindHighlightLayer(const char *name) {
+	KeyboardContext *ctx = GetContext();
+	for (int layer = 0; layer < IMKEYBOARD_HIGHLIGHT_LAYERS; layer++) {
+		if (ctx->HighlightLayers[layer].Used && strcmp(ctx->HighlightLayers[layer].Name, name) == 0) {
+			return layer;
+		}
+	}
+	return -1;
+}
+
+void SetHighlightLayerColor(int layer, const ImVec4 &color) {
+	IM_ASSERT(layer >= 0 && layer < IMKEYBOARD_HIGHLIGHT_LAYERS);
+	GetContext()->HighlightLayers[layer].Color = color;
+}
+
+void SetHighlightLayerPriority(int layer, int priority) {
+	IM_ASSERT(layer >= 0 && layer < IMKEYBOARD_HIGHLIGHT_LAYERS);
+	HighlightLayer &hl = GetContext()->HighlightLayers[layer];
+	if (hl.Priority != priority) {
+		hl.Priority = priority;
+		SortHighlightLayers();
+	}
+}
+
+void SetHighlightLayerActive(int layer, bool active) {
+	IM_ASSERT(layer >= 0 && layer < IMKEYBOARD_HIGHLIGHT_LAYERS);
+	KeyboardContext *ctx = GetContext();
+	ctx->HighlightLayers[layer].Active = active;
+	const ImU16 bit = (ImU16)(1u << ctx->LayerBits[layer]);
+	if (active && ctx->HighlightLayers[layer].Used) {
+		ctx->ActiveLayerBits |= bit;
+	} else {
+		ctx->ActiveLayerBits &= (ImU16)~bit;
+	}
+}
+
+void HighlightLayerKey(int layer, ImGuiKey key, bool highlight) {
+	IM_ASSERT(layer >= 0 && layer < IMKEYBOARD_HIGHLIGHT_LAYERS);
+	KeyboardContext *ctx = GetContext();
+	IM_ASSERT(ctx->HighlightLayers[layer].Used);
+	if (!ImGui::IsNamedKey(key)) {
+		return;
+	}
+	ImU16 &mask = ctx->KeyLayerBits[key - ImGuiKey_NamedKey_BEGIN];
+	const ImU16 bit = (ImU16)(1u << ctx->LayerBits[layer]);
+	mask = highlight ? (ImU16)(mask | bit) : (ImU16)(mask & ~bit);
+}
+
+void ClearHighlightLayer(int layer) {
+	IM_ASSERT(layer >= 0 && layer < IMKEYBOARD_HIGHLIGHT_LAYERS);
+	KeyboardContext *ctx = GetContext();
+	const ImU16 keep = (ImU16)~(1u << ctx->LayerBits[layer]);
+	for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+		ctx->KeyLayerBits[k] &= keep;
+	}
+}
+
+// Layer colors by bit, for DrawSource::LayerColors
+static void GetLayerColors(ImU32 *out_colors) {
+	KeyboardContext *ctx = GetContext();
+	for (int bit = 0; bit < IMKEYBOARD_HIGHLIGHT_LAYERS; bit++) {
+		out_colors[bit] = ImGui::ColorConvertFloat4ToU32(ctx->HighlightLayers[ctx->BitLayers[bit]].Color);
+	}
+}
+
+void ClearRecorded() {
+	KeyboardContext *ctx = GetContext();
+	ctx->RecordedKeys.clear();
+}
+
+const ImVector<ImGuiKey>& GetRecordedKeys() {
+	return GetContext()->RecordedKeys;
+}
+
+// Map layouts removed in imgui_keyboard_config.h to the closest compiled one, so the row selection below never
+// sees them: ISO variants fall back to their ANSI counterpart, everything else to QWERTY (ANSI or ISO).
+static ImGuiKeyboardLayout GetCompiledLayout(ImGuiKeyboardLayout layout) {
+	switch (layout) {
+#ifdef IMKEYBOARD_DISABLE_ISO
+	case ImGuiKeyboardLayout_QwertyISO: return ImGuiKeyboardLayout_Qwerty;
+	case ImGuiKeyboardLayout_QwertzISO: return GetCompiledLayout(ImGuiKeyboardLayout_Qwertz);
+	case ImGuiKeyboardLayout_AzertyISO: return GetCompiledLayout(ImGuiKeyboardLayout_Azerty);
+	case ImGuiKeyboardLayout_AppleISO: return GetCompiledLayout(ImGuiKeyboardLayout_AppleANSI);
+#endif
+#ifdef IMKEYBOARD_DISABLE_QWERTZ
+	case ImGuiKeyboardLayout_Qwertz: return ImGuiKeyboardLayout_Qwerty;
+#ifndef IMKEYBOARD_DISABLE_ISO
+	case ImGuiKeyboardLayout_QwertzISO: return ImGuiKeyboardLayout_QwertyISO;
+#endif
+#endif
+#ifdef IMKEYBOARD_DISABLE_AZERTY
+	case ImGuiKeyboardLayout_Azerty: return ImGuiKeyboardLayout_Qwerty;
+#ifndef IMKEYBOARD_DISABLE_ISO
+	case ImGuiKeyboardLayout_AzertyISO: return ImGuiKeyboardLayout_QwertyISO;
+#endif
+#endif
+#ifdef IMKEYBOARD_DISABLE_APPLE
+	case ImGuiKeyboardLayout_AppleANSI: return ImGuiKeyboardLayout_Qwerty;
+#ifndef IMKEYBOARD_DISABLE_ISO
+	case ImGuiKeyboardLayout_AppleISO: return ImGuiKeyboardLayout_QwertyISO;
+#endif
+#endif
+#ifdef IMKEYBOARD_DISABLE_COLEMAK
+	case ImGuiKeyboardLayout_Colemak: return ImGuiKeyboardLayout_Qwerty;
+#endif
+#ifdef IMKEYBOARD_DISABLE_DVORAK
+	case ImGuiKeyboardLayout_Dvorak: return ImGuiKeyboardLayout_Qwerty;
+#endif
+	default: return layout;
+	}
+}
+
+// Single code point of a key label, 0 for multi-character labels like "Tab"
+static unsigned int GetLabelCodepoint(const char *label) {
+	if (label == nullptr || label[0] == 0) {
+		return 0;
+	}
+	unsigned int c = 0;
+	const int len = ImTextCharFromUtf8(&c, label, nullptr);
+	return label[len] == 0 ? c : 0;
+}
+
+// Lower case of an upper case ASCII or Latin-1 letter, 0 for anything else
+static unsigned int GetLowerCaseLetter(unsigned int c) {
+	if ((c >= 'A' && c <= 'Z') || (c >= 0xC0 && c <= 0xDE && c != 0xD7)) {
+		return c + 0x20;
+	}
+	return 0;
+}
+
+static void AddKeyChars(ImVector<KeyChar> &index, const KeyLayoutData *keys, int key_count) {
+	for (int i = 0; i < key_count; i++) {
+		const KeyLayoutData &key = keys[i];
+		const unsigned int c = GetLabelCodepoint(key.Label);
+		const unsigned int lower = key.ShiftLabel ? 0 : GetLowerCaseLetter(c);
+		if (lower != 0) {
+			// Letter keys are labeled upper case and type lower case without Shift
+			KeyChar lower_entry = {lower, key.Key, false, index.Size};
+			index.push_back(lower_entry);
+			KeyChar upper_entry = {c, key.Key, true, index.Size};
+			index.push_back(upper_entry);
+			continue;
+		}
+		if (c != 0) {
+			KeyChar entry = {c, key.Key, false, index.Size};
+			index.push_back(entry);
+		}
+		const unsigned int shift_c = GetLabelCodepoint(key.ShiftLabel);
+		if (shift_c != 0) {
+			KeyChar entry = {shift_c, key.Key, true, index.Size};
+			index.push_back(entry);
+		}
+	}
+}
+
+static int IMGUI_CDECL CompareKeyChars(const void *lhs, const void *rhs) {
+	const KeyChar *a = (const KeyChar *)lhs;
+	const KeyChar *b = (const KeyChar *)rhs;
+	if (a->Codepoint != b->Codepoint) {
+		return a->Codepoint < b->Codepoint ? -1 : 1;
+	}
+	return a->Order - b->Order;
+}
+
+// Reverse index of a layout from code points to keys, built from the key labels on first use
+static const ImVector<KeyChar> &GetCharIndex(ImGuiKeyboardLayout layout) {
+	ImVector<KeyChar> &index = GetContext()->CharIndex[layout];
+	if (!index.empty()) {
+		return index;
+	}
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::BuildCharIndex");
+
+	// Main rows first so that digits and operators map to them rather than to the numpad
+	if (layout != ImGuiKeyboardLayout_NumericPad) {
+		const KeyboardLayoutRows &rows = GetLayoutRows(layout);
+		for (int r = 0; r < ImGuiKeyboardRow_COUNT; r++) {
+			AddKeyChars(index, rows.Rows[r].Data, rows.Rows[r].Size);
+		}
+	}
+	AddKeyChars(index, numpad_keys, IM_ARRAYSIZE(numpad_keys));
+	const KeyChar whitespace[] = {
+		{' ', ImGuiKey_Space, false, index.Size},
+		{'\t', ImGuiKey_Tab, false, index.Size + 1},
+		{'\n', ImGuiKey_Enter, false, index.Size + 2},
+	};
+	for (int i = 0; i < IM_ARRAYSIZE(whitespace); i++) {
+		index.push_back(whitespace[i]);
+	}
+
+	// Sort and keep the first key of each code point
+	ImQsort(index.Data, (size_t)index.Size, sizeof(KeyChar), CompareKeyChars);
+	int count = 0;
+	for (int i = 0; i < index.Size; i++) {
+		if (count == 0 || index[count - 1].Codepoint != index[i].Codepoint) {
+			index[count++] = index[i];
+		}
+	}
+	index.resize(count);
+	return index;
+}
+
+bool FindKeyForChar(ImGuiKeyboardLayout layout, unsigned int codepoint, ImGuiKey *out_key, bool *out_shift) {
+	IM_ASSERT(layout >= 0 && layout < ImGuiKeyboardLayout_Count);
+	const ImVector<KeyChar> &index = GetCharIndex(GetCompiledLayout(layout));
+	int lo = 0;
+	int hi = index.Size;
+	while (lo < hi) {
+		const int mid = (lo + hi) / 2;
+		if (index[mid].Codepoint < codepoint) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (lo == index.Size || index[lo].Codepoint != codepoint) {
+		return false;
+	}
+	if (out_key) {
+		*out_key = index[lo].Key;
+	}
+	if (out_shift) {
+		*out_shift = index[lo].Shift;
+	}
+	return true;
+}
+
+void HighlightText(const char *utf8) {
+	KeyboardContext *ctx = GetContext();
+	ctx->HighlightedText.clear();
+	ClearTextKeys(ctx);
+	ctx->TextKeysLayout = -1;
+	if (utf8 == nullptr) {
+		return;
+	}
+	while (*utf8) {
+		unsigned int c = 0;
+		utf8 += ImTextCharFromUtf8(&c, utf8, nullptr);
+		ctx->HighlightedText.push_back((ImWchar32)c);
+	}
+}
+
+static void AddTextKey(KeyboardContext *ctx, ImGuiKey key) {
+	ImU8 &bits = ctx->KeyHighlights[key - ImGuiKey_NamedKey_BEGIN];
+	if ((bits & KeyHighlight_Text) == 0) {
+		bits |= KeyHighlight_Text;
+		ctx->TextKeys.push_back(key);
+	}
+}
+
+// Keys of the highlighted text on the layout being rendered
+static void ResolveTextKeys(ImGuiKeyboardLayout layout) {
+	KeyboardContext *ctx = GetContext();
+	ClearTextKeys(ctx);
+	ctx->TextKeysLayout = layout;
+	for (int i = 0; i < ctx->HighlightedText.Size; i++) {
+		ImGuiKey key = ImGuiKey_None;
+		bool shift = false;
+		if (!FindKeyForChar(layout, ctx->HighlightedText[i], &key, &shift)) {
+			continue;
+		}
+		AddTextKey(ctx, key);
+		if (shift) {
+			AddTextKey(ctx, ImGuiKey_LeftShift);
+		}
+	}
+}
+
+// Board size in pixels, including the padding
+static ImVec2 CalcBoardSize(ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags, const ImGuiKeyboardStyle &style,
+							float scale) {
+	const float key_unit = style.KeyUnit * scale;
+	const float section_gap = style.SectionGap * scale;
+	const float board_padding = style.BoardPadding * scale;
+	if (layout == ImGuiKeyboardLayout_NumericPad) {
+		// Numpad only: 4 keys wide, 5 rows
+		return ImVec2(4.0f * key_unit + board_padding * 2.0f, 5.0f * key_unit + board_padding * 2.0f);
+	}
+	// Full keyboard: main section (15 keys) + nav cluster (3 keys) + numpad (4 keys) + gaps
+	float numpad_width = (flags & ImGuiKeyboardFlags_NoNumpad) ? 0.0f : (section_gap + 4.0f * key_unit);
+	return ImVec2(15.0f * key_unit + section_gap + 3.0f * key_unit + numpad_width + board_padding * 2.0f,
+				  6.5f * key_unit + board_padding * 2.0f); // Function row + gap + 5 main rows
+}
+
+// Where the rows of a board start, shared by rendering and recording
+struct BoardRows {
+	const KeyboardLayoutRows *Layout; // nullptr for ImGuiKeyboardLayout_NumericPad
+	ImVec2 FunctionRow;
+	ImVec2 FunctionRowNav; // Print/Scroll/Pause (or F13/F14/F15 for Apple) - aligned with nav cluster
+	ImVec2 NumberRow;
+	ImVec2 Letters1;
+	ImVec2 Letters2;
+	ImVec2 Letters3;
+	ImVec2 Bottom;
+	ImVec2 NavCluster;
+	ImVec2 Numpad;
+	float KeyUnit;
+	float Scale;
+};
+
+static void CalcBoardRows(BoardRows *board, ImGuiKeyboardLayout layout, const ImVec2 &board_min,
+						  const ImGuiKeyboardStyle &style, float scale) {
+	const float key_unit = style.KeyUnit * scale;
+	const float section_gap = style.SectionGap * scale;
+	const float board_padding = style.BoardPadding * scale;
+	const ImVec2 start_pos = ImVec2(board_min.x + board_padding, board_min.y + board_padding);
+	board->KeyUnit = key_unit;
+	board->Scale = scale;
+	if (layout == ImGuiKeyboardLayout_NumericPad) {
+		board->Layout = nullptr;
+		board->Numpad = start_pos;
+		return;
+	}
+	board->Layout = &GetLayoutRows(layout);
+
+	// Navigation cluster X position (used for Print/Scroll/Pause alignment)
+	const float nav_x = start_pos.x + 15.0f * key_unit + section_gap;
+	// Main keyboard section (offset by function row + gap)
+	const float main_section_y = start_pos.y + key_unit + 0.5f * key_unit;
+
+	board->FunctionRow = start_pos;
+	board->FunctionRowNav = ImVec2(nav_x, start_pos.y);
+	board->NumberRow = ImVec2(start_pos.x, main_section_y);
+	board->Letters1 = ImVec2(start_pos.x, main_section_y + key_unit);
+	board->Letters2 = ImVec2(start_pos.x, main_section_y + 2.0f * key_unit);
+	board->Letters3 = ImVec2(start_pos.x, main_section_y + 3.0f * key_unit);
+	board->Bottom = ImVec2(start_pos.x, main_section_y + 4.0f * key_unit);
+	board->NavCluster = ImVec2(nav_x, main_section_y);
+	board->Numpad = ImVec2(nav_x + 3.0f * key_unit + section_gap, main_section_y);
+}
+
+// A row of keys and where it starts
+struct BoardKeyRow {
+	const KeyLayoutData *Keys;
+	int KeyCount;
+	ImVec2 Pos;
+};
+
+// Key rows of a board in drawing order, without the ISO Enter key
+static int GetBoardKeyRows(const BoardRows &board, ImGuiKeyboardFlags flags, BoardKeyRow *out_rows) {
+	int count = 0;
+	if (board.Layout != nullptr) {
+		const KeyboardLayoutRows &rows = *board.Layout;
+		const ImVec2 row_pos[ImGuiKeyboardRow_COUNT] = {board.FunctionRowNav, board.NumberRow, board.Letters1,
+														board.Letters2, board.Letters3, board.Bottom};
+		const BoardKeyRow function_row = {function_row_keys, IM_ARRAYSIZE(function_row_keys), board.FunctionRow};
+		out_rows[count++] = function_row;
+		for (int row = 0; row < ImGuiKeyboardRow_COUNT; row++) {
+			const BoardKeyRow layout_row = {rows.Rows[row].Data, rows.Rows[row].Size, row_pos[row]};
+			out_rows[count++] = layout_row;
+		}
+		const BoardKeyRow nav_cluster = {nav_cluster_keys, IM_ARRAYSIZE(nav_cluster_keys), board.NavCluster};
+		out_rows[count++] = nav_cluster;
+	}
+	if (board.Layout == nullptr || !(flags & ImGuiKeyboardFlags_NoNumpad)) {
+		const BoardKeyRow numpad = {numpad_keys, IM_ARRAYSIZE(numpad_keys), board.Numpad};
+		out_rows[count++] = numpad;
+	}
+	return count;
+}
+
+#ifndef IMKEYBOARD_DISABLE_KEY_MESHES
+#define IMKEYBOARD_KEY_MESH_CONTOURS 6            // Key edge, border, background, around and on the face border, face
+#define IMKEYBOARD_KEY_MESH_MAX_CORNER_SEGMENTS 8 // Per rounded corner of a contour
+
+// Per board constants of a key mesh
+struct KeyMesh {
+	ImVec2 CornerDirs[4 * (IMKEYBOARD_KEY_MESH_MAX_CORNER_SEGMENTS + 1)]; // Contour points around the corner centers
+	int CornerSegments;
+	int PointCount;								 // Per contour
+	float Offsets[IMKEYBOARD_KEY_MESH_CONTOURS]; // How far each contour lies outside its key or face rect
+	ImU32 Colors[IMKEYBOARD_KEY_MESH_CONTOURS];	 // The face color is set per key
+	ImVec2 TexUvWhitePixel;
+};
+
+// Quarter circle segments for the largest radius of a mesh, with the 0.3 px error bound of ImGui's default tessellation
+static int CalcKeyMeshCornerSegments(float radius) {
+	const float max_error = 0.3f;
+	if (radius <= max_error) {
+		return 0;
+	}
+	const int circle_segments = (int)ImCeil(IM_PI / ImAcos(1.0f - max_error / radius));
+	return ImClamp((circle_segments + 3) / 4, 1, IMKEYBOARD_KEY_MESH_MAX_CORNER_SEGMENTS);
+}
+
+// Writes a rect grown by offset with rounding grown along, clockwise from the left end of the top left corner
+static void WriteKeyContour(ImDrawList *draw_list, const KeyMesh &mesh, const ImVec2 &rect_min, const ImVec2 &rect_max,
+							float offset, float rounding, ImU32 col) {
+	const ImVec2 min(rect_min.x - offset, rect_min.y - offset);
+	const ImVec2 max(rect_max.x + offset, rect_max.y + offset);
+	const float radius = ImMax(ImMin(rounding + offset, ImMin(max.x - min.x, max.y - min.y) * 0.5f), 0.0f);
+	const ImVec2 centers[4] = {ImVec2(min.x + radius, min.y + radius), ImVec2(max.x - radius, min.y + radius),
+							   ImVec2(max.x - radius, max.y - radius), ImVec2(min.x + radius, max.y - radius)};
+	ImDrawVert *vtx = draw_list->_VtxWritePtr;
+	for (int i = 0; i < mesh.PointCount; i++) {
+		const ImVec2 &center = centers[i / (mesh.CornerSegments + 1)];
+		vtx[i].pos = ImVec2(center.x + mesh.CornerDirs[i].x * radius, center.y + mesh.CornerDirs[i].y * radius);
+		vtx[i].uv = mesh.TexUvWhitePixel;
+		vtx[i].col = col;
+	}
+	draw_list->_VtxWritePtr += mesh.PointCount;
+}
+
+// Joins each contour to the next one with a strip of quads and fills the last one as a fan
+static void WriteKeyMeshIndices(ImDrawList *draw_list, unsigned int vtx_base, int point_count) {
+	ImDrawIdx *idx = draw_list->_IdxWritePtr;
+	for (int c = 0; c + 1 < IMKEYBOARD_KEY_MESH_CONTOURS; c++) {
+		const unsigned int outer = vtx_base + c * point_count;
+		const unsigned int inner = outer + point_count;
+		for (int i = 0; i < point_count; i++) {
+			const unsigned int j = i + 1 < point_count ? i + 1 : 0;
+			idx[0] = (ImDrawIdx)(outer + i);
+			idx[1] = (ImDrawIdx)(outer + j);
+			idx[2] = (ImDrawIdx)(inner + j);
+			idx[3] = (ImDrawIdx)(outer + i);
+			idx[4] = (ImDrawIdx)(inner + j);
+			idx[5] = (ImDrawIdx)(inner + i);
+			idx += 6;
+		}
+	}
+	const unsigned int face = vtx_base + (IMKEYBOARD_KEY_MESH_CONTOURS - 1) * point_count;
+	for (int i = 1; i + 1 < point_count; i++) {
+		idx[0] = (ImDrawIdx)face;
+		idx[1] = (ImDrawIdx)(face + i);
+		idx[2] = (ImDrawIdx)(face + i + 1);
+		idx += 3;
+	}
+	draw_list->_IdxWritePtr = idx;
+}
+
+// Writes background, border, face border and face of all keys straight into the draw list, reserved once for the
+// board. Each key is a stack of rounded rect contours whose colors ramp over the anti-aliasing fringes, which looks
+// like the AddRect*() calls of RenderKey() within a fraction of a pixel. Returns false when the board doesn't fit the
+// 16-bit indices of the draw list, RenderKey() then draws the bodies itself.
+static bool RenderKeyBodies(ImDrawList *draw_list, const BoardRows &board, ImGuiKeyboardFlags flags) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::KeyBodies");
+	BoardKeyRow rows[ImGuiKeyboardRow_COUNT + 3];
+	const int row_count = GetBoardKeyRows(board, flags, rows);
+	int key_count = 0;
+	for (int i = 0; i < row_count; i++) {
+		key_count += rows[i].KeyCount;
+	}
+
+	const ImGuiKeyboardStyle &style = *GetDrawSource()->Style;
+	const float scale = board.Scale;
+	const float key_unit = board.KeyUnit;
+	const float border_size = style.KeyBorderSize * scale;
+	const float key_rounding = style.KeyRounding * scale;
+	const float face_rounding = style.KeyFaceRounding * scale;
+	const float face_border_size = style.KeyFaceBorderSize; // Not scaled, like in RenderKey()
+	const ImVec2 face_offset(style.KeyFaceOffset.x * scale, style.KeyFaceOffset.y * scale);
+	// ImGui fades anti-aliased edges in over a pixel centered on the edge, and strokes AddRect() half a pixel inside
+	const float fringe = (draw_list->Flags & ImDrawListFlags_AntiAliasedFill) ? 1.0f : 0.0f;
+
+	KeyMesh mesh;
+	mesh.Offsets[0] = 0.5f * fringe;
+	mesh.Offsets[1] = -0.5f * fringe;
+	mesh.Offsets[2] = -0.5f * fringe - 1.0f;
+	mesh.Offsets[5] = -0.5f * fringe;
+	mesh.Offsets[4] = ImMax(face_border_size * 0.5f - 0.5f - 0.5f * fringe, 0.5f * fringe);
+	mesh.Offsets[3] = ImMax(face_border_size * 0.5f - 0.5f + 0.5f * fringe, mesh.Offsets[4]);
+	// A face border wider than the space around the face stops at the key border instead of folding over it
+	const float face_space = ImMin(face_offset.x, face_offset.y) + mesh.Offsets[2];
+	mesh.Offsets[3] = ImMax(ImMin(mesh.Offsets[3], face_space), mesh.Offsets[5]);
+	mesh.Offsets[4] = ImMax(ImMin(mesh.Offsets[4], face_space), mesh.Offsets[5]);
+	const ImU32 border_col = GetColorU32(ImGuiKeyboardCol_KeyBorder);
+	const ImU32 background_col = GetColorU32(ImGuiKeyboardCol_KeyBackground);
+	mesh.Colors[0] = border_col & ~IM_COL32_A_MASK;
+	mesh.Colors[1] = border_col;
+	mesh.Colors[2] = background_col;
+	mesh.Colors[3] = background_col;
+	mesh.Colors[4] = face_border_size > 0.0f ? GetColorU32(ImGuiKeyboardCol_KeyFaceBorder) : background_col;
+	mesh.CornerSegments =
+		CalcKeyMeshCornerSegments(ImMax(key_rounding + mesh.Offsets[0], face_rounding + mesh.Offsets[3]));
+	mesh.PointCount = 4 * (mesh.CornerSegments + 1);
+	for (int i = 0; i < mesh.PointCount; i++) {
+		const int corner = i / (mesh.CornerSegments + 1);
+		const int segment = i % (mesh.CornerSegments + 1);
+		const float a = IM_PI * (1.0f + 0.5f * corner) +
+						(mesh.CornerSegments > 0 ? 0.5f * IM_PI * segment / mesh.CornerSegments : 0.0f);
+		mesh.CornerDirs[i] = ImVec2(ImCos(a), ImSin(a));
+	}
+	mesh.TexUvWhitePixel = draw_list->_Data->TexUvWhitePixel;
+
+	const int vtx_per_key = IMKEYBOARD_KEY_MESH_CONTOURS * mesh.PointCount;
+	const int vtx_count = key_count * vtx_per_key;
+	const int idx_count =
+		key_count * ((IMKEYBOARD_KEY_MESH_CONTOURS - 1) * mesh.PointCount * 6 + (mesh.PointCount - 2) * 3);
+	if (sizeof(ImDrawIdx) == 2 &&
+		(vtx_count >= (1 << 16) || (draw_list->_VtxCurrentIdx + vtx_count >= (1 << 16) &&
+									!(draw_list->Flags & ImDrawListFlags_AllowVtxOffset)))) {
+		return false;
+	}
+
+	draw_list->PrimReserve(idx_count, vtx_count);
+	for (int r = 0; r < row_count; r++) {
+		const BoardKeyRow &row = rows[r];
+		for (int i = 0; i < row.KeyCount; i++) {
+			// Same rects as RenderKeyRow() and RenderKey()
+			const KeyLayoutData &key = row.Keys[i];
+			const ImVec2 key_min(row.Pos.x + key.X * key_unit + border_size,
+								 row.Pos.y + key.Y * key_unit + border_size);
+			const ImVec2 key_size(key.Width * key_unit - 2.0f * border_size,
+								  key.Height * key_unit - 2.0f * border_size);
+			const ImVec2 key_max(key_min.x + key_size.x, key_min.y + key_size.y);
+			const ImVec2 face_min(key_min.x + face_offset.x, key_min.y + face_offset.y);
+			const ImVec2 face_max(face_min.x + (key_size.x - style.KeyFaceOffset.x * 2.0f * scale),
+								  face_min.y + (key_size.y - style.KeyFaceOffset.y * 2.0f * scale));
+			mesh.Colors[5] = GetKeyFaceColor(key.Key);
+			const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
+			for (int c = 0; c < 3; c++) {
+				WriteKeyContour(draw_list, mesh, key_min, key_max, mesh.Offsets[c], key_rounding, mesh.Colors[c]);
+			}
+			for (int c = 3; c < IMKEYBOARD_KEY_MESH_CONTOURS; c++) {
+				WriteKeyContour(draw_list, mesh, face_min, face_max, mesh.Offsets[c], face_rounding, mesh.Colors[c]);
+			}
+			WriteKeyMeshIndices(draw_list, vtx_base, mesh.PointCount);
+			draw_list->_VtxCurrentIdx += (unsigned int)vtx_per_key;
+		}
+	}
+	return true;
+}
+#endif // IMKEYBOARD_DISABLE_KEY_MESHES
+
+// Draws a board from the current DrawSource
+static void RenderBoard(ImDrawList *draw_list, const ImVec2 &board_min, const ImVec2 &board_max,
+						const BoardRows &board, ImGuiKeyboardFlags flags) {
+	const ImGuiKeyboardStyle &style = *GetDrawSource()->Style;
+	const float key_unit = board.KeyUnit;
+	const float scale = board.Scale;
+
+	// Draw board background
+	{
+		IM_INPUT_TRACE_SCOPE("ImKeyboard::Background");
+		const float board_rounding = style.BoardRounding * scale;
+		draw_list->AddRectFilled(board_min, board_max, GetColorU32(ImGuiKeyboardCol_BoardBackground), board_rounding);
+	}
+
+	draw_list->PushClipRect(board_min, board_max, true);
+
+	// Key bodies first, everything else of the keys is drawn over them
+#ifndef IMKEYBOARD_DISABLE_KEY_MESHES
+	const bool draw_bodies = !RenderKeyBodies(draw_list, board, flags);
+#else
+	const bool draw_bodies = true;
+#endif
+
+	if (board.Layout == nullptr) {
+		// Render only numpad
+		IM_INPUT_TRACE_SCOPE("ImKeyboard::Numpad");
+		RenderKeyRow(draw_list, numpad_keys, IM_ARRAYSIZE(numpad_keys), board.Numpad, key_unit, scale, flags,
+					 draw_bodies);
+	} else {
+		// Full keyboard rendering
+		const KeyboardLayoutRows &rows = *board.Layout;
+		const ImVector<KeyLayoutData> &func_row_nav = rows.Rows[ImGuiKeyboardRow_FunctionNav];
+		const ImVector<KeyLayoutData> &num_row = rows.Rows[ImGuiKeyboardRow_Number];
+		const ImVector<KeyLayoutData> &row1 = rows.Rows[ImGuiKeyboardRow_Letters1];
+		const ImVector<KeyLayoutData> &row2 = rows.Rows[ImGuiKeyboardRow_Letters2];
+		const ImVector<KeyLayoutData> &row3 = rows.Rows[ImGuiKeyboardRow_Letters3];
+		const ImVector<KeyLayoutData> &bottom_row = rows.Rows[ImGuiKeyboardRow_Bottom];
+
+		// Function row (with gap below)
+		{
+			IM_INPUT_TRACE_SCOPE("ImKeyboard::FunctionRow");
+			RenderKeyRow(draw_list, function_row_keys, IM_ARRAYSIZE(function_row_keys), board.FunctionRow, key_unit,
+						 scale, flags, draw_bodies);
+			RenderKeyRow(draw_list, func_row_nav.Data, func_row_nav.Size, board.FunctionRowNav, key_unit, scale, flags,
+						 draw_bodies);
+		}
+
+		// Number row
+		{
+			IM_INPUT_TRACE_SCOPE("ImKeyboard::NumberRow");
+			RenderKeyRow(draw_list, num_row.Data, num_row.Size, board.NumberRow, key_unit, scale, flags, draw_bodies);
+		}
+
+		// Letter rows
+		{
+			IM_INPUT_TRACE_SCOPE("ImKeyboard::LetterRows");
+			RenderKeyRow(draw_list, row1.Data, row1.Size, board.Letters1, key_unit, scale, flags, draw_bodies);
+			RenderKeyRow(draw_list, row2.Data, row2.Size, board.Letters2, key_unit, scale, flags, draw_bodies);
 
-	if (highlight_color != 0) {
-		draw_list->AddRectFilled(ImVec2(key_left_bottom, key_top), ImVec2(key_right, key_bottom), highlight_color, key_rounding);
-		draw_list->AddRectFilled(ImVec2(key_left_top, key_top), ImVec2(key_left_bottom, key_row1_bottom), highlight_color, key_rounding);
-	}
-}
+#ifndef IMKEYBOARD_DISABLE_ISO
+			// Render ISO L-shaped Enter key for ISO layouts
+			if (rows.ISO) {
+				RenderISOEnterKey(draw_list, board.Letters1, board.Letters2, key_unit, scale, flags);
+			}
+#endif
 
-// Check if mouse is inside the ISO Enter key L-shape
-static bool IsMouseInISOEnterKey(const ImVec2 &mouse_pos, const ImVec2 &row1_pos, const ImVec2 &row2_pos, float key_unit) {
-	// ISO Enter key position: right edge aligns at 15 units
-	// Top part: starts at 13.5 (after ] key), width 1.5
-	// Bottom part: starts at 13.75 (after # key), width 1.25
-	const float right_edge = 15.0f;
-	const float top_start = 13.5f;
-	const float bottom_start = 13.75f;
+			RenderKeyRow(draw_list, row3.Data, row3.Size, board.Letters3, key_unit, scale, flags, draw_bodies);
+		}
 
-	// Top rectangle bounds
-	float top_left = row1_pos.x + top_start * key_unit;
-	float top_right = row1_pos.x + right_edge * key_unit;
-	float top_top = row1_pos.y;
-	float row1_bottom = row1_pos.y + key_unit;
+		// Bottom row (modifiers + spacebar)
+		{
+			IM_INPUT_TRACE_SCOPE("ImKeyboard::BottomRow");
+			RenderKeyRow(draw_list, bottom_row.Data, bottom_row.Size, board.Bottom, key_unit, scale, flags,
+						 draw_bodies);
+		}
 
-	// Bottom rectangle bounds
-	float bottom_left = row2_pos.x + bottom_start * key_unit;
-	float bottom_right = row2_pos.x + right_edge * key_unit;
-	float bottom_top = row2_pos.y;
-	float bottom_bottom = row2_pos.y + key_unit;
+		// Navigation cluster (Insert/Delete/Home/End/PgUp/PgDn + arrows)
+		{
+			IM_INPUT_TRACE_SCOPE("ImKeyboard::NavCluster");
+			RenderKeyRow(draw_list, nav_cluster_keys, IM_ARRAYSIZE(nav_cluster_keys), board.NavCluster, key_unit, scale,
+						 flags, draw_bodies);
+		}
 
-	// Check if in top part (row1)
-	if (mouse_pos.x >= top_left && mouse_pos.x <= top_right &&
-		mouse_pos.y >= top_top && mouse_pos.y <= row1_bottom) {
-		return true;
+		// Numeric keypad
+		if (!(flags & ImGuiKeyboardFlags_NoNumpad)) {
+			IM_INPUT_TRACE_SCOPE("ImKeyboard::Numpad");
+			RenderKeyRow(draw_list, numpad_keys, IM_ARRAYSIZE(numpad_keys), board.Numpad, key_unit, scale, flags,
+						 draw_bodies);
+		}
 	}
 
-	// Check if in bottom part (row2)
-	if (mouse_pos.x >= bottom_left && mouse_pos.x <= bottom_right &&
-		mouse_pos.y >= bottom_top && mouse_pos.y <= bottom_bottom) {
-		return true;
-	}
+	draw_list->PopClipRect();
+}
 
-	return false;
+#ifdef IMKEYBOARD_HAS_KEY_HIT_TEST
+static void AddKeyRect(BoardKeyRects *rects, ImGuiKey key, float min_x, float min_y, float max_x, float max_y) {
+	rects->MinX.push_back(min_x);
+	rects->MinY.push_back(min_y);
+	rects->MaxX.push_back(max_x);
+	rects->MaxY.push_back(max_y);
+	rects->Keys.push_back(key);
 }
 
-static void RenderKeyRow(ImDrawList *draw_list, const KeyLayoutData *keys, int key_count, const ImVec2 &start_pos,
-						 float key_unit, float scale, ImGuiKeyboardFlags flags) {
-	const ImGuiKeyboardStyle &style = GetStyle();
-	const float border_size = style.KeyBorderSize * scale;
+// Same rects as RenderKeyRow() draws
+static void AddKeyRowRects(BoardKeyRects *rects, const KeyLayoutData *keys, int key_count, const ImVec2 &start_pos,
+						   float key_unit, float border_size) {
 	for (int i = 0; i < key_count; i++) {
-		const KeyLayoutData *key = &keys[i];
-		ImVec2 key_min =
-			ImVec2(start_pos.x + key->X * key_unit + border_size, start_pos.y + key->Y * key_unit + border_size);
-		ImVec2 key_size =
-			ImVec2(key->Width * key_unit - 2.0f * border_size, key->Height * key_unit - 2.0f * border_size);
-		RenderKey(draw_list, key_min, key_size, key->Label, key->ShiftLabel, key->Key, scale, flags);
+		const KeyLayoutData &key = keys[i];
+		const float min_x = start_pos.x + key.X * key_unit + border_size;
+		const float min_y = start_pos.y + key.Y * key_unit + border_size;
+		AddKeyRect(rects, key.Key, min_x, min_y, min_x + (key.Width * key_unit - 2.0f * border_size),
+				   min_y + (key.Height * key_unit - 2.0f * border_size));
 	}
 }
 
-static void Record(ImGuiKey key, bool record) {
-	KeyboardContext *ctx = GetContext();
-	if (record) {
-		// Add key if not already present
-		if (!IsKeyRecorded(key)) {
-			ctx->RecordedKeys.push_back(key);
-		}
+// Key rects of a board relative to its top left corner, rebuilt when anything that moves the keys changed
+static BoardKeyRects *GetBoardKeyRects(KeyboardContext *ctx, ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags,
+									   float scale) {
+	BoardKeyRects &rects = ctx->KeyRects[layout];
+	const ImGuiKeyboardStyle &style = ctx->Style;
+	const bool no_numpad = (flags & ImGuiKeyboardFlags_NoNumpad) != 0;
+	if (rects.Keys.Size > 0 && rects.NoNumpad == no_numpad && rects.Scale == scale &&
+		rects.LayoutEditCount == ctx->LayoutEditCount && rects.KeyUnit == style.KeyUnit &&
+		rects.SectionGap == style.SectionGap && rects.BoardPadding == style.BoardPadding &&
+		rects.KeyBorderSize == style.KeyBorderSize) {
+		return &rects;
+	}
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::KeyRects");
+	rects.NoNumpad = no_numpad;
+	rects.Scale = scale;
+	rects.LayoutEditCount = ctx->LayoutEditCount;
+	rects.KeyUnit = style.KeyUnit;
+	rects.SectionGap = style.SectionGap;
+	rects.BoardPadding = style.BoardPadding;
+	rects.KeyBorderSize = style.KeyBorderSize;
+	rects.MinX.resize(0);
+	rects.MinY.resize(0);
+	rects.MaxX.resize(0);
+	rects.MaxY.resize(0);
+	rects.Keys.resize(0);
+
+	BoardRows board;
+	CalcBoardRows(&board, layout, ImVec2(0.0f, 0.0f), style, scale);
+	const float key_unit = board.KeyUnit;
+	const float border_size = style.KeyBorderSize * scale;
+	if (board.Layout == nullptr) {
+		AddKeyRowRects(&rects, numpad_keys, IM_ARRAYSIZE(numpad_keys), board.Numpad, key_unit, border_size);
 	} else {
-		// Remove key if present
-		for (int i = 0; i < ctx->RecordedKeys.Size; i++) {
-			if (ctx->RecordedKeys[i] == key) {
-				ctx->RecordedKeys.erase(&ctx->RecordedKeys[i]);
-				break;
-			}
+		const KeyboardLayoutRows &rows = *board.Layout;
+#ifndef IMKEYBOARD_DISABLE_ISO
+		if (rows.ISO) {
+			// L-shaped Enter: the top part starts at 13.5 units (after ]), the bottom part at 13.75 (after #), both end
+			// at 15. Unlike the other keys it includes its edges, so the max sides are moved past them (but for the
+			// edge the parts share).
+			const float right = nextafterf(board.Letters1.x + 15.0f * key_unit, FLT_MAX);
+			AddKeyRect(&rects, ImGuiKey_Enter, board.Letters1.x + 13.5f * key_unit, board.Letters1.y, right,
+					   board.Letters2.y);
+			AddKeyRect(&rects, ImGuiKey_Enter, board.Letters2.x + 13.75f * key_unit, board.Letters2.y, right,
+					   nextafterf(board.Letters2.y + key_unit, FLT_MAX));
+		}
+#endif
+		const ImVec2 row_pos[ImGuiKeyboardRow_COUNT] = {board.FunctionRowNav, board.NumberRow, board.Letters1,
+														board.Letters2, board.Letters3, board.Bottom};
+		IM_STATIC_ASSERT(ImGuiKeyboardRow_FunctionNav == 0 && ImGuiKeyboardRow_Bottom == ImGuiKeyboardRow_COUNT - 1);
+		AddKeyRowRects(&rects, function_row_keys, IM_ARRAYSIZE(function_row_keys), board.FunctionRow, key_unit,
+					   border_size);
+		for (int row = 0; row < ImGuiKeyboardRow_COUNT; row++) {
+			AddKeyRowRects(&rects, rows.Rows[row].Data, rows.Rows[row].Size, row_pos[row], key_unit, border_size);
 		}
+		AddKeyRowRects(&rects, nav_cluster_keys, IM_ARRAYSIZE(nav_cluster_keys), board.NavCluster, key_unit,
+					   border_size);
+		if (!no_numpad) {
+			AddKeyRowRects(&rects, numpad_keys, IM_ARRAYSIZE(numpad_keys), board.Numpad, key_unit, border_size);
+		}
+	}
+	// Pad with empty rects to whole SIMD steps
+	while (rects.Keys.Size % 8 != 0) {
+		AddKeyRect(&rects, ImGuiKey_None, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
 	}
+	rects.HitMask.resize((rects.Keys.Size + 31) / 32);
+	return &rects;
 }
 
-// Handle recording for a row of keys - called when Recordable flag is set
-static void HandleKeyRowRecording(const KeyLayoutData *keys, int key_count, const ImVec2 &start_pos,
-								   float key_unit, float scale, const ImVec2 &mouse_pos, bool mouse_clicked) {
-	const ImGuiKeyboardStyle &style = GetStyle();
-	const float border_size = style.KeyBorderSize * scale;
-	for (int i = 0; i < key_count; i++) {
-		const KeyLayoutData *key = &keys[i];
-		ImVec2 key_min =
-			ImVec2(start_pos.x + key->X * key_unit + border_size, start_pos.y + key->Y * key_unit + border_size);
-		ImVec2 key_size =
-			ImVec2(key->Width * key_unit - 2.0f * border_size, key->Height * key_unit - 2.0f * border_size);
-		ImVec2 key_max = ImVec2(key_min.x + key_size.x, key_min.y + key_size.y);
-
-		// Check if mouse is inside this key and was clicked
-		if (mouse_clicked &&
-			mouse_pos.x >= key_min.x && mouse_pos.x < key_max.x &&
-			mouse_pos.y >= key_min.y && mouse_pos.y < key_max.y) {
-			// Toggle the recorded state
-			if (IsKeyRecorded(key->Key)) {
-				Record(key->Key, false);
-			} else {
-				Record(key->Key, true);
+// Sets bit i of the hit mask for every rect i with min <= pos < max, pos relative to the board. Tests 8 rects per
+// step with AVX, 4 with SSE2.
+static const ImU32 *HitTestKeyRects(BoardKeyRects *rects, const ImVec2 &pos) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::HitTest");
+	ImU32 *hit_mask = rects->HitMask.Data;
+	memset(hit_mask, 0, sizeof(ImU32) * rects->HitMask.Size);
+	const float *min_x = rects->MinX.Data;
+	const float *min_y = rects->MinY.Data;
+	const float *max_x = rects->MaxX.Data;
+	const float *max_y = rects->MaxY.Data;
+	const int count = rects->Keys.Size;
+#if defined(IMKEYBOARD_ENABLE_AVX)
+	const __m256 px = _mm256_set1_ps(pos.x);
+	const __m256 py = _mm256_set1_ps(pos.y);
+	for (int i = 0; i < count; i += 8) {
+		const __m256 in_x = _mm256_and_ps(_mm256_cmp_ps(px, _mm256_loadu_ps(min_x + i), _CMP_GE_OQ),
+										  _mm256_cmp_ps(px, _mm256_loadu_ps(max_x + i), _CMP_LT_OQ));
+		const __m256 in_y = _mm256_and_ps(_mm256_cmp_ps(py, _mm256_loadu_ps(min_y + i), _CMP_GE_OQ),
+										  _mm256_cmp_ps(py, _mm256_loadu_ps(max_y + i), _CMP_LT_OQ));
+		hit_mask[i >> 5] |= (ImU32)_mm256_movemask_ps(_mm256_and_ps(in_x, in_y)) << (i & 31);
+	}
+#elif defined(IMKEYBOARD_ENABLE_SSE2)
+	const __m128 px = _mm_set1_ps(pos.x);
+	const __m128 py = _mm_set1_ps(pos.y);
+	for (int i = 0; i < count; i += 4) {
+		const __m128 in_x =
+			_mm_and_ps(_mm_cmpge_ps(px, _mm_loadu_ps(min_x + i)), _mm_cmplt_ps(px, _mm_loadu_ps(max_x + i)));
+		const __m128 in_y =
+			_mm_and_ps(_mm_cmpge_ps(py, _mm_loadu_ps(min_y + i)), _mm_cmplt_ps(py, _mm_loadu_ps(max_y + i)));
+		hit_mask[i >> 5] |= (ImU32)_mm_movemask_ps(_mm_and_ps(in_x, in_y)) << (i & 31);
+	}
+#else
+	for (int i = 0; i < count; i++) {
+		if (pos.x >= min_x[i] && pos.x < max_x[i] && pos.y >= min_y[i] && pos.y < max_y[i]) {
+			hit_mask[i >> 5] |= 1u << (i & 31);
+		}
+	}
+#endif
+	return hit_mask;
+}
+#endif // IMKEYBOARD_HAS_KEY_HIT_TEST
+
+#ifdef IMKEYBOARD_HAS_KEY_TOOLTIPS
+// Key under a position relative to the board, ImGuiKey_None over gaps
+static ImGuiKey FindKeyAt(BoardKeyRects *rects, const ImVec2 &pos) {
+	const ImU32 *hit_mask = HitTestKeyRects(rects, pos);
+	for (int w = 0; w < rects->HitMask.Size; w++) {
+		if (hit_mask[w] != 0) {
+			return rects->Keys[w * 32 + FindLowestBit(hit_mask[w])];
+		}
+	}
+	return ImGuiKey_None;
+}
+#endif // IMKEYBOARD_HAS_KEY_TOOLTIPS
+
+#ifndef IMKEYBOARD_DISABLE_KEY_OWNERS
+// Debug color of an owner or route id, stable across frames
+static ImU32 GetOwnerColor(ImGuiID id, int alpha) {
+	const float hue = (float)(ImHashData(&id, sizeof(id)) & 0xFFFF) / 65535.0f;
+	float r, g, b;
+	ImGui::ColorConvertHSVtoRGB(hue, 0.7f, 1.0f, r, g, b);
+	return IM_COL32((int)(r * 255.0f), (int)(g * 255.0f), (int)(b * 255.0f), alpha);
+}
+
+static bool IsRealOwner(ImGuiID id) {
+	return id != ImGuiKeyOwner_NoOwner && id != ImGuiKeyOwner_Any;
+}
+
+// Colors keys by their ImGui owner, or by the current route of their first routed chord, in one pass over the owner
+// data and the routing table
+static void UpdateKeyOwnerColors(KeyboardContext *ctx) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::KeyOwners");
+	const ImGuiContext &g = *GImGui;
+	const ImGuiKeyRoutingTable &routing = g.KeysRoutingTable;
+	for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+		const ImGuiID owner = g.KeysOwnerData[k].OwnerCurr;
+		ImU32 color = 0;
+		if (IsRealOwner(owner)) {
+			color = GetOwnerColor(owner, 200);
+		} else {
+			for (ImGuiKeyRoutingIndex i = routing.Index[k]; i != -1; i = routing.Entries[i].NextEntryIndex) {
+				if (IsRealOwner(routing.Entries[i].RoutingCurr)) {
+					color = GetOwnerColor(routing.Entries[i].RoutingCurr, 110);
+					break;
+				}
 			}
 		}
+		ctx->KeyOwnerColors[k] = color;
 	}
 }
 
-void Highlight(ImGuiKey key, bool highlight) {
-	KeyboardContext *ctx = GetContext();
-	if (highlight) {
-		// Add key if not already present
-		if (!IsKeyHighlighted(key)) {
-			ctx->HighlightedKeys.push_back(key);
+static void TextOwner(const char *prefix, ImGuiID id, ImU32 color) {
+	const float size = ImGui::GetFontSize();
+	ImGui::ColorButton("##Owner", ImGui::ColorConvertU32ToFloat4(color | IM_COL32_A_MASK),
+					   ImGuiColorEditFlags_NoTooltip, ImVec2(size, size));
+	ImGui::SameLine();
+	const ImGuiWindow *window = ImGui::FindWindowByID(id);
+	if (window != nullptr) {
+		ImGui::Text("%s window \"%s\" (0x%08X)", prefix, window->Name, id);
+	} else {
+		ImGui::Text("%s 0x%08X", prefix, id);
+	}
+}
+
+static void KeyOwnerTooltip(ImGuiKey key) {
+	const ImGuiContext &g = *GImGui;
+	const int k = key - ImGuiKey_NamedKey_BEGIN;
+	const ImGuiKeyOwnerData &owner = g.KeysOwnerData[k];
+	ImGui::BeginTooltip();
+	ImGui::TextUnformatted(ImGui::GetKeyName(key));
+	ImGui::Separator();
+	if (IsRealOwner(owner.OwnerCurr)) {
+		const char *prefix = "Owned by";
+		if (owner.LockUntilRelease) {
+			prefix = "Owned (locked until release) by";
+		} else if (owner.LockThisFrame) {
+			prefix = "Owned (locked) by";
 		}
+		TextOwner(prefix, owner.OwnerCurr, GetOwnerColor(owner.OwnerCurr, 255));
 	} else {
-		// Remove key if present
-		for (int i = 0; i < ctx->HighlightedKeys.Size; i++) {
-			if (ctx->HighlightedKeys[i] == key) {
-				ctx->HighlightedKeys.erase(&ctx->HighlightedKeys[i]);
-				break;
-			}
+		ImGui::TextDisabled("No owner");
+	}
+	const ImGuiKeyRoutingTable &routing = g.KeysRoutingTable;
+	int routes = 0;
+	for (ImGuiKeyRoutingIndex i = routing.Index[k]; i != -1; i = routing.Entries[i].NextEntryIndex) {
+		const ImGuiKeyRoutingData &route = routing.Entries[i];
+		if (!IsRealOwner(route.RoutingCurr)) {
+			continue;
 		}
+		char chord[64];
+		ImFormatString(chord, IM_ARRAYSIZE(chord), "%s%s%s%s%s routed to", (route.Mods & ImGuiMod_Ctrl) ? "Ctrl+" : "",
+					   (route.Mods & ImGuiMod_Shift) ? "Shift+" : "", (route.Mods & ImGuiMod_Alt) ? "Alt+" : "",
+					   (route.Mods & ImGuiMod_Super) ? "Super+" : "", ImGui::GetKeyName(key));
+		ImGui::PushID(routes++);
+		TextOwner(chord, route.RoutingCurr, GetOwnerColor(route.RoutingCurr, 255));
+		ImGui::PopID();
+	}
+	if (routes == 0) {
+		ImGui::TextDisabled("No shortcut routes");
+	}
+	ImGui::EndTooltip();
+}
+#endif // IMKEYBOARD_DISABLE_KEY_OWNERS
+
+#ifndef IMKEYBOARD_DISABLE_TIMING
+// Tints the keys that chattered with the pressed color
+static void UpdateKeyChatterColors(KeyboardContext *ctx) {
+	const ImU32 color = ImGui::ColorConvertFloat4ToU32(ctx->Style.Colors[ImGuiKeyboardCol_KeyPressed]);
+	for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+		ctx->KeyChatterColors[k] = ctx->KeyTimings[k].ChatterCount > 0 ? color : 0;
 	}
 }
 
-void ClearHighlights() {
-	KeyboardContext *ctx = GetContext();
-	ctx->HighlightedKeys.clear();
+static void KeyTimingTooltip(ImGuiKey key) {
+	ImGui::BeginTooltip();
+	ImGui::TextUnformatted(ImGui::GetKeyName(key));
+	ImGui::Separator();
+	ImGuiKeyboardKeyTiming timing;
+	if (GetKeyTiming(key, &timing)) {
+		ImGui::Text("Presses  %d", timing.PressCount);
+		ImGui::Text("Hold     p50 %7.1f ms  p99 %7.1f ms", timing.HoldP50, timing.HoldP99);
+		ImGui::Text("Interval p50 %7.1f ms  p99 %7.1f ms", timing.IntervalP50, timing.IntervalP99);
+		if (timing.ChatterCount > 0) {
+			ImGui::TextColored(GetStyle().Colors[ImGuiKeyboardCol_KeyPressed], "Chatter  %d (presses within %.1f ms)",
+							   timing.ChatterCount, (float)GetContext()->ChatterWindow / 1000000.0f);
+		}
+	} else {
+		ImGui::TextDisabled("No presses");
+	}
+	ImGui::EndTooltip();
+}
+#endif // IMKEYBOARD_DISABLE_TIMING
+
+// Folds what a board draws into the hash of the frame, the draw source has to be current. Pressed keys other than the
+// ones that change labels only count with ImGuiKeyboardFlags_ShowPressed.
+static void AddBoardStateHash(KeyboardContext *ctx, ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags, float scale) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::StateHash");
+	const int frame = ImGui::GetFrameCount();
+	if (ctx->StateHashFrame != frame) {
+		ctx->PrevStateHash = ctx->StateHash;
+		ctx->StateHash = 0;
+		ctx->StateHashFrame = frame;
+	}
+	const DrawSource *src = GetDrawSource();
+	ImU32 down[IM_INPUT_STATE_MAX_KEYS / 32] = {};
+	for (int k = ImGuiKey_NamedKey_BEGIN; k < ImGuiKey_GamepadStart; k++) {
+		const ImGuiKey key = (ImGuiKey)k;
+		const bool changes_labels = key == ImGuiKey_LeftShift || key == ImGuiKey_RightShift || key == ImGuiKey_NumLock;
+		if (((flags & ImGuiKeyboardFlags_ShowPressed) || changes_labels) && IsKeyDown(key)) {
+			const int index = k - ImGuiKey_NamedKey_BEGIN;
+			down[index >> 5] |= 1u << (index & 31);
+		}
+	}
+	const int header[3] = {layout, flags & ~ImGuiKeyboardFlags_MeasureLatency, ctx->LayoutEditCount};
+	ImGuiID h = ImHashData(header, sizeof(header), ctx->StateHash);
+	h = ImHashData(&scale, sizeof(scale), h);
+	h = ImHashData(src->Style, sizeof(*src->Style), h);
+	h = ImHashData(down, sizeof(down), h);
+	h = ImHashData(src->KeyHighlights, sizeof(ImU8) * ImGuiKey_NamedKey_COUNT, h);
+	h = ImHashData(src->RecordedKeys->Data, sizeof(ImGuiKey) * src->RecordedKeys->Size, h);
+	if (src->ActiveLayerBits != 0) {
+		h = ImHashData(src->KeyLayerBits, sizeof(ImU16) * ImGuiKey_NamedKey_COUNT, h);
+		h = ImHashData(&src->ActiveLayerBits, sizeof(src->ActiveLayerBits), h);
+		h = ImHashData(src->LayerColors, sizeof(ImU32) * IMKEYBOARD_HIGHLIGHT_LAYERS, h);
+	}
+	if (src->KeyFaceColors != nullptr) {
+		h = ImHashData(src->KeyFaceColors, sizeof(ImU32) * src->KeyFaceColorCount, h);
+	}
+	if (src->KeyCounts != nullptr) {
+		h = ImHashData(src->KeyCounts, sizeof(ImU16) * src->KeyCountCount, h);
+	}
+	if (src->KeyPressAlphas != nullptr) {
+		h = ImHashData(src->KeyPressAlphas, sizeof(ImU8) * ImGuiKey_NamedKey_COUNT, h);
+	}
+	ctx->StateHash = h;
 }
 
-void ClearRecorded() {
-	KeyboardContext *ctx = GetContext();
-	ctx->RecordedKeys.clear();
+ImGuiID GetStateHash() {
+	return GetContext()->StateHash;
 }
 
-const ImVector<ImGuiKey>& GetRecordedKeys() {
-	return GetContext()->RecordedKeys;
+bool WantsRedraw() {
+	const KeyboardContext *ctx = GetContext();
+	return ctx->StateHash != ctx->PrevStateHash;
+}
+
+// Latches the presses of the frame into KeyPressAlphas, once per frame. With the ImGui input the processed key events
+// are looked at too, so presses released within the frame (or trickled over several frames) are not missed. Input
+// states only have the keys down at the time of the snapshot.
+static const ImU8 *UpdatePressLatches(KeyboardContext *ctx) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::PressLatches");
+	ImGuiContext &g = *GImGui;
+	if (ctx->PressLatchFrame == g.FrameCount) {
+		return ctx->KeyPressAlphas;
+	}
+	ctx->PressLatchFrame = g.FrameCount;
+	const double now = g.Time;
+	if (ctx->InputState == nullptr) {
+		for (int i = 0; i < g.InputEventsTrail.Size; i++) {
+			const ImGuiInputEvent &e = g.InputEventsTrail[i];
+			if (e.Type == ImGuiInputEventType_Key && e.Key.Down && ImGui::IsNamedKey(e.Key.Key)) {
+				ctx->KeyDownTimes[e.Key.Key - ImGuiKey_NamedKey_BEGIN] = now;
+			}
+		}
+	}
+	const float latch_time = ctx->Style.PressLatchTime;
+	const float fade_time = ctx->Style.PressFadeTime;
+	for (int i = 0; i < ImGuiKey_NamedKey_COUNT; i++) {
+		const ImGuiKey key = (ImGuiKey)(ImGuiKey_NamedKey_BEGIN + i);
+		const int key_index = ctx->InputState != nullptr ? ImInputStateGetKeyIndex(key) : -1;
+		const bool down = ctx->InputState != nullptr
+							  ? key_index != -1 && ImInputStateIsKeyDown(ctx->InputState, key_index)
+							  : ImGui::GetKeyData(&g, key)->Down;
+		if (down) {
+			ctx->KeyDownTimes[i] = now;
+		}
+		const float elapsed = (float)(now - ctx->KeyDownTimes[i]);
+		int alpha = 0;
+		if (elapsed <= latch_time) {
+			alpha = 255;
+		} else if (elapsed < latch_time + fade_time) {
+			alpha = (int)(255.0f * (1.0f - (elapsed - latch_time) / fade_time));
+		}
+		ctx->KeyPressAlphas[i] = (ImU8)alpha;
+	}
+	return ctx->KeyPressAlphas;
+}
+
+static bool IsLatchingPresses(ImGuiKeyboardFlags flags) {
+	const ImGuiKeyboardFlags latch_flags = ImGuiKeyboardFlags_ShowPressed | ImGuiKeyboardFlags_LatchPresses;
+	return (flags & latch_flags) == latch_flags;
+}
+
+// Colors blended over the key faces: the SetKeyColors() array, the key owners in debug mode or the keys with chatter
+static const ImU32 *GetKeyTints(KeyboardContext *ctx, ImGuiKeyboardFlags flags, int *out_count) {
+#ifndef IMKEYBOARD_DISABLE_KEY_OWNERS
+	if (flags & ImGuiKeyboardFlags_ShowKeyOwners) {
+		UpdateKeyOwnerColors(ctx);
+		*out_count = ImGuiKey_NamedKey_COUNT;
+		return ctx->KeyOwnerColors;
+	}
+#endif
+#ifndef IMKEYBOARD_DISABLE_TIMING
+	if ((flags & ImGuiKeyboardFlags_ShowKeyTiming) && !ctx->KeyTimings.empty()) {
+		UpdateKeyChatterColors(ctx);
+		*out_count = ImGuiKey_NamedKey_COUNT;
+		return ctx->KeyChatterColors;
+	}
+#endif
+	IM_UNUSED(flags);
+	*out_count = ctx->KeyColors != nullptr ? ctx->KeyColorCount : 0;
+	return ctx->KeyColors;
 }
 
 void Keyboard(ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::Keyboard");
 	IM_ASSERT(!(layout == ImGuiKeyboardLayout_NumericPad && (flags & ImGuiKeyboardFlags_NoNumpad)) &&
 			  "Cannot use NoNumpad flag with NumericPad layout");
+	layout = GetCompiledLayout(layout);
 
 	KeyboardContext *ctx = GetContext();
+	if (ctx->TextKeysLayout != layout && !ctx->HighlightedText.empty()) {
+		ResolveTextKeys(layout);
+	}
+
 	const ImGuiKeyboardStyle &style = ctx->Style;
 	ImDrawList *draw_list = ImGui::GetWindowDrawList();
 	const float scale = ImGui::GetFontSize() / 13.0f;
-	const float key_unit = style.KeyUnit * scale;
-	const float section_gap = style.SectionGap * scale;
-	const float board_padding = style.BoardPadding * scale;
 
+	const ImVec2 board_size = CalcBoardSize(layout, flags, style, scale);
 	ImVec2 board_min = ImGui::GetCursorScreenPos();
-
-	// Calculate board dimensions based on layout
-	float board_width, board_height;
-	if (layout == ImGuiKeyboardLayout_NumericPad) {
-		// Numpad only: 4 keys wide, 5 rows
-		board_width = 4.0f * key_unit + board_padding * 2.0f;
-		board_height = 5.0f * key_unit + board_padding * 2.0f;
-	} else {
-		// Full keyboard: main section (15 keys) + nav cluster (3 keys) + numpad (4 keys) + gaps
-		float numpad_width = (flags & ImGuiKeyboardFlags_NoNumpad) ? 0.0f : (section_gap + 4.0f * key_unit);
-		board_width = 15.0f * key_unit + section_gap + 3.0f * key_unit + numpad_width + board_padding * 2.0f;
-		board_height = 6.5f * key_unit + board_padding * 2.0f; // Function row + gap + 5 main rows
-	}
-
-	ImVec2 board_max = ImVec2(board_min.x + board_width, board_min.y + board_height);
-	ImVec2 start_pos = ImVec2(board_min.x + board_padding, board_min.y + board_padding);
+	ImVec2 board_max = ImVec2(board_min.x + board_size.x, board_min.y + board_size.y);
 
 	// Reserve space and check visibility
-	ImGui::Dummy(ImVec2(board_width, board_height));
+	ImGui::Dummy(board_size);
 	if (!ImGui::IsItemVisible()) {
 		return;
 	}
 
+	BoardRows board;
+	CalcBoardRows(&board, layout, board_min, style, scale);
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
 	// Handle recording when Recordable flag is set
 	const bool recordable = (flags & ImGuiKeyboardFlags_Recordable) != 0;
 	bool mouse_clicked = false;
 	ImVec2 mouse_pos;
 	if (recordable) {
+		IM_INPUT_TRACE_SCOPE("ImKeyboard::Input");
 		mouse_pos = ImGui::GetMousePos();
 		// Check if the mouse is within the board bounds and left button was clicked
 		if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) &&
@@ -1343,235 +2911,459 @@ void Keyboard(ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags) {
 			}
 		}
 	}
+#endif // IMKEYBOARD_DISABLE_RECORDING
+
+	ImU32 layer_colors[IMKEYBOARD_HIGHLIGHT_LAYERS];
+	GetLayerColors(layer_colors);
+	int tint_count;
+	const ImU32 *tints = GetKeyTints(ctx, flags, &tint_count);
+	if (tints != nullptr) {
+		BlendKeyColors(ctx->KeyFaceColors, tints, tint_count,
+					   ImGui::ColorConvertFloat4ToU32(ctx->Style.Colors[ImGuiKeyboardCol_KeyFace]));
+	}
+	const DrawSource src = {&ctx->Style,
+							ctx->InputState,
+							ctx->KeyHighlights,
+							&ctx->RecordedKeys,
+							ctx->KeyLayerBits,
+							ctx->ActiveLayerBits,
+							layer_colors,
+							tints != nullptr ? ctx->KeyFaceColors : nullptr,
+							tint_count,
+							ctx->KeyCounts,
+							ctx->KeyCountCount,
+							IsLatchingPresses(flags) ? UpdatePressLatches(ctx) : nullptr,
+							ImGui::GetFont(),
+							ImGui::GetFontSize(),
+							0.0f};
+	CurrentDrawSource = &src;
+	AddBoardStateHash(ctx, layout, flags, scale);
+	RenderBoard(draw_list, board_min, board_max, board, flags);
+	CurrentDrawSource = nullptr;
+
+#ifdef IMKEYBOARD_HAS_KEY_TOOLTIPS
+	const ImGuiKeyboardFlags tooltip_flags = ImGuiKeyboardFlags_ShowKeyOwners | ImGuiKeyboardFlags_ShowKeyTiming;
+	if ((flags & tooltip_flags) && ImGui::IsItemHovered()) {
+		const ImVec2 hover_pos = ImGui::GetMousePos();
+		const ImGuiKey hovered_key = FindKeyAt(GetBoardKeyRects(ctx, layout, flags, scale),
+											   ImVec2(hover_pos.x - board_min.x, hover_pos.y - board_min.y));
+#ifndef IMKEYBOARD_DISABLE_KEY_OWNERS
+		if (hovered_key != ImGuiKey_None && (flags & ImGuiKeyboardFlags_ShowKeyOwners)) {
+			KeyOwnerTooltip(hovered_key);
+		}
+#endif
+#ifndef IMKEYBOARD_DISABLE_TIMING
+		if (hovered_key != ImGuiKey_None && (flags & ImGuiKeyboardFlags_ShowKeyTiming)) {
+			KeyTimingTooltip(hovered_key);
+		}
+#endif
+	}
+#endif
+
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	// Every key under the click toggles its recorded state
+	if (mouse_clicked) {
+		IM_INPUT_TRACE_SCOPE("ImKeyboard::Recording");
+		BoardKeyRects *rects = GetBoardKeyRects(ctx, layout, flags, scale);
+		const ImU32 *hit_mask = HitTestKeyRects(rects, ImVec2(mouse_pos.x - board_min.x, mouse_pos.y - board_min.y));
+		for (int w = 0; w < rects->HitMask.Size; w++) {
+			for (ImU32 bits = hit_mask[w]; bits != 0; bits &= bits - 1) {
+				const ImGuiKey key = rects->Keys[w * 32 + FindLowestBit(bits)];
+				Record(key, !IsKeyRecorded(key));
+			}
+		}
+	}
+#endif // IMKEYBOARD_DISABLE_RECORDING
+}
 
-	// Draw board background
-	const float board_rounding = style.BoardRounding * scale;
-	draw_list->AddRectFilled(board_min, board_max, GetColorU32(ImGuiKeyboardCol_BoardBackground), board_rounding);
+ImGuiKeyboardGeometry::ImGuiKeyboardGeometry() {
+	Layout = ImGuiKeyboardLayout_Qwerty;
+	Flags = ImGuiKeyboardFlags_None;
+	ImInputStateInit(&Input);
+	memset(KeyHighlights, 0, sizeof(KeyHighlights));
+	memset(KeyLayerBits, 0, sizeof(KeyLayerBits));
+	memset(LayerColors, 0, sizeof(LayerColors));
+	KeyFaceColorCount = 0;
+	KeyCountCount = 0;
+	memset(KeyPressAlphas, 0, sizeof(KeyPressAlphas));
+	Font = nullptr;
+	FontSize = 0.0f;
+	FontAscent = 0.0f;
+	Size = ImVec2(0.0f, 0.0f);
+	SharedData = nullptr;
+	DrawList = nullptr;
+}
 
-	draw_list->PushClipRect(board_min, board_max, true);
+ImGuiKeyboardGeometry::~ImGuiKeyboardGeometry() {
+	if (DrawList != nullptr) {
+		IM_DELETE(DrawList);
+	}
+	if (SharedData != nullptr) {
+		IM_DELETE(SharedData);
+	}
+}
 
-	if (layout == ImGuiKeyboardLayout_NumericPad) {
-		// Render only numpad
-		RenderKeyRow(draw_list, numpad_keys, IM_ARRAYSIZE(numpad_keys), start_pos, key_unit, scale, flags);
-		// Handle recording for numpad
-		if (mouse_clicked) {
-			HandleKeyRowRecording(numpad_keys, IM_ARRAYSIZE(numpad_keys), start_pos, key_unit, scale, mouse_pos, mouse_clicked);
-		}
-	} else {
-		// Full keyboard rendering
+void PrepareGeometry(ImGuiKeyboardGeometry *geometry, ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags,
+					 const ImInputState *input) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::PrepareGeometry");
+	IM_ASSERT(!(layout == ImGuiKeyboardLayout_NumericPad && (flags & ImGuiKeyboardFlags_NoNumpad)) &&
+			  "Cannot use NoNumpad flag with NumericPad layout");
+	layout = GetCompiledLayout(layout);
 
-		// Navigation cluster X position (used for Print/Scroll/Pause alignment)
-		float nav_x = start_pos.x + 15.0f * key_unit + section_gap;
+	KeyboardContext *ctx = GetContext();
+	if (ctx->TextKeysLayout != layout && !ctx->HighlightedText.empty()) {
+		ResolveTextKeys(layout);
+	}
+	if (layout != ImGuiKeyboardLayout_NumericPad) {
+		GetLayoutRows(layout); // Expand here, builds only read the rows
+	}
 
-		// Function row (with gap below)
-		ImVec2 func_row_pos = start_pos;
-		RenderKeyRow(draw_list, function_row_keys, IM_ARRAYSIZE(function_row_keys), func_row_pos, key_unit, scale,
-					 flags);
-		// Print/Scroll/Pause (or F13/F14/F15 for Apple) - aligned with nav cluster
-		ImVec2 func_row_nav_pos = ImVec2(nav_x, start_pos.y);
-		const bool useAppleFunctionNav = (layout == ImGuiKeyboardLayout_AppleANSI || layout == ImGuiKeyboardLayout_AppleISO);
-		if (useAppleFunctionNav) {
-			RenderKeyRow(draw_list, apple_function_row_nav_keys, IM_ARRAYSIZE(apple_function_row_nav_keys), func_row_nav_pos, key_unit, scale, flags);
-		} else {
-			RenderKeyRow(draw_list, function_row_nav_keys, IM_ARRAYSIZE(function_row_nav_keys), func_row_nav_pos, key_unit, scale, flags);
-		}
+	geometry->Layout = layout;
+	geometry->Flags = flags & ~(ImGuiKeyboardFlags_Recordable | ImGuiKeyboardFlags_MeasureLatency);
+	if (input == nullptr) {
+		input = ctx->InputState;
+	}
+	if (input != nullptr) {
+		geometry->Input = *input;
+	} else {
+		ImInputStateCapture(&geometry->Input);
+	}
+	geometry->Style = ctx->Style;
+	memcpy(geometry->KeyHighlights, ctx->KeyHighlights, sizeof(geometry->KeyHighlights));
+	geometry->RecordedKeys = ctx->RecordedKeys;
+	for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+		geometry->KeyLayerBits[k] = ctx->KeyLayerBits[k] & ctx->ActiveLayerBits;
+	}
+	GetLayerColors(geometry->LayerColors);
+	const ImU32 *tints = GetKeyTints(ctx, flags, &geometry->KeyFaceColorCount);
+	BlendKeyColors(geometry->KeyFaceColors, tints, geometry->KeyFaceColorCount,
+				   ImGui::ColorConvertFloat4ToU32(ctx->Style.Colors[ImGuiKeyboardCol_KeyFace]));
+	geometry->KeyCountCount = ctx->KeyCounts != nullptr ? ctx->KeyCountCount : 0;
+	if (geometry->KeyCountCount > 0) {
+		memcpy(geometry->KeyCounts, ctx->KeyCounts, sizeof(ImU16) * geometry->KeyCountCount);
+	}
+	if (IsLatchingPresses(flags)) {
+		memcpy(geometry->KeyPressAlphas, UpdatePressLatches(ctx), sizeof(geometry->KeyPressAlphas));
+	}
+	geometry->Font = ImGui::GetFont();
+	geometry->FontSize = ImGui::GetFontSize();
+#if IMGUI_VERSION_NUM >= 19200
+	geometry->FontAscent = ImGui::GetFontBaked()->Ascent;
+#else
+	geometry->FontAscent = geometry->Font->Ascent * geometry->FontSize / geometry->Font->FontSize;
+#endif
+	geometry->Size = CalcBoardSize(layout, geometry->Flags, geometry->Style, geometry->FontSize / 13.0f);
+
+#ifndef IMKEYBOARD_DISABLE_GEOMETRY
+	if (geometry->SharedData == nullptr) {
+		geometry->SharedData = IM_NEW(ImDrawListSharedData)();
+	}
+	*geometry->SharedData = *ImGui::GetDrawListSharedData();
+	if (geometry->DrawList == nullptr) {
+		geometry->DrawList = IM_NEW(ImDrawList)(geometry->SharedData);
+	}
+#endif
+}
 
-		// Main keyboard section (offset by function row + gap)
-		float main_section_y = start_pos.y + key_unit + 0.5f * key_unit;
+// Draws from the snapshot of a geometry
+static DrawSource GetGeometryDrawSource(const ImGuiKeyboardGeometry &geometry) {
+	const DrawSource src = {&geometry.Style,
+							&geometry.Input,
+							geometry.KeyHighlights,
+							&geometry.RecordedKeys,
+							geometry.KeyLayerBits,
+							0xFFFF,
+							geometry.LayerColors,
+							geometry.KeyFaceColors,
+							geometry.KeyFaceColorCount,
+							geometry.KeyCounts,
+							geometry.KeyCountCount,
+							IsLatchingPresses(geometry.Flags) ? geometry.KeyPressAlphas : nullptr,
+							geometry.Font,
+							geometry.FontSize,
+							geometry.FontAscent};
+	return src;
+}
 
-		// Number row - select based on layout
-		ImVec2 num_row_pos = ImVec2(start_pos.x, main_section_y);
-		const KeyLayoutData *num_row_keys;
-		int num_row_count;
-		switch (layout) {
-		case ImGuiKeyboardLayout_Qwertz:
-		case ImGuiKeyboardLayout_QwertzISO:
-			num_row_keys = number_row_qwertz_keys;
-			num_row_count = IM_ARRAYSIZE(number_row_qwertz_keys);
-			break;
-		case ImGuiKeyboardLayout_Azerty:
-		case ImGuiKeyboardLayout_AzertyISO:
-			num_row_keys = number_row_azerty_keys;
-			num_row_count = IM_ARRAYSIZE(number_row_azerty_keys);
-			break;
-		default:
-			num_row_keys = number_row_keys;
-			num_row_count = IM_ARRAYSIZE(number_row_keys);
-			break;
+#ifndef IMKEYBOARD_DISABLE_GEOMETRY
+void BuildGeometry(ImGuiKeyboardGeometry *geometry) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::BuildGeometry");
+	IM_ASSERT(geometry->DrawList != nullptr && "Call PrepareGeometry() first");
+	ImDrawList *draw_list = geometry->DrawList;
+	draw_list->_ResetForNewFrame();
+	draw_list->PushClipRect(ImVec2(0.0f, 0.0f), geometry->Size);
+	draw_list->PushTextureID(geometry->Font->ContainerAtlas->TexID);
+
+	BoardRows board;
+	CalcBoardRows(&board, geometry->Layout, ImVec2(0.0f, 0.0f), geometry->Style, geometry->FontSize / 13.0f);
+	const DrawSource src = GetGeometryDrawSource(*geometry);
+	CurrentDrawSource = &src;
+	RenderBoard(draw_list, ImVec2(0.0f, 0.0f), geometry->Size, board, geometry->Flags);
+	CurrentDrawSource = nullptr;
+
+	draw_list->PopTextureID();
+	draw_list->PopClipRect();
+}
+
+void DrawGeometry(const ImGuiKeyboardGeometry &geometry) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::DrawGeometry");
+	ImDrawList *draw_list = ImGui::GetWindowDrawList();
+	const ImVec2 pos = ImGui::GetCursorScreenPos();
+	ImGui::Dummy(geometry.Size);
+	const ImDrawList *src = geometry.DrawList;
+	if (!ImGui::IsItemVisible() || src == nullptr || src->VtxBuffer.Size == 0) {
+		return;
+	}
+	// Everything is drawn with the font atlas, which has to be the current texture of the window
+	IM_ASSERT(draw_list->_CmdHeader.TextureId == geometry.Font->ContainerAtlas->TexID);
+	IM_ASSERT((sizeof(ImDrawIdx) > 2 || src->VtxBuffer.Size < (1 << 16)) && "Board too large for 16-bit indices");
+
+	// Vertices once, moved to the cursor position
+	const int vtx_count = src->VtxBuffer.Size;
+	draw_list->PrimReserve(0, vtx_count);
+	const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
+	ImDrawVert *vtx_write = draw_list->_VtxWritePtr;
+	for (int i = 0; i < vtx_count; i++) {
+		vtx_write[i] = src->VtxBuffer[i];
+		vtx_write[i].pos.x += pos.x;
+		vtx_write[i].pos.y += pos.y;
+	}
+	draw_list->_VtxWritePtr += vtx_count;
+	draw_list->_VtxCurrentIdx += (unsigned int)vtx_count;
+
+	// Indices per command, to keep the clip rects of the build
+	for (int i = 0; i < src->CmdBuffer.Size; i++) {
+		const ImDrawCmd &cmd = src->CmdBuffer[i];
+		if (cmd.ElemCount == 0) {
+			continue;
 		}
-		RenderKeyRow(draw_list, num_row_keys, num_row_count, num_row_pos, key_unit, scale, flags);
-
-		// Letter rows - select based on layout
-		const KeyLayoutData *row1_keys;
-		const KeyLayoutData *row2_keys;
-		const KeyLayoutData *row3_keys;
-		int row1_count, row2_count, row3_count;
-
-		switch (layout) {
-		case ImGuiKeyboardLayout_Qwertz:
-			row1_keys = qwertz_row1_keys;
-			row1_count = IM_ARRAYSIZE(qwertz_row1_keys);
-			row2_keys = qwertz_row2_keys;
-			row2_count = IM_ARRAYSIZE(qwertz_row2_keys);
-			row3_keys = qwertz_row3_keys;
-			row3_count = IM_ARRAYSIZE(qwertz_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_Azerty:
-			row1_keys = azerty_row1_keys;
-			row1_count = IM_ARRAYSIZE(azerty_row1_keys);
-			row2_keys = azerty_row2_keys;
-			row2_count = IM_ARRAYSIZE(azerty_row2_keys);
-			row3_keys = azerty_row3_keys;
-			row3_count = IM_ARRAYSIZE(azerty_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_Colemak:
-			row1_keys = colemak_row1_keys;
-			row1_count = IM_ARRAYSIZE(colemak_row1_keys);
-			row2_keys = colemak_row2_keys;
-			row2_count = IM_ARRAYSIZE(colemak_row2_keys);
-			row3_keys = colemak_row3_keys;
-			row3_count = IM_ARRAYSIZE(colemak_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_Dvorak:
-			row1_keys = dvorak_row1_keys;
-			row1_count = IM_ARRAYSIZE(dvorak_row1_keys);
-			row2_keys = dvorak_row2_keys;
-			row2_count = IM_ARRAYSIZE(dvorak_row2_keys);
-			row3_keys = dvorak_row3_keys;
-			row3_count = IM_ARRAYSIZE(dvorak_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_QwertyISO:
-			row1_keys = qwerty_iso_row1_keys;
-			row1_count = IM_ARRAYSIZE(qwerty_iso_row1_keys);
-			row2_keys = qwerty_iso_row2_keys;
-			row2_count = IM_ARRAYSIZE(qwerty_iso_row2_keys);
-			row3_keys = qwerty_iso_row3_keys;
-			row3_count = IM_ARRAYSIZE(qwerty_iso_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_QwertzISO:
-			row1_keys = qwertz_iso_row1_keys;
-			row1_count = IM_ARRAYSIZE(qwertz_iso_row1_keys);
-			row2_keys = qwertz_iso_row2_keys;
-			row2_count = IM_ARRAYSIZE(qwertz_iso_row2_keys);
-			row3_keys = qwertz_iso_row3_keys;
-			row3_count = IM_ARRAYSIZE(qwertz_iso_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_AzertyISO:
-			row1_keys = azerty_iso_row1_keys;
-			row1_count = IM_ARRAYSIZE(azerty_iso_row1_keys);
-			row2_keys = azerty_iso_row2_keys;
-			row2_count = IM_ARRAYSIZE(azerty_iso_row2_keys);
-			row3_keys = azerty_iso_row3_keys;
-			row3_count = IM_ARRAYSIZE(azerty_iso_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_AppleANSI:
-			row1_keys = apple_ansi_row1_keys;
-			row1_count = IM_ARRAYSIZE(apple_ansi_row1_keys);
-			row2_keys = apple_ansi_row2_keys;
-			row2_count = IM_ARRAYSIZE(apple_ansi_row2_keys);
-			row3_keys = apple_ansi_row3_keys;
-			row3_count = IM_ARRAYSIZE(apple_ansi_row3_keys);
-			break;
-		case ImGuiKeyboardLayout_AppleISO:
-			row1_keys = apple_iso_row1_keys;
-			row1_count = IM_ARRAYSIZE(apple_iso_row1_keys);
-			row2_keys = apple_iso_row2_keys;
-			row2_count = IM_ARRAYSIZE(apple_iso_row2_keys);
-			row3_keys = apple_iso_row3_keys;
-			row3_count = IM_ARRAYSIZE(apple_iso_row3_keys);
-			break;
-		default: // QWERTY
-			row1_keys = qwerty_row1_keys;
-			row1_count = IM_ARRAYSIZE(qwerty_row1_keys);
-			row2_keys = qwerty_row2_keys;
-			row2_count = IM_ARRAYSIZE(qwerty_row2_keys);
-			row3_keys = qwerty_row3_keys;
-			row3_count = IM_ARRAYSIZE(qwerty_row3_keys);
-			break;
+		IM_ASSERT(cmd.UserCallback == nullptr && cmd.VtxOffset == 0);
+		draw_list->PushClipRect(ImVec2(cmd.ClipRect.x + pos.x, cmd.ClipRect.y + pos.y),
+								ImVec2(cmd.ClipRect.z + pos.x, cmd.ClipRect.w + pos.y), true);
+		draw_list->PrimReserve((int)cmd.ElemCount, 0);
+		const ImDrawIdx *idx_read = src->IdxBuffer.Data + cmd.IdxOffset;
+		for (unsigned int n = 0; n < cmd.ElemCount; n++) {
+			draw_list->_IdxWritePtr[n] = (ImDrawIdx)(vtx_base + idx_read[n]);
 		}
+		draw_list->_IdxWritePtr += cmd.ElemCount;
+		draw_list->PopClipRect();
+	}
+}
+#endif // IMKEYBOARD_DISABLE_GEOMETRY
+
+// fill="#rrggbb", or any other paint attribute, with an opacity attribute unless the color is opaque
+static void AppendSVGPaint(ImGuiTextBuffer *out, const char *attr, ImU32 col) {
+	out->appendf(" %s=\"#%02x%02x%02x\"", attr, (col >> IM_COL32_R_SHIFT) & 0xFF, (col >> IM_COL32_G_SHIFT) & 0xFF,
+				 (col >> IM_COL32_B_SHIFT) & 0xFF);
+	const ImU32 alpha = (col >> IM_COL32_A_SHIFT) & 0xFF;
+	if (alpha != 0xFF) {
+		out->appendf(" %s-opacity=\"%.3g\"", attr, alpha / 255.0f);
+	}
+}
 
-		ImVec2 row1_pos = ImVec2(start_pos.x, main_section_y + key_unit);
-		RenderKeyRow(draw_list, row1_keys, row1_count, row1_pos, key_unit, scale, flags);
+// Like ImDrawList::AddRectFilled()
+static void AppendSVGRectFilled(ImGuiTextBuffer *out, const ImVec2 &min, const ImVec2 &max, float rounding,
+								ImU32 col) {
+	if ((col & IM_COL32_A_MASK) == 0) {
+		return;
+	}
+	const float r = ImMax(ImMin(rounding, ImMin(max.x - min.x, max.y - min.y) * 0.5f), 0.0f);
+	out->appendf("<rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\" rx=\"%.2f\"", min.x, min.y, max.x - min.x,
+				 max.y - min.y, r);
+	AppendSVGPaint(out, "fill", col);
+	out->append("/>\n");
+}
 
-		ImVec2 row2_pos = ImVec2(start_pos.x, main_section_y + 2.0f * key_unit);
-		RenderKeyRow(draw_list, row2_keys, row2_count, row2_pos, key_unit, scale, flags);
+// Like ImDrawList::AddRect(), which strokes half a pixel inside the rect
+static void AppendSVGRect(ImGuiTextBuffer *out, const ImVec2 &min, const ImVec2 &max, float rounding, ImU32 col,
+						  float thickness) {
+	if ((col & IM_COL32_A_MASK) == 0 || thickness <= 0.0f) {
+		return;
+	}
+	const ImVec2 path_min(min.x + 0.5f, min.y + 0.5f);
+	const ImVec2 path_max(max.x - 0.5f, max.y - 0.5f);
+	const float r = ImMax(ImMin(rounding, ImMin(path_max.x - path_min.x, path_max.y - path_min.y) * 0.5f), 0.0f);
+	out->appendf("<rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\" rx=\"%.2f\" fill=\"none\" "
+				 "stroke-width=\"%.2f\"",
+				 path_min.x, path_min.y, path_max.x - path_min.x, path_max.y - path_min.y, r, thickness);
+	AppendSVGPaint(out, "stroke", col);
+	out->append("/>\n");
+}
 
-		// Render ISO L-shaped Enter key for ISO layouts
-		const bool isISOLayout = (layout == ImGuiKeyboardLayout_QwertyISO ||
-								  layout == ImGuiKeyboardLayout_QwertzISO ||
-								  layout == ImGuiKeyboardLayout_AzertyISO ||
-								  layout == ImGuiKeyboardLayout_AppleISO);
-		if (isISOLayout) {
-			RenderISOEnterKey(draw_list, row1_pos, row2_pos, key_unit, scale, flags);
+// Text at the top left position ImDrawList::AddText() takes, or with anchor "end" or "middle" at the right or center
+static void AppendSVGText(ImGuiTextBuffer *out, const ImVec2 &pos, float font_size, const char *text,
+						  const char *anchor = nullptr) {
+	if (text == nullptr || text[0] == 0) {
+		return;
+	}
+	// SVG places the baseline
+	const DrawSource *src = GetDrawSource();
+	const float baseline = pos.y + src->FontAscent * font_size / src->FontSize;
+	out->appendf("<text x=\"%.2f\" y=\"%.2f\" font-size=\"%.2f\"", pos.x, baseline, font_size);
+	if (anchor != nullptr) {
+		out->appendf(" text-anchor=\"%s\"", anchor);
+	}
+	AppendSVGPaint(out, "fill", GetColorU32(ImGuiKeyboardCol_KeyLabel));
+	out->append(">");
+	for (const char *c = text; *c != 0; c++) {
+		const char *entity = *c == '&' ? "&amp;" : *c == '<' ? "&lt;" : *c == '>' ? "&gt;" : nullptr;
+		if (entity != nullptr) {
+			out->append(entity);
+		} else {
+			out->append(c, c + 1);
 		}
+	}
+	out->append("</text>\n");
+}
 
-		ImVec2 row3_pos = ImVec2(start_pos.x, main_section_y + 3.0f * key_unit);
-		RenderKeyRow(draw_list, row3_keys, row3_count, row3_pos, key_unit, scale, flags);
+// Number in the bottom right corner of the key face, like RenderKeyCount()
+static void AppendSVGKeyCount(ImGuiTextBuffer *out, const ImVec2 &face_max, ImGuiKey key) {
+	const DrawSource *src = GetDrawSource();
+	const int index = key - ImGuiKey_NamedKey_BEGIN;
+	if (src->KeyCounts == nullptr || index < 0 || index >= src->KeyCountCount || src->KeyCounts[index] == 0) {
+		return;
+	}
+	char buf[8];
+	ImFormatString(buf, IM_ARRAYSIZE(buf), "%d", (int)src->KeyCounts[index]);
+	const float font_size = src->FontSize * 0.75f;
+	AppendSVGText(out, ImVec2(face_max.x - 1.0f, face_max.y - font_size), font_size, buf, "end");
+}
 
-		// Bottom row (modifiers + spacebar) - use Apple bottom row for Apple layouts
-		ImVec2 bottom_row_pos = ImVec2(start_pos.x, main_section_y + 4.0f * key_unit);
-		const bool isAppleLayout = (layout == ImGuiKeyboardLayout_AppleANSI ||
-									layout == ImGuiKeyboardLayout_AppleISO);
-		if (isAppleLayout) {
-			RenderKeyRow(draw_list, apple_bottom_row_keys, IM_ARRAYSIZE(apple_bottom_row_keys), bottom_row_pos, key_unit, scale, flags);
-		} else {
-			RenderKeyRow(draw_list, bottom_row_keys, IM_ARRAYSIZE(bottom_row_keys), bottom_row_pos, key_unit, scale, flags);
+// A key as RenderKey() draws it, with text for the icons
+static void AppendSVGKey(ImGuiTextBuffer *out, const KeyLayoutData &key, const ImVec2 &start_pos, float key_unit,
+						 float scale, ImGuiKeyboardFlags flags) {
+	const DrawSource *src = GetDrawSource();
+	const ImGuiKeyboardStyle &style = *src->Style;
+	const float border_size = style.KeyBorderSize * scale;
+	const float key_rounding = style.KeyRounding * scale;
+	const float key_face_rounding = style.KeyFaceRounding * scale;
+	const ImVec2 key_min(start_pos.x + key.X * key_unit + border_size, start_pos.y + key.Y * key_unit + border_size);
+	const ImVec2 key_max(key_min.x + key.Width * key_unit - 2.0f * border_size,
+						 key_min.y + key.Height * key_unit - 2.0f * border_size);
+	const ImVec2 face_min(key_min.x + style.KeyFaceOffset.x * scale, key_min.y + style.KeyFaceOffset.y * scale);
+	const ImVec2 face_max(key_max.x - style.KeyFaceOffset.x * scale, key_max.y - style.KeyFaceOffset.y * scale);
+	AppendSVGRectFilled(out, key_min, key_max, key_rounding, GetColorU32(ImGuiKeyboardCol_KeyBackground));
+	AppendSVGRect(out, key_min, key_max, key_rounding, GetColorU32(ImGuiKeyboardCol_KeyBorder), 1.0f);
+	AppendSVGRect(out, face_min, face_max, key_face_rounding, GetColorU32(ImGuiKeyboardCol_KeyFaceBorder),
+				  style.KeyFaceBorderSize);
+	AppendSVGRectFilled(out, face_min, face_max, key_face_rounding, GetKeyFaceColor(key.Key));
+
+	const char *lines[2];
+	const int line_count = GetKeyLabelLines(key.Label, key.ShiftLabel, flags, lines);
+	const ImVec2 label_min(key_min.x + style.KeyLabelOffset.x * scale, key_min.y + style.KeyLabelOffset.y * scale);
+	for (int i = 0; i < line_count; i++) {
+		AppendSVGText(out, ImVec2(label_min.x, label_min.y + i * src->FontSize), src->FontSize, lines[i]);
+	}
+	AppendSVGKeyCount(out, face_max, key.Key);
+
+	ImU32 overlay_colors[2];
+	GetKeyOverlayColors(key.Key, flags, overlay_colors);
+	for (int i = 0; i < 2; i++) {
+		if (overlay_colors[i] != 0) {
+			AppendSVGRectFilled(out, key_min, key_max, key_rounding, overlay_colors[i]);
 		}
+	}
+}
 
-		// Navigation cluster (Insert/Delete/Home/End/PgUp/PgDn + arrows)
-		ImVec2 nav_pos = ImVec2(nav_x, main_section_y);
-		RenderKeyRow(draw_list, nav_cluster_keys, IM_ARRAYSIZE(nav_cluster_keys), nav_pos, key_unit, scale, flags);
+#ifndef IMKEYBOARD_DISABLE_ISO
+// Outline of the ISO Enter key, inset by offset
+static void AppendSVGISOEnterPath(ImGuiTextBuffer *out, const ISOEnterShape &shape, const ImVec2 &offset) {
+	out->appendf("<path d=\"M%.2f %.2fH%.2fV%.2fH%.2fV%.2fH%.2fZ\"", shape.LeftTop + offset.x, shape.Top + offset.y,
+				 shape.Right - offset.x, shape.Bottom - offset.y, shape.LeftBottom + offset.x,
+				 shape.Row1Bottom - offset.y, shape.LeftTop + offset.x);
+}
 
-		// Numeric keypad
-		if (!(flags & ImGuiKeyboardFlags_NoNumpad)) {
-			float numpad_x = nav_x + 3.0f * key_unit + section_gap;
-			ImVec2 numpad_pos = ImVec2(numpad_x, main_section_y);
-			RenderKeyRow(draw_list, numpad_keys, IM_ARRAYSIZE(numpad_keys), numpad_pos, key_unit, scale, flags);
-		}
-
-		// Handle recording for all key rows when Recordable flag is set
-		if (mouse_clicked) {
-			// Function row
-			HandleKeyRowRecording(function_row_keys, IM_ARRAYSIZE(function_row_keys), func_row_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			HandleKeyRowRecording(function_row_nav_keys, IM_ARRAYSIZE(function_row_nav_keys), func_row_nav_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			// Number row
-			HandleKeyRowRecording(num_row_keys, num_row_count, num_row_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			// Letter rows
-			HandleKeyRowRecording(row1_keys, row1_count, row1_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			HandleKeyRowRecording(row2_keys, row2_count, row2_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			// ISO Enter key (if ISO layout)
-			if (isISOLayout && IsMouseInISOEnterKey(mouse_pos, row1_pos, row2_pos, key_unit)) {
-				Record(ImGuiKey_Enter, !IsKeyRecorded(ImGuiKey_Enter));
-			}
-			HandleKeyRowRecording(row3_keys, row3_count, row3_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			// Bottom row
-			if (isAppleLayout) {
-				HandleKeyRowRecording(apple_bottom_row_keys, IM_ARRAYSIZE(apple_bottom_row_keys), bottom_row_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			} else {
-				HandleKeyRowRecording(bottom_row_keys, IM_ARRAYSIZE(bottom_row_keys), bottom_row_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			}
-			// Navigation cluster
-			HandleKeyRowRecording(nav_cluster_keys, IM_ARRAYSIZE(nav_cluster_keys), nav_pos, key_unit, scale, mouse_pos, mouse_clicked);
-			// Numpad (if visible)
-			if (!(flags & ImGuiKeyboardFlags_NoNumpad)) {
-				float numpad_x_recording = nav_x + 3.0f * key_unit + section_gap;
-				ImVec2 numpad_pos_recording = ImVec2(numpad_x_recording, main_section_y);
-				HandleKeyRowRecording(numpad_keys, IM_ARRAYSIZE(numpad_keys), numpad_pos_recording, key_unit, scale, mouse_pos, mouse_clicked);
-			}
+// The L-shaped Enter key as RenderISOEnterKey() draws it
+static void AppendSVGISOEnterKey(ImGuiTextBuffer *out, const BoardRows &board, ImGuiKeyboardFlags flags) {
+	const DrawSource *src = GetDrawSource();
+	const ImGuiKeyboardStyle &style = *src->Style;
+	const float scale = board.Scale;
+	const ISOEnterShape shape =
+		CalcISOEnterShape(board.Letters1, board.Letters2, board.KeyUnit, style.KeyBorderSize * scale);
+	AppendSVGISOEnterPath(out, shape, ImVec2(0.0f, 0.0f));
+	AppendSVGPaint(out, "fill", GetColorU32(ImGuiKeyboardCol_KeyBackground));
+	AppendSVGPaint(out, "stroke", GetColorU32(ImGuiKeyboardCol_KeyBorder));
+	out->append("/>\n");
+	const ImVec2 face_offset(style.KeyFaceOffset.x * scale, style.KeyFaceOffset.y * scale);
+	AppendSVGISOEnterPath(out, shape, face_offset);
+	AppendSVGPaint(out, "fill", GetKeyFaceColor(ImGuiKey_Enter));
+	out->append("/>\n");
+
+	const float top_center_y = (shape.Top + shape.Row1Bottom) * 0.5f;
+	AppendSVGText(out, ImVec2((shape.LeftTop + shape.Right) * 0.5f, top_center_y - src->FontSize * 0.5f),
+				  src->FontSize, "Enter", "middle");
+	AppendSVGKeyCount(out, ImVec2(shape.Right - face_offset.x, shape.Bottom - face_offset.y), ImGuiKey_Enter);
+
+	// Bent arrow, same proportions as in RenderISOEnterKey()
+	const float bottom_center_x = (shape.LeftBottom + shape.Right) * 0.5f;
+	const float bottom_center_y = (shape.Row1Bottom + shape.Bottom) * 0.5f;
+	const float icon_size = src->FontSize * 0.6f;
+	const float arrow_top = bottom_center_y - icon_size * 0.4f;
+	const float arrow_bend_y = bottom_center_y + icon_size * 0.3f;
+	const float arrow_right = bottom_center_x + icon_size * 0.4f;
+	const float arrow_left = bottom_center_x - icon_size * 0.4f;
+	const float arrow_head_size = icon_size * 0.25f;
+	out->appendf("<path d=\"M%.2f %.2fV%.2fH%.2f\" fill=\"none\" stroke-width=\"%.2f\"", arrow_right, arrow_top,
+				 arrow_bend_y, arrow_left + arrow_head_size, 1.5f * scale);
+	AppendSVGPaint(out, "stroke", GetColorU32(ImGuiKeyboardCol_KeyLabel));
+	out->appendf("/>\n<path d=\"M%.2f %.2fL%.2f %.2fV%.2fZ\"", arrow_left, arrow_bend_y, arrow_left + arrow_head_size,
+				 arrow_bend_y - arrow_head_size, arrow_bend_y + arrow_head_size);
+	AppendSVGPaint(out, "fill", GetColorU32(ImGuiKeyboardCol_KeyLabel));
+	out->append("/>\n");
+
+	ImU32 overlay_colors[2];
+	GetKeyOverlayColors(ImGuiKey_Enter, flags, overlay_colors);
+	for (int i = 0; i < 2; i++) {
+		if (overlay_colors[i] != 0) {
+			AppendSVGISOEnterPath(out, shape, ImVec2(0.0f, 0.0f));
+			AppendSVGPaint(out, "fill", overlay_colors[i]);
+			out->append("/>\n");
 		}
 	}
-
-	draw_list->PopClipRect();
+}
+#endif
+
+void WriteGeometrySVG(const ImGuiKeyboardGeometry &geometry, ImGuiTextBuffer *out) {
+	IM_INPUT_TRACE_SCOPE("ImKeyboard::WriteGeometrySVG");
+	const float scale = geometry.FontSize / 13.0f;
+	BoardRows board;
+	CalcBoardRows(&board, geometry.Layout, ImVec2(0.0f, 0.0f), geometry.Style, scale);
+	const DrawSource src = GetGeometryDrawSource(geometry);
+	CurrentDrawSource = &src;
+
+	out->appendf("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\" viewBox=\"0 0 %.2f %.2f\" "
+				 "font-family=\"sans-serif\">\n",
+				 ImCeil(geometry.Size.x), ImCeil(geometry.Size.y), geometry.Size.x, geometry.Size.y);
+	AppendSVGRectFilled(out, ImVec2(0.0f, 0.0f), geometry.Size, geometry.Style.BoardRounding * scale,
+						GetColorU32(ImGuiKeyboardCol_BoardBackground));
+	BoardKeyRow rows[ImGuiKeyboardRow_COUNT + 3];
+	const int row_count = GetBoardKeyRows(board, geometry.Flags, rows);
+	for (int r = 0; r < row_count; r++) {
+		for (int i = 0; i < rows[r].KeyCount; i++) {
+			AppendSVGKey(out, rows[r].Keys[i], rows[r].Pos, board.KeyUnit, scale, geometry.Flags);
+		}
+	}
+#ifndef IMKEYBOARD_DISABLE_ISO
+	if (board.Layout != nullptr && board.Layout->ISO) {
+		AppendSVGISOEnterKey(out, board, geometry.Flags);
+	}
+#endif
+	out->append("</svg>\n");
+	CurrentDrawSource = nullptr;
 }
 
-#ifndef IMGUI_DISABLE_DEMO_WINDOWS
+#ifndef IMKEYBOARD_DISABLE_DEMO
 void KeyboardDemo() {
 	static bool showPressed = true;
+	static bool latchPresses = false;
 	static bool noShiftLabels = false;
 	static bool showBothLabels = false;
 	static bool showIcons = false;
 	static bool noNumpad = false;
 	static bool recordable = false;
+	static bool measureLatency = false;
+	static bool showKeyOwners = false;
+	static bool showKeyTiming = false;
 	static int currentLayout = ImGuiKeyboardLayout_Qwerty;
 	static bool highlightWASD = false;
 	static bool highlightArrows = false;
@@ -1587,6 +3379,9 @@ void KeyboardDemo() {
 	const char *layoutNames[] = {"QWERTY (ANSI)", "QWERTZ (ANSI)", "AZERTY (ANSI)", "Colemak", "Dvorak", "Numeric Pad", "QWERTY (ISO)", "QWERTZ (ISO)", "AZERTY (ISO)", "Apple (ANSI)", "Apple (ISO)"};
 	if (ImGui::BeginCombo("##Layout", layoutNames[currentLayout])) {
 		for (int i = 0; i < ImGuiKeyboardLayout_Count; i++) {
+			if (GetCompiledLayout(i) != i) {
+				continue; // Removed in imgui_keyboard_config.h
+			}
 			const bool isSelected = (currentLayout == i);
 			if (ImGui::Selectable(layoutNames[i], isSelected)) {
 				currentLayout = i;
@@ -1601,6 +3396,10 @@ void KeyboardDemo() {
 	// Flags
 	ImGui::Text("Options:");
 	ImGui::Checkbox("Show Pressed Keys (Red)", &showPressed);
+	if (showPressed) {
+		ImGui::SameLine();
+		ImGui::Checkbox("Latch Short Taps", &latchPresses);
+	}
 	if (ImGui::Checkbox("Show Both Labels (Shift + Normal)", &showBothLabels)) {
 		if (showBothLabels) {
 			noShiftLabels = false; // Disable conflicting option
@@ -1611,11 +3410,46 @@ void KeyboardDemo() {
 			showBothLabels = false; // Disable conflicting option
 		}
 	}
+#ifndef IMKEYBOARD_DISABLE_ICONS
 	ImGui::Checkbox("Show Icons", &showIcons);
+#endif
 	if (currentLayout != ImGuiKeyboardLayout_NumericPad) {
 		ImGui::Checkbox("Hide Numpad", &noNumpad);
 	}
+#ifndef IMKEYBOARD_DISABLE_RECORDING
 	ImGui::Checkbox("Recordable Keys (Blue)", &recordable);
+#endif
+#ifndef IMKEYBOARD_DISABLE_LATENCY
+	ImGui::Checkbox("Measure Latency", &measureLatency);
+	if (measureLatency) {
+		ImGuiKeyboardLatency latency;
+		if (GetKeyLatency(ImGuiKey_None, &latency)) {
+			ImGui::Text("Press to render: p50 %.2f ms | p95 %.2f ms | p99 %.2f ms (%d samples)", latency.P50,
+						latency.P95, latency.P99, latency.Count);
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Reset##Latency")) {
+				ClearLatency();
+			}
+		} else {
+			ImGui::TextDisabled("No samples, the backend has to send keys through ImKeyboard::AddKeyEvent()");
+		}
+	}
+#endif
+#ifndef IMKEYBOARD_DISABLE_KEY_OWNERS
+	ImGui::Checkbox("Show Key Owners and Shortcut Routes (hover a key)", &showKeyOwners);
+#endif
+#ifndef IMKEYBOARD_DISABLE_TIMING
+	if (ImGui::Checkbox("Key Timing Analyzer (hover a key)", &showKeyTiming)) {
+		EnableKeyTiming(showKeyTiming);
+	}
+	if (showKeyTiming) {
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Reset##Timing")) {
+			ClearKeyTiming();
+		}
+		ImGui::TextDisabled("Needs keys sent through ImKeyboard::AddKeyEvent(), keys that chattered are tinted");
+	}
+#endif
 
 	// Show recorded keys when recordable mode is enabled
 	if (recordable) {
@@ -1671,6 +3505,48 @@ void KeyboardDemo() {
 		Highlight(ImGuiKey_Keypad9, highlightNumpad);
 	}
 
+	// Highlight layers, each with its own color
+	static bool showLayers = false;
+	if (ImGui::Checkbox("Highlight Layers (Movement / Abilities / Conflicts)", &showLayers)) {
+		if (FindHighlightLayer("Movement") == -1) {
+			const int movement = AddHighlightLayer("Movement", ImVec4(0.0f, 0.8f, 0.0f, 0.5f), 0);
+			const int abilities = AddHighlightLayer("Abilities", ImVec4(1.0f, 0.5f, 0.0f, 0.5f), 1);
+			const int conflicts = AddHighlightLayer("Conflicts", ImVec4(1.0f, 0.0f, 0.0f, 0.6f), 2);
+			const ImGuiKey movementKeys[] = {ImGuiKey_W, ImGuiKey_A, ImGuiKey_S, ImGuiKey_D, ImGuiKey_Space};
+			const ImGuiKey abilityKeys[] = {ImGuiKey_Q, ImGuiKey_E, ImGuiKey_R, ImGuiKey_F, ImGuiKey_Space};
+			for (int i = 0; i < IM_ARRAYSIZE(movementKeys); i++) {
+				HighlightLayerKey(movement, movementKeys[i], true);
+			}
+			for (int i = 0; i < IM_ARRAYSIZE(abilityKeys); i++) {
+				HighlightLayerKey(abilities, abilityKeys[i], true);
+			}
+			HighlightLayerKey(conflicts, ImGuiKey_Space, true); // Bound twice
+		}
+		const char *layerNames[] = {"Movement", "Abilities", "Conflicts"};
+		for (int i = 0; i < IM_ARRAYSIZE(layerNames); i++) {
+			SetHighlightLayerActive(FindHighlightLayer(layerNames[i]), showLayers);
+		}
+	}
+
+	// Per-key colors: a usage heat map that fades out, updated in place
+	static bool showHeatMap = false;
+	static ImU32 heatColors[ImGuiKey_NamedKey_COUNT];
+	if (ImGui::Checkbox("Key Usage Heat Map", &showHeatMap)) {
+		memset(heatColors, 0, sizeof(heatColors));
+		SetKeyColors(showHeatMap ? heatColors : nullptr, ImGuiKey_NamedKey_COUNT);
+	}
+	if (showHeatMap) {
+		for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+			int heat = (int)(heatColors[k] >> IM_COL32_A_SHIFT);
+			if (ImGui::IsKeyPressed((ImGuiKey)(ImGuiKey_NamedKey_BEGIN + k), false)) {
+				heat = ImMin(heat + 64, 255);
+			} else if (heat > 0 && ImGui::GetFrameCount() % 4 == 0) {
+				heat--;
+			}
+			heatColors[k] = heat > 0 ? IM_COL32(255, 96, 0, heat) : 0;
+		}
+	}
+
 	// Individual key highlight
 	ImGui::Text("Highlight Individual Key:");
 	static int selectedKey = 0;
@@ -1704,6 +3580,13 @@ void KeyboardDemo() {
 		Highlight(keyValues[selectedKey], keyHighlighted);
 	}
 
+	// Text highlight, resolved on the selected layout
+	static char highlightText[64] = "";
+	ImGui::SetNextItemWidth(200.0f);
+	if (ImGui::InputText("Highlight Text", highlightText, IM_ARRAYSIZE(highlightText))) {
+		HighlightText(highlightText);
+	}
+
 	// Clear all highlights button
 	if (ImGui::Button("Clear All Highlights")) {
 		ClearHighlights();
@@ -1711,6 +3594,7 @@ void KeyboardDemo() {
 		highlightArrows = false;
 		highlightNumpad = false;
 		keyHighlighted = false;
+		highlightText[0] = 0;
 	}
 
 	ImGui::Separator();
@@ -1731,6 +3615,8 @@ void KeyboardDemo() {
 			ImGui::SliderFloat2("Key Label Offset", &style.KeyLabelOffset.x, 0.0f, 15.0f, "%.1f");
 			ImGui::SliderFloat("Board Padding", &style.BoardPadding, 0.0f, 20.0f, "%.1f");
 			ImGui::SliderFloat("Board Rounding", &style.BoardRounding, 0.0f, 20.0f, "%.1f");
+			ImGui::SliderFloat("Press Latch Time", &style.PressLatchTime, 0.0f, 1.0f, "%.2f s");
+			ImGui::SliderFloat("Press Fade Time", &style.PressFadeTime, 0.0f, 1.0f, "%.2f s");
 
 			if (ImGui::Button("Reset Sizes")) {
 				ImGuiKeyboardStyle defaultStyle;
@@ -1744,6 +3630,8 @@ void KeyboardDemo() {
 				style.KeyLabelOffset = defaultStyle.KeyLabelOffset;
 				style.BoardPadding = defaultStyle.BoardPadding;
 				style.BoardRounding = defaultStyle.BoardRounding;
+				style.PressLatchTime = defaultStyle.PressLatchTime;
+				style.PressFadeTime = defaultStyle.PressFadeTime;
 			}
 			ImGui::TreePop();
 		}
@@ -1791,9 +3679,23 @@ void KeyboardDemo() {
 	if (recordable) {
 		flags |= ImGuiKeyboardFlags_Recordable;
 	}
+	if (measureLatency) {
+		flags |= ImGuiKeyboardFlags_MeasureLatency;
+	}
+	if (showKeyOwners) {
+		flags |= ImGuiKeyboardFlags_ShowKeyOwners;
+	}
+	if (latchPresses) {
+		flags |= ImGuiKeyboardFlags_LatchPresses;
+	}
+	if (showKeyTiming) {
+		flags |= ImGuiKeyboardFlags_ShowKeyTiming;
+	}
 	Keyboard((ImGuiKeyboardLayout)currentLayout, flags);
+	ImGui::TextDisabled("State hash %08X, %s", GetStateHash(),
+						WantsRedraw() ? "changed" : "unchanged since last frame");
 }
-#endif // IMGUI_DISABLE_DEMO_WINDOWS
+#endif // IMKEYBOARD_DISABLE_DEMO
 #endif // IMGUI_DISABLE
 
 } // namespace ImKeyboard
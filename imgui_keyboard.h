@@ -27,6 +27,8 @@
 #pragma once
 
 #include "imgui.h"
+#include "imgui_keyboard_config.h"
+#include "imgui_input_state.h"
 
 namespace ImKeyboard {
 
@@ -47,6 +49,8 @@ enum ImGuiKeyboardLayout_ {
 };
 typedef int ImGuiKeyboardLayout;
 
+#define IMKEYBOARD_HIGHLIGHT_LAYERS 16 // Maximum number of highlight layers, see AddHighlightLayer()
+
 enum ImGuiKeyboardFlags_ {
 	ImGuiKeyboardFlags_None = 0,
 	ImGuiKeyboardFlags_ShowPressed = 1 << 0,	// Highlight keys that are currently pressed
@@ -55,6 +59,14 @@ enum ImGuiKeyboardFlags_ {
 	ImGuiKeyboardFlags_ShowIcons = 1 << 3,		// Show icons instead of text (Windows logo, arrow triangles)
 	ImGuiKeyboardFlags_NoNumpad = 1 << 4,		// Skip rendering the numeric keypad
 	ImGuiKeyboardFlags_Recordable = 1 << 5,		// Enable key recording for keybinding selection (click or press keys)
+	ImGuiKeyboardFlags_MeasureLatency = 1 << 6, // Measure press-to-render latency of keys sent through AddKeyEvent()
+	ImGuiKeyboardFlags_ShowKeyOwners = 1 << 7,	// Debug: color keys by their ImGui key owner (strong) or shortcut route
+												// (faint), hovering a key names them. Replaces SetKeyColors().
+	ImGuiKeyboardFlags_LatchPresses = 1 << 8,	// With ShowPressed: keep every press seen during a frame visible for at
+												// least Style.PressLatchTime, then fade it out. Taps shorter than a
+												// frame show up too.
+	ImGuiKeyboardFlags_ShowKeyTiming = 1 << 9,	// Hovering a key shows its timing statistics, keys with chatter are
+												// tinted. Needs EnableKeyTiming(), replaces SetKeyColors().
 };
 typedef int ImGuiKeyboardFlags;
 
@@ -75,6 +87,38 @@ enum ImGuiKeyboardCol_ {
 };
 typedef int ImGuiKeyboardCol;
 
+// Rows of the main block that layouts are composed of, see SetLayoutEdits()
+enum ImGuiKeyboardRow_ {
+	ImGuiKeyboardRow_FunctionNav, // Print/Scroll/Pause
+	ImGuiKeyboardRow_Number,
+	ImGuiKeyboardRow_Letters1, // Tab row
+	ImGuiKeyboardRow_Letters2, // Caps Lock row
+	ImGuiKeyboardRow_Letters3, // Shift row
+	ImGuiKeyboardRow_Bottom,   // Modifiers + spacebar
+	ImGuiKeyboardRow_COUNT
+};
+typedef int ImGuiKeyboardRow;
+
+enum ImGuiKeyboardEditOp_ {
+	ImGuiKeyboardEditOp_Set,	// Replace the key at Index
+	ImGuiKeyboardEditOp_Insert, // Insert a key before Index
+	ImGuiKeyboardEditOp_Remove, // Remove the key at Index
+	ImGuiKeyboardEditOp_Width,	// Only change the width of the key at Index
+	ImGuiKeyboardEditOp_COUNT
+};
+typedef int ImGuiKeyboardEditOp;
+
+// Change to a row of a layout. Keys of a row are laid out left to right without gaps, so positions follow from widths.
+struct ImGuiKeyboardKeyEdit {
+	ImGuiKeyboardRow Row;
+	ImGuiKeyboardEditOp Op;
+	int Index;				// Position in the row at the time the edit is applied
+	float Width;			// In key units (1.0 = standard key), unused for Remove
+	const char *Label;		// Unused for Remove and Width
+	const char *ShiftLabel; // Label when Shift is pressed (nullptr if same as Label)
+	ImGuiKey Key;
+};
+
 // Style struct for keyboard appearance
 struct ImGuiKeyboardStyle {
 	// Sizes (in pixels, before scaling)
@@ -89,18 +133,141 @@ struct ImGuiKeyboardStyle {
 	float BoardPadding;		 // Padding around keyboard (default: 5.0f)
 	float BoardRounding;	 // Board corner rounding (default: 5.0f)
 
+	// Press latching (in seconds), see ImGuiKeyboardFlags_LatchPresses
+	float PressLatchTime; // Minimum time a press stays drawn (default: 0.1f)
+	float PressFadeTime;  // Fade-out after PressLatchTime, 0 for none (default: 0.15f)
+
 	// Colors
 	ImVec4 Colors[ImGuiKeyboardCol_COUNT];
 
 	ImGuiKeyboardStyle();
 };
 
+// Timing statistics of the presses of a key sent through AddKeyEvent(), in milliseconds
+struct ImGuiKeyboardKeyTiming {
+	int PressCount;
+	int ChatterCount;  // Presses that followed the previous press of the key within the chatter window
+	float HoldP50;	   // Press to release
+	float HoldP99;
+	float IntervalP50; // Press to the next press of the key
+	float IntervalP99;
+};
+
+// Press-to-render latency percentiles of the last samples, in milliseconds
+struct ImGuiKeyboardLatency {
+	int Count; // Number of samples the percentiles are computed from
+	float P50;
+	float P95;
+	float P99;
+};
+
+// Board geometry that can be built on worker threads, e.g. for dashboards with many keyboards:
+// - PrepareGeometry() on the UI thread captures everything the board is drawn from,
+// - BuildGeometry() on any thread generates the vertices into a private draw list,
+// - DrawGeometry() on the UI thread copies them into the window like Keyboard() would draw them.
+// Builds only read the captured state, the layout tables and the font atlas, so they have to be done before the next
+// ImGui::NewFrame() or SetLayoutEdits(). Recording and the latency probe need the UI thread, their flags are ignored.
+// Building and drawing are supported with Dear ImGui up to 1.91, whose font atlas is static. With 1.92 and later they
+// aren't compiled (see IMKEYBOARD_DISABLE_GEOMETRY in imgui_keyboard_config.h), PrepareGeometry() and
+// WriteGeometrySVG() only need the font metrics and stay available.
+struct ImGuiKeyboardGeometry {
+	ImGuiKeyboardLayout Layout;
+	ImGuiKeyboardFlags Flags;
+	ImInputState Input; // Keys are drawn pressed from this snapshot
+	ImGuiKeyboardStyle Style;
+	ImU8 KeyHighlights[ImGuiKey_NamedKey_COUNT];	  // Non-zero for Highlight() and HighlightText() keys
+	ImU16 KeyLayerBits[ImGuiKey_NamedKey_COUNT];	  // Active highlight layers of each key, the highest bit wins
+	ImU32 LayerColors[IMKEYBOARD_HIGHLIGHT_LAYERS]; // Color of each bit of KeyLayerBits
+	ImU32 KeyFaceColors[ImGuiKey_NamedKey_COUNT];	// SetKeyColors() blended over the face color
+	int KeyFaceColorCount;
+	ImU16 KeyCounts[ImGuiKey_NamedKey_COUNT]; // SetKeyCounts() snapshot
+	int KeyCountCount;
+	ImU8 KeyPressAlphas[ImGuiKey_NamedKey_COUNT]; // Latched presses for ImGuiKeyboardFlags_LatchPresses
+	ImVector<ImGuiKey> RecordedKeys;
+	ImFont *Font;
+	float FontSize;
+	float FontAscent;				  // Baseline offset of a line at FontSize
+	ImVec2 Size;					  // Board size
+	ImDrawListSharedData *SharedData; // Copy of the ImGui one, so builds don't race with ImGui::NewFrame()
+	ImDrawList *DrawList;			  // Built at (0, 0)
+
+	ImGuiKeyboardGeometry();
+	~ImGuiKeyboardGeometry();
+};
+
 ImGuiKeyboardStyle &GetStyle();
 void Highlight(ImGuiKey key, bool highlight);
+// Highlight layers color keys independently of Highlight(), e.g. movement in green and conflicts in red at the same
+// time. Where layers overlap, the active layer with the highest priority colors the key (the lower id on ties).
+// Highlight() and pressed keys are drawn over the layers. Returns the layer id, or -1 if all layers are in use.
+int AddHighlightLayer(const char *name, const ImVec4 &color, int priority = 0);
+void RemoveHighlightLayer(int layer);
+int FindHighlightLayer(const char *name); // -1 if not found
+void SetHighlightLayerColor(int layer, const ImVec4 &color);
+void SetHighlightLayerPriority(int layer, int priority);
+void SetHighlightLayerActive(int layer, bool active); // Inactive layers keep their keys but aren't drawn
+void HighlightLayerKey(int layer, ImGuiKey key, bool highlight);
+void ClearHighlightLayer(int layer);
 void ClearHighlights();
+// Highlight the keys that type a UTF-8 text on the layout passed to Keyboard(), including Shift for characters that
+// need it. Characters the layout doesn't have are skipped, nullptr clears the text. ClearHighlights() clears it too.
+void HighlightText(const char *utf8);
+// Key that types a Unicode code point on a layout, and whether it needs Shift. Returns false if no key has it.
+bool FindKeyForChar(ImGuiKeyboardLayout layout, unsigned int codepoint, ImGuiKey *out_key, bool *out_shift = nullptr);
 void ClearRecorded();
 const ImVector<ImGuiKey> &GetRecordedKeys();
+// Render pressed keys from an input state instead of the ImGui input (e.g. another process, see imgui_input_mirror.h).
+// The state must stay valid until Keyboard() returns, nullptr switches back to the ImGui input. Recording always uses
+// the ImGui input.
+void SetInputState(const ImInputState *state);
+// Face colors computed by the application (cooldowns, heat maps, ...), indexed by key - ImGuiKey_NamedKey_BEGIN. Each
+// color is blended over the KeyFace color by its alpha, 0 leaves the key as is. The array isn't copied: Keyboard()
+// reads it every frame, so it must stay valid until it's replaced. nullptr clears the colors.
+void SetKeyColors(const ImU32 *colors_by_key, int count);
+// Numbers drawn in the corner of the keys (e.g. actions bound to them, see imgui_keyboard_bindings.h), indexed like
+// SetKeyColors() and read every frame the same way. 0 draws nothing, nullptr clears the counts.
+void SetKeyCounts(const ImU16 *counts_by_key, int count);
+// Extra edits applied after the built-in edits of a layout, e.g. loaded from a file (see imgui_keyboard_reload.h).
+// The edits are copied but the label strings must stay valid. Edits that don't fit the row are skipped, passing no
+// edits restores the built-in layout.
+void SetLayoutEdits(ImGuiKeyboardLayout layout, const ImGuiKeyboardKeyEdit *edits, int edit_count);
+// Latency probe: call instead of ImGuiIO::AddKeyEvent() in the platform backend, it forwards the event and timestamps
+// presses. Keyboard() with ImGuiKeyboardFlags_MeasureLatency then adds a draw callback after the pressed overlay of
+// the key, which takes the second timestamp when the renderer processes it. Also feeds the key timing analyzer.
+void AddKeyEvent(ImGuiKey key, bool down);
+// Latency of a key, or of all keys for ImGuiKey_None. Returns false if there are no samples yet.
+bool GetKeyLatency(ImGuiKey key, ImGuiKeyboardLatency *out_latency);
+void ClearLatency();
+// For headless runs without a renderer backend: runs the latency probe callbacks of the draw data like a renderer
+// would, call it after ImGui::Render().
+void ProcessLatencyCallbacks(const ImDrawData *draw_data);
+// Key timing analyzer for keyboard hardware QA. While enabled, AddKeyEvent() also records the hold times and the
+// intervals between presses of each key in log-bucket histograms (fixed memory, O(1) per event, percentiles within
+// 12.5%) and counts chatter: presses closer to the previous press of the key than chatter_window_ms, e.g. a bouncing
+// switch. Disabling frees the statistics.
+void EnableKeyTiming(bool enable, float chatter_window_ms = 5.0f);
+// Statistics of a key, false if the analyzer is disabled or the key wasn't pressed yet
+bool GetKeyTiming(ImGuiKey key, ImGuiKeyboardKeyTiming *out_timing);
+void ClearKeyTiming();
 void Keyboard(ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags = 0);
+// Change detection for applications that only render when something changed: every Keyboard() call folds what it
+// draws (layout, flags, scale, style, pressed, highlighted and recorded keys, layers, key colors) into a hash of the
+// frame, boards that aren't visible don't count. After the last Keyboard() of a frame, WantsRedraw() tells whether
+// the hash differs from the previous frame with boards.
+ImGuiID GetStateHash();
+bool WantsRedraw();
+// See ImGuiKeyboardGeometry. Input defaults to the input Keyboard() would use (SetInputState() or ImGui).
+void PrepareGeometry(ImGuiKeyboardGeometry *geometry, ImGuiKeyboardLayout layout, ImGuiKeyboardFlags flags = 0,
+					 const ImInputState *input = nullptr);
+#ifndef IMKEYBOARD_DISABLE_GEOMETRY
+void BuildGeometry(ImGuiKeyboardGeometry *geometry);
+void DrawGeometry(const ImGuiKeyboardGeometry &geometry);
+#endif
+// Appends the board of a prepared geometry as an SVG document, on any thread like BuildGeometry(). Keys are rounded
+// rects with text labels, icons are written as their text label. See imgui_keyboard_export.h for files and batches.
+void WriteGeometrySVG(const ImGuiKeyboardGeometry &geometry, ImGuiTextBuffer *out);
+#ifndef IMKEYBOARD_DISABLE_DEMO
 void KeyboardDemo();
+#endif
 
 } // namespace ImKeyboard
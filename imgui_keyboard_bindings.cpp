@@ -0,0 +1,353 @@
+#include "imgui_keyboard_bindings.h"
+
+#ifndef IMGUI_DISABLE
+
+#include "imgui_internal.h"
+
+#include <string.h>
+
+// Named key index of the key part of a chord, -1 if it has none
+static int GetChordKeyIndex(ImGuiKeyChord chord) {
+	const ImGuiKey key = (ImGuiKey)(chord & ~ImGuiMod_Mask_);
+	return ImGui::IsNamedKey(key) ? key - ImGuiKey_NamedKey_BEGIN : -1;
+}
+
+static ImU32 HashChord(ImGuiKeyChord chord) {
+	const ImU32 h = (ImU32)chord * 0x9E3779B1u; // Chords differ in the low key bits and the high modifier bits
+	return h ^ (h >> 16);
+}
+
+static ImGuiKeyChord GetModifierFlag(ImGuiKey key) {
+	switch (key) {
+	case ImGuiKey_LeftCtrl:
+	case ImGuiKey_RightCtrl:
+		return ImGuiMod_Ctrl;
+	case ImGuiKey_LeftShift:
+	case ImGuiKey_RightShift:
+		return ImGuiMod_Shift;
+	case ImGuiKey_LeftAlt:
+	case ImGuiKey_RightAlt:
+		return ImGuiMod_Alt;
+	case ImGuiKey_LeftSuper:
+	case ImGuiKey_RightSuper:
+		return ImGuiMod_Super;
+	default:
+		return 0;
+	}
+}
+
+ImKeyboardBindings::ImKeyboardBindings() {
+	SlotsUsed = 0;
+	ConflictCount = 0;
+	BoundLayer = ConflictLayer = -1;
+	BoundColor = ImVec4(0.0f, 0.6f, 1.0f, 0.35f);
+	ConflictColor = ImVec4(1.0f, 0.0f, 0.0f, 0.6f);
+	for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+		KeyDirty[k] = false;
+	}
+	Clear();
+}
+
+ImKeyboardBindings::~ImKeyboardBindings() {
+	HideFromKeyboard();
+}
+
+void ImKeyboardBindings::Clear() {
+	// Keys that had actions have to be cleared from the layers, on top of the keys still pending from SetBinding()
+	for (int i = 0; i < Actions.Size; i++) {
+		const int key_index = GetChordKeyIndex(Actions[i].Chord);
+		if (key_index != -1) {
+			MarkKeyDirty(key_index);
+		}
+	}
+	Actions.clear();
+	Names.clear();
+	Slots.clear();
+	SlotsUsed = 0;
+	ConflictCount = 0;
+	for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+		KeyHeads[k] = -1;
+	}
+	memset(KeyCounts, 0, sizeof(KeyCounts));
+	memset(KeyConflicts, 0, sizeof(KeyConflicts));
+}
+
+void ImKeyboardBindings::Reserve(int action_count) {
+	Actions.reserve(action_count);
+	int capacity = 16;
+	while (capacity * 3 < action_count * 4) {
+		capacity *= 2;
+	}
+	if (capacity > Slots.Size) {
+		Rehash(capacity);
+	}
+}
+
+int ImKeyboardBindings::AddAction(const char *name, ImGuiKeyChord chord) {
+	Action action;
+	action.Chord = 0;
+	action.Name = Names.Size;
+	action.ChordPrev = action.ChordNext = action.KeyPrev = action.KeyNext = -1;
+	const int len = (int)strlen(name) + 1;
+	Names.resize(Names.Size + len);
+	memcpy(Names.Data + action.Name, name, len);
+	Actions.push_back(action);
+	SetBinding(Actions.Size - 1, chord);
+	return Actions.Size - 1;
+}
+
+const char *ImKeyboardBindings::GetActionName(int action) const {
+	return Names.Data + Actions[action].Name;
+}
+
+ImGuiKeyChord ImKeyboardBindings::GetBinding(int action) const {
+	return Actions[action].Chord;
+}
+
+void ImKeyboardBindings::SetBinding(int action, ImGuiKeyChord chord) {
+	IM_ASSERT(action >= 0 && action < Actions.Size);
+	if (Actions[action].Chord == chord) {
+		return;
+	}
+	Unlink(action);
+	Actions[action].Chord = chord;
+	Link(action);
+}
+
+bool ImKeyboardBindings::BindFromRecorded(int action) {
+	const ImVector<ImGuiKey> &keys = ImKeyboard::GetRecordedKeys();
+	ImGuiKeyChord mods = 0;
+	ImGuiKey key = ImGuiKey_None;
+	ImGuiKey mod_key = ImGuiKey_None;
+	for (int i = 0; i < keys.Size; i++) {
+		const ImGuiKeyChord mod = GetModifierFlag(keys[i]);
+		if (mod != 0) {
+			mods |= mod;
+			mod_key = keys[i];
+		} else if (key == ImGuiKey_None) {
+			key = keys[i];
+		} else {
+			return false; // Two non-modifier keys
+		}
+	}
+	if (key == ImGuiKey_None) {
+		if (mod_key == ImGuiKey_None || (mods & (mods - 1)) != 0) {
+			return false; // Nothing recorded, or several modifiers without a key
+		}
+		SetBinding(action, mod_key);
+		return true;
+	}
+	SetBinding(action, mods | key);
+	return true;
+}
+
+int ImKeyboardBindings::GetChordActionCount(ImGuiKeyChord chord) const {
+	const int slot = FindSlot(chord);
+	return slot != -1 ? Slots[slot].Count : 0;
+}
+
+int ImKeyboardBindings::GetFirstChordAction(ImGuiKeyChord chord) const {
+	const int slot = FindSlot(chord);
+	return slot != -1 ? Slots[slot].Head : -1;
+}
+
+int ImKeyboardBindings::GetNextChordAction(int action) const {
+	return Actions[action].ChordNext;
+}
+
+int ImKeyboardBindings::GetKeyActionCount(ImGuiKey key) const {
+	return ImGui::IsNamedKey(key) ? KeyCounts[key - ImGuiKey_NamedKey_BEGIN] : 0;
+}
+
+int ImKeyboardBindings::GetFirstKeyAction(ImGuiKey key) const {
+	return ImGui::IsNamedKey(key) ? KeyHeads[key - ImGuiKey_NamedKey_BEGIN] : -1;
+}
+
+int ImKeyboardBindings::GetNextKeyAction(int action) const {
+	return Actions[action].KeyNext;
+}
+
+bool ImKeyboardBindings::IsConflicting(int action) const {
+	return Actions[action].Chord != 0 && GetChordActionCount(Actions[action].Chord) > 1;
+}
+
+void ImKeyboardBindings::ShowOnKeyboard() {
+	if (BoundLayer == -1) {
+		BoundLayer = ImKeyboard::AddHighlightLayer("Bindings", BoundColor, 0);
+		ConflictLayer = ImKeyboard::AddHighlightLayer("Binding Conflicts", ConflictColor, 1);
+		IM_ASSERT(BoundLayer != -1 && ConflictLayer != -1 && "No free highlight layers");
+		for (int k = 0; k < ImGuiKey_NamedKey_COUNT; k++) {
+			if (KeyCounts[k] != 0) {
+				MarkKeyDirty(k);
+			}
+		}
+	}
+	ImKeyboard::SetKeyCounts(KeyCounts, ImGuiKey_NamedKey_COUNT);
+	for (int i = 0; i < DirtyKeys.Size; i++) {
+		const int k = DirtyKeys[i];
+		const ImGuiKey key = (ImGuiKey)(ImGuiKey_NamedKey_BEGIN + k);
+		ImKeyboard::HighlightLayerKey(BoundLayer, key, KeyCounts[k] != 0);
+		ImKeyboard::HighlightLayerKey(ConflictLayer, key, KeyConflicts[k] != 0);
+		KeyDirty[k] = false;
+	}
+	DirtyKeys.clear();
+}
+
+void ImKeyboardBindings::HideFromKeyboard() {
+	if (BoundLayer == -1) {
+		return;
+	}
+	ImKeyboard::RemoveHighlightLayer(BoundLayer);
+	ImKeyboard::RemoveHighlightLayer(ConflictLayer);
+	ImKeyboard::SetKeyCounts(nullptr, 0);
+	BoundLayer = ConflictLayer = -1;
+	for (int i = 0; i < DirtyKeys.Size; i++) {
+		KeyDirty[DirtyKeys[i]] = false;
+	}
+	DirtyKeys.clear();
+}
+
+int ImKeyboardBindings::FindSlot(ImGuiKeyChord chord) const {
+	if (chord == 0 || Slots.Size == 0) {
+		return -1;
+	}
+	const int mask = Slots.Size - 1;
+	for (int i = (int)HashChord(chord) & mask;; i = (i + 1) & mask) {
+		if (Slots[i].Chord == chord) {
+			return i;
+		}
+		if (Slots[i].Chord == 0) {
+			return -1;
+		}
+	}
+}
+
+int ImKeyboardBindings::AddSlot(ImGuiKeyChord chord) {
+	IM_ASSERT(chord != 0);
+	if ((SlotsUsed + 1) * 4 > Slots.Size * 3) {
+		Rehash(ImMax(16, Slots.Size));
+	}
+	const int mask = Slots.Size - 1;
+	int i = (int)HashChord(chord) & mask;
+	while (Slots[i].Chord != 0 && Slots[i].Chord != chord) {
+		i = (i + 1) & mask;
+	}
+	if (Slots[i].Chord == 0) {
+		Slots[i].Chord = chord;
+		Slots[i].Head = -1;
+		Slots[i].Count = 0;
+		SlotsUsed++;
+	}
+	return i;
+}
+
+// Drops the chords nobody uses, doubling the capacity until at most half of it is used so inserts stay amortized O(1)
+void ImKeyboardBindings::Rehash(int capacity) {
+	ImVector<ChordSlot> old_slots;
+	old_slots.swap(Slots);
+	int live = 0;
+	for (int i = 0; i < old_slots.Size; i++) {
+		live += old_slots[i].Count > 0 ? 1 : 0;
+	}
+	while ((live + 1) * 2 > capacity) {
+		capacity *= 2;
+	}
+	Slots.resize(capacity);
+	memset(Slots.Data, 0, sizeof(ChordSlot) * capacity);
+	SlotsUsed = 0;
+	const int mask = capacity - 1;
+	for (int n = 0; n < old_slots.Size; n++) {
+		if (old_slots[n].Count == 0) {
+			continue;
+		}
+		int i = (int)HashChord(old_slots[n].Chord) & mask;
+		while (Slots[i].Chord != 0) {
+			i = (i + 1) & mask;
+		}
+		Slots[i] = old_slots[n];
+		SlotsUsed++;
+	}
+}
+
+void ImKeyboardBindings::Link(int action) {
+	Action &a = Actions[action];
+	if (a.Chord == 0) {
+		return;
+	}
+	ChordSlot &slot = Slots[AddSlot(a.Chord)];
+	a.ChordPrev = -1;
+	a.ChordNext = slot.Head;
+	if (slot.Head != -1) {
+		Actions[slot.Head].ChordPrev = action;
+	}
+	slot.Head = action;
+	slot.Count++;
+	if (slot.Count == 2) {
+		ConflictCount++;
+	}
+
+	const int key_index = GetChordKeyIndex(a.Chord);
+	if (key_index == -1) {
+		return;
+	}
+	a.KeyPrev = -1;
+	a.KeyNext = KeyHeads[key_index];
+	if (a.KeyNext != -1) {
+		Actions[a.KeyNext].KeyPrev = action;
+	}
+	KeyHeads[key_index] = action;
+	KeyCounts[key_index]++;
+	if (slot.Count == 2) {
+		KeyConflicts[key_index]++;
+	}
+	MarkKeyDirty(key_index);
+}
+
+void ImKeyboardBindings::Unlink(int action) {
+	Action &a = Actions[action];
+	if (a.Chord == 0) {
+		return;
+	}
+	ChordSlot &slot = Slots[FindSlot(a.Chord)];
+	if (a.ChordPrev != -1) {
+		Actions[a.ChordPrev].ChordNext = a.ChordNext;
+	} else {
+		slot.Head = a.ChordNext;
+	}
+	if (a.ChordNext != -1) {
+		Actions[a.ChordNext].ChordPrev = a.ChordPrev;
+	}
+	a.ChordPrev = a.ChordNext = -1;
+	slot.Count--;
+	if (slot.Count == 1) {
+		ConflictCount--;
+	}
+
+	const int key_index = GetChordKeyIndex(a.Chord);
+	if (key_index == -1) {
+		return;
+	}
+	if (a.KeyPrev != -1) {
+		Actions[a.KeyPrev].KeyNext = a.KeyNext;
+	} else {
+		KeyHeads[key_index] = a.KeyNext;
+	}
+	if (a.KeyNext != -1) {
+		Actions[a.KeyNext].KeyPrev = a.KeyPrev;
+	}
+	a.KeyPrev = a.KeyNext = -1;
+	KeyCounts[key_index]--;
+	if (slot.Count == 1) {
+		KeyConflicts[key_index]--;
+	}
+	MarkKeyDirty(key_index);
+}
+
+void ImKeyboardBindings::MarkKeyDirty(int key_index) {
+	if (!KeyDirty[key_index]) {
+		KeyDirty[key_index] = true;
+		DirtyKeys.push_back(key_index);
+	}
+}
+
+#endif // IMGUI_DISABLE
@@ -0,0 +1,123 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Keybinding table indexed by chord and by key, for games and tools with hundreds or thousands of bindable actions.
+//
+// Every action has at most one chord (a key with ImGuiMod_ flags, 0 when unbound). Lookups of the actions using a
+// chord or a key are O(1): a hash table maps chords to intrusive lists of their actions, and every named key has a list
+// of the actions whose chord ends on it. SetBinding() relinks one action and updates the per-key counts and conflicts
+// (chords used by more than one action) in constant time, so rebinding from the recorder never rescans the table.
+//
+// ShowOnKeyboard() puts the table on ImKeyboard::Keyboard(): bound keys and keys with conflicting chords go to two
+// highlight layers and the number of actions on each key is drawn in its corner (ImKeyboard::SetKeyCounts()). Only
+// the keys changed since the previous call are pushed to the layers.
+//
+// Usage:
+//
+//   ImKeyboardBindings bindings;
+//   int jump = bindings.AddAction("Jump", ImGuiKey_Space);
+//   bindings.AddAction("Save", ImGuiMod_Ctrl | ImGuiKey_S);
+//   // once per frame, before ImKeyboard::Keyboard()
+//   bindings.ShowOnKeyboard();
+//   // after the user recorded a new chord with ImGuiKeyboardFlags_Recordable
+//   bindings.BindFromRecorded(jump);
+//
+//   for (int action = bindings.GetFirstChordAction(chord); action != -1; action = bindings.GetNextChordAction(action))
+
+#include "imgui.h"
+#include "imgui_keyboard.h"
+
+struct ImKeyboardBindings {
+	struct Action {
+		ImGuiKeyChord Chord; // 0 when unbound
+		int Name;			 // Offset into Names
+		int ChordPrev, ChordNext; // Actions with the same chord, -1 at the ends
+		int KeyPrev, KeyNext;	  // Actions whose chord ends on the same key, -1 at the ends
+	};
+	// Open addressing slot. Slots of chords nobody uses anymore keep their chord until the table is rehashed.
+	struct ChordSlot {
+		ImGuiKeyChord Chord; // 0 for an empty slot
+		int Head;			 // First action, -1 if none
+		int Count;
+	};
+
+	ImVector<Action> Actions;
+	ImVector<char> Names;
+	ImVector<ChordSlot> Slots; // Power of two size
+	int SlotsUsed;			   // Slots with a chord, including unused chords
+	int ConflictCount;		   // Chords used by more than one action
+	int KeyHeads[ImGuiKey_NamedKey_COUNT];
+	ImU16 KeyCounts[ImGuiKey_NamedKey_COUNT];	 // Actions ending on each key, passed to ImKeyboard::SetKeyCounts()
+	ImU16 KeyConflicts[ImGuiKey_NamedKey_COUNT]; // Conflicting chords ending on each key
+	ImVector<int> DirtyKeys;					 // Named key indices changed since the last ShowOnKeyboard()
+	bool KeyDirty[ImGuiKey_NamedKey_COUNT];
+	int BoundLayer;	   // Highlight layers created by ShowOnKeyboard(), -1 before
+	int ConflictLayer;
+	ImVec4 BoundColor; // Colors of the layers, set before the first ShowOnKeyboard()
+	ImVec4 ConflictColor;
+
+	ImKeyboardBindings();
+	// Removes the highlight layers and the key counts if shown
+	~ImKeyboardBindings();
+	void Clear();
+	void Reserve(int action_count);
+	// Returns the action id, ids are given out in order starting at 0. The name is copied.
+	int AddAction(const char *name, ImGuiKeyChord chord = 0);
+	const char *GetActionName(int action) const;
+	ImGuiKeyChord GetBinding(int action) const;
+	// Rebinds an action, 0 unbinds it. Constant time.
+	void SetBinding(int action, ImGuiKeyChord chord);
+	// Binds the chord recorded on the keyboard (ImKeyboard::GetRecordedKeys()): modifiers become ImGuiMod_ flags of
+	// the one other key, a lone modifier is bound as a key. Returns false if the recorded keys aren't a single chord.
+	bool BindFromRecorded(int action);
+
+	// Actions using a chord, -1 at the end
+	int GetChordActionCount(ImGuiKeyChord chord) const;
+	int GetFirstChordAction(ImGuiKeyChord chord) const;
+	int GetNextChordAction(int action) const;
+	// Actions whose chord ends on a key with any modifiers, -1 at the end
+	int GetKeyActionCount(ImGuiKey key) const;
+	int GetFirstKeyAction(ImGuiKey key) const;
+	int GetNextKeyAction(int action) const;
+	bool IsConflicting(int action) const; // Another action uses the same chord
+	int GetConflictCount() const {
+		return ConflictCount;
+	}
+
+	// Shows the table on ImKeyboard::Keyboard() until HideFromKeyboard(), call once per frame before it
+	void ShowOnKeyboard();
+	void HideFromKeyboard();
+
+	// Internal
+	int FindSlot(ImGuiKeyChord chord) const; // -1 if the chord has no slot
+	int AddSlot(ImGuiKeyChord chord);
+	void Rehash(int capacity);
+	void Link(int action);
+	void Unlink(int action);
+	void MarkKeyDirty(int key_index);
+};
@@ -0,0 +1,84 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Compile-time configuration of the keyboard, mouse and gamepad widgets, like imconfig.h for Dear ImGui.
+// Set the switches below on the command line, or put them into an own header and point IMKEYBOARD_USER_CONFIG to it:
+//   #define IMKEYBOARD_USER_CONFIG "my_imkeyboard_config.h"
+// Everything is enabled by default. Disabled features are removed with the preprocessor, not skipped at runtime.
+//-----------------------------------------------------------------------------
+
+#ifdef IMKEYBOARD_USER_CONFIG
+#include IMKEYBOARD_USER_CONFIG
+#endif
+
+//---- Keyboard layouts, a disabled layout renders as ImGuiKeyboardLayout_Qwerty
+//#define IMKEYBOARD_DISABLE_QWERTZ  // ImGuiKeyboardLayout_Qwertz and ImGuiKeyboardLayout_QwertzISO
+//#define IMKEYBOARD_DISABLE_AZERTY  // ImGuiKeyboardLayout_Azerty and ImGuiKeyboardLayout_AzertyISO
+//#define IMKEYBOARD_DISABLE_COLEMAK // ImGuiKeyboardLayout_Colemak
+//#define IMKEYBOARD_DISABLE_DVORAK  // ImGuiKeyboardLayout_Dvorak
+//#define IMKEYBOARD_DISABLE_ISO     // All ISO variants and the L-shaped Enter key
+//#define IMKEYBOARD_DISABLE_APPLE   // ImGuiKeyboardLayout_AppleANSI and ImGuiKeyboardLayout_AppleISO
+
+//---- Features
+//#define IMKEYBOARD_DISABLE_ICONS     // ImGuiKeyboardFlags_ShowIcons is ignored, no icon painters
+//#define IMKEYBOARD_DISABLE_RECORDING // The Recordable flags of all widgets are ignored
+//#define IMKEYBOARD_DISABLE_LATENCY   // ImGuiKeyboardFlags_MeasureLatency is ignored, AddKeyEvent() only forwards
+//#define IMKEYBOARD_DISABLE_KEY_OWNERS // ImGuiKeyboardFlags_ShowKeyOwners is ignored
+//#define IMKEYBOARD_DISABLE_TIMING    // No key timing analyzer, ImGuiKeyboardFlags_ShowKeyTiming is ignored
+//#define IMKEYBOARD_DISABLE_KEY_MESHES // Key bodies are drawn with ImDrawList::AddRect*() instead of as meshes
+//#define IMKEYBOARD_DISABLE_GEOMETRY  // No Build/DrawGeometry() and PNG export, implied by Dear ImGui 1.92 and later
+//#define IMKEYBOARD_DISABLE_DEMO      // No *Demo() functions, implied by IMGUI_DISABLE_DEMO_WINDOWS
+//#define IMKEYBOARD_DISABLE_MOUSE     // Compile imgui_mouse.cpp to nothing
+//#define IMKEYBOARD_DISABLE_GAMEPAD   // Compile imgui_gamepad.cpp to nothing
+
+//---- Derived switches, don't set these directly
+#if defined(IMGUI_DISABLE_DEMO_WINDOWS) && !defined(IMKEYBOARD_DISABLE_DEMO)
+#define IMKEYBOARD_DISABLE_DEMO
+#endif
+#if !defined(IMKEYBOARD_DISABLE_QWERTZ) && !defined(IMKEYBOARD_DISABLE_ISO)
+#define IMKEYBOARD_HAS_QWERTZ_ISO
+#endif
+#if !defined(IMKEYBOARD_DISABLE_AZERTY) && !defined(IMKEYBOARD_DISABLE_ISO)
+#define IMKEYBOARD_HAS_AZERTY_ISO
+#endif
+#if !defined(IMKEYBOARD_DISABLE_APPLE) && !defined(IMKEYBOARD_DISABLE_ISO)
+#define IMKEYBOARD_HAS_APPLE_ISO
+#endif
+#if !defined(IMKEYBOARD_DISABLE_KEY_OWNERS) || !defined(IMKEYBOARD_DISABLE_TIMING)
+#define IMKEYBOARD_HAS_KEY_TOOLTIPS // Hovered keys are looked up for a tooltip
+#endif
+#if !defined(IMKEYBOARD_DISABLE_RECORDING) || defined(IMKEYBOARD_HAS_KEY_TOOLTIPS)
+#define IMKEYBOARD_HAS_KEY_HIT_TEST // Boards keep the key rects for mouse hit tests
+#endif
+// Geometry builds draw text on worker threads, which needs the static font atlas of Dear ImGui up to 1.91: all glyphs
+// baked by ImFontAtlas::Build() and one fixed TexID. The dynamic atlas of 1.92 bakes glyphs and swaps textures while
+// drawing, from the UI thread only. SVG export only needs the font metrics and works with any version.
+#if defined(IMGUI_VERSION_NUM) && IMGUI_VERSION_NUM >= 19200 && !defined(IMKEYBOARD_DISABLE_GEOMETRY)
+#define IMKEYBOARD_DISABLE_GEOMETRY
+#endif
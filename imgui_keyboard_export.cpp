@@ -0,0 +1,527 @@
+#include "imgui_keyboard_export.h"
+
+#ifndef IMGUI_DISABLE
+
+#include "imgui_internal.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+struct ImKeyboardExporter::Job {
+	char *Path;
+	bool IsSVG;
+	bool Failed; // Set by the worker that took the job
+	ImKeyboard::ImGuiKeyboardGeometry Geometry;
+	const unsigned char *AtlasPixels; // Alpha8 font atlas for PNG files
+	int AtlasWidth;
+	int AtlasHeight;
+
+	Job() : Path(nullptr), IsSVG(false), Failed(false), AtlasPixels(nullptr), AtlasWidth(0), AtlasHeight(0) {
+	}
+	~Job() {
+		IM_FREE(Path);
+	}
+};
+
+namespace ImKeyboardExport {
+
+typedef ImKeyboardExporter::Job Job;
+
+// Buffers of a worker thread, reused by all its jobs
+struct Scratch {
+	ImVector<float> Pixels; // Premultiplied RGBA
+	ImVector<unsigned char> Scanlines;
+	ImVector<unsigned char> Deflated;
+	ImVector<unsigned char> File;
+	ImGuiTextBuffer Text;
+	ImVector<int> HashHeads;
+	ImVector<int> HashChain;
+};
+
+#ifndef IMKEYBOARD_DISABLE_GEOMETRY
+struct Canvas {
+	float *Pixels;
+	int Width;
+	int Height;
+	const unsigned char *Atlas;
+	int AtlasWidth;
+	int AtlasHeight;
+};
+
+// Edge function of a -> b at p, positive on the left side in y-down coordinates. Always evaluated from the lower end
+// of the edge, so two triangles sharing an edge get exactly opposite values and the top-left rule can split it.
+static float EdgeFunction(const ImVec2 &a, const ImVec2 &b, float px, float py) {
+	if (a.y < b.y || (a.y == b.y && a.x < b.x)) {
+		return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+	}
+	return -((a.x - b.x) * (py - b.y) - (a.y - b.y) * (px - b.x));
+}
+
+// Pixels exactly on an edge belong to the triangle only for top and left edges
+static bool IsTopLeftEdge(const ImVec2 &a, const ImVec2 &b) {
+	return (a.y == b.y && b.x > a.x) || b.y < a.y;
+}
+
+// Narrows [*x_min, *x_max] to the pixels of the row at py whose centers are on the inner side of the edge a -> b,
+// with a pixel of margin against rounding: the span only skips pixels, the edge functions decide. False if the whole
+// row is outside.
+static bool ClipRowToEdge(const ImVec2 &a, const ImVec2 &b, float py, float *x_min, float *x_max) {
+	const float dy = b.y - a.y;
+	const float c = (b.x - a.x) * (py - a.y);
+	if (dy == 0.0f) {
+		return c >= 0.0f;
+	}
+	const float x = a.x + c / dy - 0.5f; // Pixel with its center on the edge
+	if (dy > 0.0f) {
+		*x_max = ImMin(*x_max, x + 1.0f);
+	} else {
+		*x_min = ImMax(*x_min, x - 1.0f);
+	}
+	return *x_min <= *x_max;
+}
+
+static ImVec4 UnpackColor(ImU32 col) {
+	const float s = 1.0f / 255.0f;
+	return ImVec4(((col >> IM_COL32_R_SHIFT) & 0xFF) * s, ((col >> IM_COL32_G_SHIFT) & 0xFF) * s,
+				  ((col >> IM_COL32_B_SHIFT) & 0xFF) * s, ((col >> IM_COL32_A_SHIFT) & 0xFF) * s);
+}
+
+// Samples pixel centers like a GPU: colors and UVs interpolated, nearest atlas texel, blended over premultiplied
+static void RasterizeTriangle(Canvas *canvas, const ImDrawVert *v0, const ImDrawVert *v1, const ImDrawVert *v2,
+							  int clip_min_x, int clip_min_y, int clip_max_x, int clip_max_y) {
+	float area = EdgeFunction(v0->pos, v1->pos, v2->pos.x, v2->pos.y);
+	if (area == 0.0f) {
+		return;
+	}
+	if (area < 0.0f) {
+		ImSwap(v1, v2);
+		area = -area;
+	}
+	const ImVec2 &p0 = v0->pos;
+	const ImVec2 &p1 = v1->pos;
+	const ImVec2 &p2 = v2->pos;
+	const int min_x = ImMax((int)ImFloor(ImMin(ImMin(p0.x, p1.x), p2.x)), clip_min_x);
+	const int min_y = ImMax((int)ImFloor(ImMin(ImMin(p0.y, p1.y), p2.y)), clip_min_y);
+	const int max_x = ImMin((int)ImCeil(ImMax(ImMax(p0.x, p1.x), p2.x)), clip_max_x);
+	const int max_y = ImMin((int)ImCeil(ImMax(ImMax(p0.y, p1.y), p2.y)), clip_max_y);
+	if (min_x >= max_x || min_y >= max_y) {
+		return;
+	}
+	const bool top_left0 = IsTopLeftEdge(p1, p2);
+	const bool top_left1 = IsTopLeftEdge(p2, p0);
+	const bool top_left2 = IsTopLeftEdge(p0, p1);
+	const ImVec4 c0 = UnpackColor(v0->col);
+	const ImVec4 c1 = UnpackColor(v1->col);
+	const ImVec4 c2 = UnpackColor(v2->col);
+	const float inv_area = 1.0f / area;
+
+	for (int y = min_y; y < max_y; y++) {
+		const float py = y + 0.5f;
+		// Fans of large shapes have long thin triangles, don't test the whole bounding box
+		float span_min = (float)min_x;
+		float span_max = (float)(max_x - 1);
+		if (!ClipRowToEdge(p1, p2, py, &span_min, &span_max) || !ClipRowToEdge(p2, p0, py, &span_min, &span_max) ||
+			!ClipRowToEdge(p0, p1, py, &span_min, &span_max)) {
+			continue;
+		}
+		const int x_begin = (int)ImFloor(span_min);
+		const int x_end = (int)ImFloor(span_max) + 1;
+		float *dst = canvas->Pixels + ((size_t)y * canvas->Width + x_begin) * 4;
+		for (int x = x_begin; x < x_end; x++, dst += 4) {
+			const float px = x + 0.5f;
+			const float w0 = EdgeFunction(p1, p2, px, py);
+			const float w1 = EdgeFunction(p2, p0, px, py);
+			const float w2 = EdgeFunction(p0, p1, px, py);
+			if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f || (w0 == 0.0f && !top_left0) || (w1 == 0.0f && !top_left1) ||
+				(w2 == 0.0f && !top_left2)) {
+				continue;
+			}
+			const float b0 = w0 * inv_area;
+			const float b1 = w1 * inv_area;
+			const float b2 = w2 * inv_area;
+			const float u = b0 * v0->uv.x + b1 * v1->uv.x + b2 * v2->uv.x;
+			const float v = b0 * v0->uv.y + b1 * v1->uv.y + b2 * v2->uv.y;
+			const int tx = ImClamp((int)(u * canvas->AtlasWidth), 0, canvas->AtlasWidth - 1);
+			const int ty = ImClamp((int)(v * canvas->AtlasHeight), 0, canvas->AtlasHeight - 1);
+			const float texel = canvas->Atlas[ty * canvas->AtlasWidth + tx] * (1.0f / 255.0f);
+			const float a = (b0 * c0.w + b1 * c1.w + b2 * c2.w) * texel;
+			if (a <= 0.0f) {
+				continue;
+			}
+			const float keep = 1.0f - a;
+			dst[0] = (b0 * c0.x + b1 * c1.x + b2 * c2.x) * a + dst[0] * keep;
+			dst[1] = (b0 * c0.y + b1 * c1.y + b2 * c2.y) * a + dst[1] * keep;
+			dst[2] = (b0 * c0.z + b1 * c1.z + b2 * c2.z) * a + dst[2] * keep;
+			dst[3] = a + dst[3] * keep;
+		}
+	}
+}
+
+static void RasterizeDrawList(Canvas *canvas, const ImDrawList &draw_list) {
+	for (int i = 0; i < draw_list.CmdBuffer.Size; i++) {
+		const ImDrawCmd &cmd = draw_list.CmdBuffer[i];
+		if (cmd.UserCallback != nullptr || cmd.ElemCount == 0) {
+			continue;
+		}
+		// Scissor rect in whole pixels, like the renderer backends
+		const int clip_min_x = ImMax((int)cmd.ClipRect.x, 0);
+		const int clip_min_y = ImMax((int)cmd.ClipRect.y, 0);
+		const int clip_max_x = ImMin((int)cmd.ClipRect.z, canvas->Width);
+		const int clip_max_y = ImMin((int)cmd.ClipRect.w, canvas->Height);
+		const ImDrawVert *vtx = draw_list.VtxBuffer.Data + cmd.VtxOffset;
+		const ImDrawIdx *idx = draw_list.IdxBuffer.Data + cmd.IdxOffset;
+		for (unsigned int n = 0; n + 2 < cmd.ElemCount; n += 3) {
+			RasterizeTriangle(canvas, &vtx[idx[n]], &vtx[idx[n + 1]], &vtx[idx[n + 2]], clip_min_x, clip_min_y,
+							  clip_max_x, clip_max_y);
+		}
+	}
+}
+
+static const unsigned short deflate_length_base[29] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,  15,  17,  19,  23, 27,
+													   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const unsigned char deflate_length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+													   2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const unsigned short deflate_distance_base[30] = {1,    2,    3,    4,    5,    7,    9,    13,    17,    25,
+														 33,   49,   65,   97,   129,  193,  257,  385,   513,   769,
+														 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const unsigned char deflate_distance_extra[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+														 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+struct BitWriter {
+	ImVector<unsigned char> *Out;
+	ImU32 Bits;
+	int BitCount;
+};
+
+// Deflate packs values from the least significant bit
+static void WriteBits(BitWriter *writer, ImU32 value, int count) {
+	writer->Bits |= value << writer->BitCount;
+	writer->BitCount += count;
+	while (writer->BitCount >= 8) {
+		writer->Out->push_back((unsigned char)(writer->Bits & 0xFF));
+		writer->Bits >>= 8;
+		writer->BitCount -= 8;
+	}
+}
+
+// Huffman codes go from the most significant bit
+static void WriteCode(BitWriter *writer, ImU32 code, int length) {
+	ImU32 reversed = 0;
+	for (int i = 0; i < length; i++) {
+		reversed |= ((code >> i) & 1) << (length - 1 - i);
+	}
+	WriteBits(writer, reversed, length);
+}
+
+// Fixed Huffman code of a literal/length symbol
+static void WriteSymbol(BitWriter *writer, int symbol) {
+	if (symbol < 144) {
+		WriteCode(writer, 0x30 + symbol, 8);
+	} else if (symbol < 256) {
+		WriteCode(writer, 0x190 + symbol - 144, 9);
+	} else if (symbol < 280) {
+		WriteCode(writer, symbol - 256, 7);
+	} else {
+		WriteCode(writer, 0xC0 + symbol - 280, 8);
+	}
+}
+
+static void WriteMatch(BitWriter *writer, int length, int distance) {
+	int l = IM_ARRAYSIZE(deflate_length_base) - 1;
+	while (deflate_length_base[l] > length) {
+		l--;
+	}
+	WriteSymbol(writer, 257 + l);
+	WriteBits(writer, length - deflate_length_base[l], deflate_length_extra[l]);
+	int d = IM_ARRAYSIZE(deflate_distance_base) - 1;
+	while (deflate_distance_base[d] > distance) {
+		d--;
+	}
+	WriteCode(writer, d, 5);
+	WriteBits(writer, distance - deflate_distance_base[d], deflate_distance_extra[d]);
+}
+
+static int Hash3(const unsigned char *p) {
+	return (int)(((ImU32)p[0] | ((ImU32)p[1] << 8) | ((ImU32)p[2] << 16)) * 2654435761u >> 17);
+}
+
+// zlib stream with a single fixed Huffman block. Keyboard images are mostly flat colors, which LZ77 with short hash
+// chains already shrinks well, so there are no dynamic Huffman tables.
+static void Deflate(const unsigned char *data, int size, Scratch *scratch, ImVector<unsigned char> *out) {
+	const int window_size = 32768;
+	const int max_match = 258;
+	const int max_chain = 16;
+	const int max_insert = 32;
+	ImVector<int> &heads = scratch->HashHeads;
+	ImVector<int> &chain = scratch->HashChain;
+	heads.resize(1 << 15);
+	chain.resize(window_size);
+	memset(heads.Data, 0xFF, sizeof(int) * heads.Size);
+
+	out->push_back(0x78); // 32K window, no dictionary
+	out->push_back(0x01);
+	BitWriter writer = {out, 0, 0};
+	WriteBits(&writer, 1, 1); // Last block
+	WriteBits(&writer, 1, 2); // Fixed Huffman codes
+	int pos = 0;
+	while (pos < size) {
+		int best_length = 0;
+		int best_distance = 0;
+		if (pos + 3 <= size) {
+			const int max_length = ImMin(max_match, size - pos);
+			int candidate = heads[Hash3(data + pos)];
+			for (int steps = 0; candidate >= 0 && pos - candidate <= window_size && steps < max_chain; steps++) {
+				int length = 0;
+				while (length < max_length && data[candidate + length] == data[pos + length]) {
+					length++;
+				}
+				if (length > best_length) {
+					best_length = length;
+					best_distance = pos - candidate;
+					if (length == max_length) {
+						break;
+					}
+				}
+				candidate = chain[candidate & (window_size - 1)];
+			}
+		}
+		const int advance = best_length >= 3 ? best_length : 1;
+		const int end = pos + advance;
+		if (advance > 1) {
+			WriteMatch(&writer, best_length, best_distance);
+		} else {
+			WriteSymbol(&writer, data[pos]);
+		}
+		// Like zlib's fast mode, long matches only hash their start: they are runs of flat color, which the next
+		// search finds again anyway
+		const int hash_end = ImMin(advance > max_insert ? pos + 1 : pos + advance, size - 2);
+		for (; pos < hash_end; pos++) {
+			int &head = heads[Hash3(data + pos)];
+			chain[pos & (window_size - 1)] = head;
+			head = pos;
+		}
+		pos = end;
+	}
+	WriteSymbol(&writer, 256); // End of block
+	if (writer.BitCount > 0) {
+		out->push_back((unsigned char)(writer.Bits & 0xFF));
+	}
+
+	ImU32 a = 1, b = 0;
+	for (int i = 0; i < size;) {
+		// The sums can't overflow in 5552 bytes, as in zlib
+		for (const int block_end = ImMin(i + 5552, size); i < block_end; i++) {
+			a += data[i];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+	const ImU32 adler = (b << 16) | a;
+	for (int shift = 24; shift >= 0; shift -= 8) {
+		out->push_back((unsigned char)(adler >> shift));
+	}
+}
+
+struct CRCTable {
+	ImU32 Values[256];
+
+	CRCTable() {
+		for (ImU32 n = 0; n < 256; n++) {
+			ImU32 c = n;
+			for (int k = 0; k < 8; k++) {
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			}
+			Values[n] = c;
+		}
+	}
+};
+
+static void AppendU32BE(ImVector<unsigned char> *out, ImU32 value) {
+	for (int shift = 24; shift >= 0; shift -= 8) {
+		out->push_back((unsigned char)(value >> shift));
+	}
+}
+
+static void AppendPNGChunk(ImVector<unsigned char> *out, const char *type, const unsigned char *data, int size) {
+	static const CRCTable crc_table;
+	AppendU32BE(out, (ImU32)size);
+	const int crc_begin = out->Size;
+	out->resize(out->Size + 4 + size);
+	memcpy(out->Data + crc_begin, type, 4);
+	if (size > 0) {
+		memcpy(out->Data + crc_begin + 4, data, (size_t)size);
+	}
+	ImU32 crc = 0xFFFFFFFFu;
+	for (int i = crc_begin; i < out->Size; i++) {
+		crc = crc_table.Values[(crc ^ out->Data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	AppendU32BE(out, crc ^ 0xFFFFFFFFu);
+}
+
+// 8-bit RGBA, straight alpha
+static void EncodePNG(const Canvas &canvas, Scratch *scratch, ImVector<unsigned char> *out) {
+	ImVector<unsigned char> &scanlines = scratch->Scanlines;
+	scanlines.resize(canvas.Height * (1 + canvas.Width * 4));
+	unsigned char *write = scanlines.Data;
+	const float *read = canvas.Pixels;
+	for (int y = 0; y < canvas.Height; y++) {
+		*write++ = 0; // No filter
+		for (int x = 0; x < canvas.Width; x++, read += 4, write += 4) {
+			const float a = ImSaturate(read[3]);
+			const float inv_a = a > 0.0f ? 1.0f / a : 0.0f;
+			write[0] = (unsigned char)(ImSaturate(read[0] * inv_a) * 255.0f + 0.5f);
+			write[1] = (unsigned char)(ImSaturate(read[1] * inv_a) * 255.0f + 0.5f);
+			write[2] = (unsigned char)(ImSaturate(read[2] * inv_a) * 255.0f + 0.5f);
+			write[3] = (unsigned char)(a * 255.0f + 0.5f);
+		}
+	}
+	scratch->Deflated.resize(0);
+	Deflate(scanlines.Data, scanlines.Size, scratch, &scratch->Deflated);
+
+	static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	out->resize(0);
+	for (int i = 0; i < IM_ARRAYSIZE(signature); i++) {
+		out->push_back(signature[i]);
+	}
+	unsigned char header[13];
+	for (int i = 0; i < 4; i++) {
+		header[i] = (unsigned char)((ImU32)canvas.Width >> (24 - i * 8));
+		header[4 + i] = (unsigned char)((ImU32)canvas.Height >> (24 - i * 8));
+	}
+	header[8] = 8;	// Bits per channel
+	header[9] = 6;	// RGBA
+	header[10] = 0; // Deflate
+	header[11] = 0; // Adaptive filtering
+	header[12] = 0; // Not interlaced
+	AppendPNGChunk(out, "IHDR", header, IM_ARRAYSIZE(header));
+	AppendPNGChunk(out, "IDAT", scratch->Deflated.Data, scratch->Deflated.Size);
+	AppendPNGChunk(out, "IEND", nullptr, 0);
+}
+#endif // IMKEYBOARD_DISABLE_GEOMETRY
+
+static bool WriteFile(const char *path, const void *data, size_t size) {
+	FILE *file = fopen(path, "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	const bool ok = fwrite(data, 1, size, file) == size;
+	return fclose(file) == 0 && ok;
+}
+
+static bool ExportJob(Job *job, Scratch *scratch) {
+	if (job->IsSVG) {
+		scratch->Text.clear();
+		ImKeyboard::WriteGeometrySVG(job->Geometry, &scratch->Text);
+		return WriteFile(job->Path, scratch->Text.begin(), (size_t)scratch->Text.size());
+	}
+
+#ifdef IMKEYBOARD_DISABLE_GEOMETRY
+	return false; // Add() only takes SVG files
+#else
+	ImKeyboard::BuildGeometry(&job->Geometry);
+	Canvas canvas;
+	canvas.Width = ImMax((int)ImCeil(job->Geometry.Size.x), 1);
+	canvas.Height = ImMax((int)ImCeil(job->Geometry.Size.y), 1);
+	scratch->Pixels.resize(canvas.Width * canvas.Height * 4);
+	memset(scratch->Pixels.Data, 0, sizeof(float) * scratch->Pixels.Size);
+	canvas.Pixels = scratch->Pixels.Data;
+	canvas.Atlas = job->AtlasPixels;
+	canvas.AtlasWidth = job->AtlasWidth;
+	canvas.AtlasHeight = job->AtlasHeight;
+	RasterizeDrawList(&canvas, *job->Geometry.DrawList);
+	job->Geometry.DrawList->_ClearFreeMemory(); // Batches can hold thousands of boards
+	EncodePNG(canvas, scratch, &scratch->File);
+	return WriteFile(job->Path, scratch->File.Data, (size_t)scratch->File.Size);
+#endif
+}
+
+static void ExportWorker(ImVector<Job *> *jobs, std::atomic<int> *next_job) {
+	Scratch scratch;
+	for (int i = next_job->fetch_add(1); i < jobs->Size; i = next_job->fetch_add(1)) {
+		Job *job = (*jobs)[i];
+		job->Failed = !ExportJob(job, &scratch);
+	}
+}
+
+} // namespace ImKeyboardExport
+
+using namespace ImKeyboardExport;
+
+ImKeyboardExporter::ImKeyboardExporter() {
+	Error[0] = '\0';
+}
+
+ImKeyboardExporter::~ImKeyboardExporter() {
+	Clear();
+}
+
+bool ImKeyboardExporter::Add(const char *path, ImKeyboard::ImGuiKeyboardLayout layout,
+							 ImKeyboard::ImGuiKeyboardFlags flags, const ImInputState *input) {
+	const char *ext = strrchr(path, '.');
+	const bool is_svg = ext != nullptr && ImStricmp(ext, ".svg") == 0;
+	if (!is_svg && (ext == nullptr || ImStricmp(ext, ".png") != 0)) {
+		ImFormatString(Error, sizeof(Error), "%s: unknown file type, use .png or .svg", path);
+		return false;
+	}
+#ifdef IMKEYBOARD_DISABLE_GEOMETRY
+	if (!is_svg) {
+		ImFormatString(Error, sizeof(Error), "%s: PNG files need Dear ImGui up to 1.91, use .svg", path);
+		return false;
+	}
+#endif
+	Job *job = IM_NEW(Job)();
+	job->Path = ImStrdup(path);
+	job->IsSVG = is_svg;
+	ImKeyboard::PrepareGeometry(&job->Geometry, layout, flags, input);
+#ifndef IMKEYBOARD_DISABLE_GEOMETRY
+	if (!is_svg) {
+		// Builds the atlas if needed, which the workers can't do
+		unsigned char *pixels = nullptr;
+		job->Geometry.Font->ContainerAtlas->GetTexDataAsAlpha8(&pixels, &job->AtlasWidth, &job->AtlasHeight);
+		job->AtlasPixels = pixels;
+	}
+#endif
+	Jobs.push_back(job);
+	return true;
+}
+
+int ImKeyboardExporter::Run(int thread_count) {
+	Error[0] = '\0';
+	if (thread_count <= 0) {
+		thread_count = (int)std::thread::hardware_concurrency();
+	}
+	thread_count = ImClamp(thread_count, 1, ImMax(Jobs.Size, 1));
+
+	// The calling thread is one of the workers
+	std::atomic<int> next_job(0);
+	ImVector<std::thread *> threads;
+	for (int i = 1; i < thread_count; i++) {
+		threads.push_back(new std::thread(ExportWorker, &Jobs, &next_job));
+	}
+	ExportWorker(&Jobs, &next_job);
+	for (int i = 0; i < threads.Size; i++) {
+		threads[i]->join();
+		delete threads[i];
+	}
+
+	int failed = 0;
+	for (int i = 0; i < Jobs.Size; i++) {
+		if (Jobs[i]->Failed && failed++ == 0) {
+			ImFormatString(Error, sizeof(Error), "%s: can't write file", Jobs[i]->Path);
+		}
+	}
+	Clear();
+	return failed;
+}
+
+void ImKeyboardExporter::Clear() {
+	for (int i = 0; i < Jobs.Size; i++) {
+		IM_DELETE(Jobs[i]);
+	}
+	Jobs.clear();
+}
+
+#endif // IMGUI_DISABLE
@@ -0,0 +1,83 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Headless export of keyboards to PNG and SVG files, e.g. keymap sheets for documentation or per-device QA reports.
+//
+// Add() snapshots a board on the UI thread with ImKeyboard::PrepareGeometry(): layout, flags, input, highlights,
+// key colors and counts, style and font. Run() then builds and writes all the added boards on a pool of threads and
+// needs neither a GPU nor a renderer backend. The file extension picks the format:
+//
+// - .png: the board draw list of ImKeyboard::BuildGeometry() rasterized on the CPU with the alpha8 font atlas, at
+//   the font size of the snapshot. Outside of the board is transparent.
+// - .svg: ImKeyboard::WriteGeometrySVG(), rounded rects and text which scale to any size. Icons are written as
+//   their text labels.
+//
+// PNG files need Dear ImGui up to 1.91 like BuildGeometry(). With IMKEYBOARD_DISABLE_GEOMETRY (implied by 1.92 and
+// later) Add() rejects them and only SVG files are written.
+//
+// ImGui only has to be initialized far enough for PrepareGeometry(), e.g. in a command line tool:
+//
+//   ImGui::CreateContext();
+//   ImGui::GetIO().DisplaySize = ImVec2(1920, 1080);
+//   ImGui::GetIO().Fonts->Build();
+//   ImGui::NewFrame();
+//   ImKeyboardExporter exporter;
+//   for (int i = 0; i < sheet_count; i++) {
+//       ImKeyboard::ClearHighlights();
+//       ImKeyboard::HighlightText(sheets[i].Text);
+//       exporter.Add(sheets[i].Path, ImGuiKeyboardLayout_Qwerty, 0, &sheets[i].Input);
+//   }
+//   if (exporter.Run() > 0) {
+//       fprintf(stderr, "%s\n", exporter.GetError());
+//   }
+//   ImGui::EndFrame();
+//   ImGui::DestroyContext();
+
+#include "imgui.h"
+#include "imgui_keyboard.h"
+
+struct ImKeyboardExporter {
+	struct Job; // Defined in imgui_keyboard_export.cpp
+
+	ImVector<Job *> Jobs;
+	char Error[256]; // Why the last Add() failed, or the first file the last Run() couldn't write
+
+	ImKeyboardExporter();
+	~ImKeyboardExporter();
+	// Snapshots a board to write to path, UI thread only. Input defaults to the input Keyboard() would use. Returns
+	// false if the extension is neither .png nor .svg.
+	bool Add(const char *path, ImKeyboard::ImGuiKeyboardLayout layout, ImKeyboard::ImGuiKeyboardFlags flags = 0,
+			 const ImInputState *input = nullptr);
+	// Writes the added boards on thread_count threads, 0 for one per hardware thread, and removes them. Blocks until
+	// all files are written and returns the number of files that failed.
+	int Run(int thread_count = 0);
+	void Clear();
+	const char *GetError() const {
+		return Error;
+	}
+};
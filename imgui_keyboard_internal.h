@@ -0,0 +1,74 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Helpers shared by the implementation files of the widgets, not part of the API
+
+#include "imgui.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // _BitScanReverse, _BitScanForward
+#endif
+
+namespace ImKeyboard {
+
+// Index of the highest set bit of a non-zero mask
+static inline int FindHighestBit(ImU32 mask) {
+#if defined(__GNUC__) || defined(__clang__)
+	return 31 - __builtin_clz(mask);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse(&index, mask);
+	return (int)index;
+#else
+	int bit = 0;
+	while (mask >>= 1) {
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+// Index of the lowest set bit of a non-zero mask
+static inline int FindLowestBit(ImU32 mask) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (int)index;
+#else
+	int bit = 0;
+	while ((mask & 1) == 0) {
+		mask >>= 1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+} // namespace ImKeyboard
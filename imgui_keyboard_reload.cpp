@@ -0,0 +1,575 @@
+#include "imgui_keyboard_reload.h"
+
+#ifndef IMGUI_DISABLE
+
+#include "imgui_internal.h"
+
+#include <atomic>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <thread>
+#include <unistd.h>
+#define IMKEYBOARD_RELOAD_INOTIFY
+#endif
+
+namespace ImKeyboardReload {
+
+using namespace ImKeyboard;
+
+// Result of parsing a file on the watcher thread. Strings are offsets into Strings so the buffer can grow while
+// parsing, Update() resolves them (and the key names, which need ImGui) on the main thread.
+struct ParsedFile {
+	struct Edit {
+		ImGuiKeyboardRow Row;
+		ImGuiKeyboardEditOp Op;
+		int Index;
+		float Width;
+		int Label;		// Offset into Strings, -1 for nullptr
+		int ShiftLabel; // Offset into Strings, -1 for nullptr
+		int KeyName;	// Offset into Strings
+	};
+
+	bool Ok;
+	char Error[256];
+	ImGuiKeyboardStyle Style;
+	ImGuiKeyboardLayout Layout;
+	ImVector<Edit> Edits;
+	ImVector<char> Strings;
+	ImVector<ImGuiKeyboardKeyEdit> KeyEdits; // Resolved Edits, set by Update()
+
+	ParsedFile() : Ok(false), Layout(-1) {
+		Error[0] = '\0';
+	}
+};
+
+} // namespace ImKeyboardReload
+
+using namespace ImKeyboardReload;
+
+struct ImKeyboardReloader::File {
+	char Path[512];
+	const char *Name; // File name part of Path, as reported by inotify
+	bool IsStyle;
+	int WatchId;
+	std::atomic<ParsedFile *> Pending; // Published by the watcher thread, taken by Update()
+	ParsedFile *Active;				   // Applied layout file, owns the labels passed to SetLayoutEdits()
+	char Error[256];
+
+	File() : Name(nullptr), IsStyle(false), WatchId(-1), Pending(nullptr), Active(nullptr) {
+		Path[0] = Error[0] = '\0';
+	}
+};
+
+namespace ImKeyboardReload {
+
+struct NamedValue {
+	const char *Name;
+	int Value;
+};
+
+static const NamedValue layout_names[] = {
+	{"Qwerty", ImGuiKeyboardLayout_Qwerty},			{"Qwertz", ImGuiKeyboardLayout_Qwertz},
+	{"Azerty", ImGuiKeyboardLayout_Azerty},			{"Colemak", ImGuiKeyboardLayout_Colemak},
+	{"Dvorak", ImGuiKeyboardLayout_Dvorak},			{"QwertyISO", ImGuiKeyboardLayout_QwertyISO},
+	{"QwertzISO", ImGuiKeyboardLayout_QwertzISO},	{"AzertyISO", ImGuiKeyboardLayout_AzertyISO},
+	{"AppleANSI", ImGuiKeyboardLayout_AppleANSI},	{"AppleISO", ImGuiKeyboardLayout_AppleISO},
+};
+
+static const NamedValue row_names[] = {
+	{"FunctionNav", ImGuiKeyboardRow_FunctionNav}, {"Number", ImGuiKeyboardRow_Number},
+	{"Letters1", ImGuiKeyboardRow_Letters1},	   {"Letters2", ImGuiKeyboardRow_Letters2},
+	{"Letters3", ImGuiKeyboardRow_Letters3},	   {"Bottom", ImGuiKeyboardRow_Bottom},
+};
+
+static const NamedValue edit_op_names[] = {
+	{"set", ImGuiKeyboardEditOp_Set},
+	{"insert", ImGuiKeyboardEditOp_Insert},
+	{"remove", ImGuiKeyboardEditOp_Remove},
+	{"width", ImGuiKeyboardEditOp_Width},
+};
+
+static const NamedValue color_names[] = {
+	{"BoardBackground", ImGuiKeyboardCol_BoardBackground},
+	{"KeyBackground", ImGuiKeyboardCol_KeyBackground},
+	{"KeyBorder", ImGuiKeyboardCol_KeyBorder},
+	{"KeyFaceBorder", ImGuiKeyboardCol_KeyFaceBorder},
+	{"KeyFace", ImGuiKeyboardCol_KeyFace},
+	{"KeyLabel", ImGuiKeyboardCol_KeyLabel},
+	{"KeyPressed", ImGuiKeyboardCol_KeyPressed},
+	{"KeyHighlighted", ImGuiKeyboardCol_KeyHighlighted},
+	{"KeyPressedHighlighted", ImGuiKeyboardCol_KeyPressedHighlighted},
+	{"KeyRecorded", ImGuiKeyboardCol_KeyRecorded},
+};
+
+// Float fields of ImGuiKeyboardStyle, ImVec2 fields take two values
+static const struct StyleVar {
+	const char *Name;
+	size_t Offset;
+	int Count;
+} style_vars[] = {
+	{"KeyUnit", offsetof(ImGuiKeyboardStyle, KeyUnit), 1},
+	{"SectionGap", offsetof(ImGuiKeyboardStyle, SectionGap), 1},
+	{"KeyBorderSize", offsetof(ImGuiKeyboardStyle, KeyBorderSize), 1},
+	{"KeyRounding", offsetof(ImGuiKeyboardStyle, KeyRounding), 1},
+	{"KeyFaceRounding", offsetof(ImGuiKeyboardStyle, KeyFaceRounding), 1},
+	{"KeyFaceBorderSize", offsetof(ImGuiKeyboardStyle, KeyFaceBorderSize), 1},
+	{"KeyFaceOffset", offsetof(ImGuiKeyboardStyle, KeyFaceOffset), 2},
+	{"KeyLabelOffset", offsetof(ImGuiKeyboardStyle, KeyLabelOffset), 2},
+	{"BoardPadding", offsetof(ImGuiKeyboardStyle, BoardPadding), 1},
+	{"BoardRounding", offsetof(ImGuiKeyboardStyle, BoardRounding), 1},
+	{"PressLatchTime", offsetof(ImGuiKeyboardStyle, PressLatchTime), 1},
+	{"PressFadeTime", offsetof(ImGuiKeyboardStyle, PressFadeTime), 1},
+};
+
+static bool FindNamedValue(const NamedValue *values, int count, const char *name, int *out_value) {
+	for (int i = 0; i < count; i++) {
+		if (strcmp(values[i].Name, name) == 0) {
+			*out_value = values[i].Value;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Splits a line into whitespace separated tokens in place. Quoted tokens may contain spaces, \" and \\ are
+// unescaped. Returns false for an unterminated quote.
+static bool Tokenize(char *line, char **tokens, bool *quoted, int max_tokens, int *out_count) {
+	int count = 0;
+	char *p = line;
+	for (;;) {
+		while (*p == ' ' || *p == '\t' || *p == '\r') {
+			p++;
+		}
+		if (*p == '\0' || *p == '#') {
+			break;
+		}
+		if (count == max_tokens) {
+			return false;
+		}
+		quoted[count] = *p == '"';
+		if (quoted[count]) {
+			char *dst = ++p;
+			tokens[count] = dst;
+			while (*p != '"') {
+				if (*p == '\0') {
+					return false;
+				}
+				if (*p == '\\' && (p[1] == '"' || p[1] == '\\')) {
+					p++;
+				}
+				*dst++ = *p++;
+			}
+			p++;
+			*dst = '\0';
+		} else {
+			tokens[count] = p;
+			while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r') {
+				p++;
+			}
+			if (*p != '\0') {
+				*p++ = '\0';
+			}
+		}
+		count++;
+	}
+	*out_count = count;
+	return true;
+}
+
+static bool ParseFloat(const char *str, float *out_value) {
+	char *end = nullptr;
+	*out_value = strtof(str, &end);
+	return end != str && *end == '\0';
+}
+
+static bool ParseInt(const char *str, int *out_value) {
+	char *end = nullptr;
+	const long value = strtol(str, &end, 10);
+	*out_value = (int)value;
+	return end != str && *end == '\0' && value >= 0 && value <= 127;
+}
+
+static int AddString(ParsedFile &parsed, const char *str) {
+	const int offset = parsed.Strings.Size;
+	const int len = (int)strlen(str) + 1;
+	parsed.Strings.resize(offset + len);
+	memcpy(parsed.Strings.Data + offset, str, (size_t)len);
+	return offset;
+}
+
+// Label token of an edit, a bare - means nullptr
+static int AddLabel(ParsedFile &parsed, const char *token, bool quoted) {
+	if (!quoted && strcmp(token, "-") == 0) {
+		return -1;
+	}
+	return AddString(parsed, token);
+}
+
+static const char *ParseStyleLine(ParsedFile &parsed, char **tokens, int count) {
+	if (strcmp(tokens[0], "Color") == 0) {
+		int col;
+		if (count != 6 || !FindNamedValue(color_names, IM_ARRAYSIZE(color_names), tokens[1], &col)) {
+			return "expected Color <name> <r> <g> <b> <a>";
+		}
+		float *dst = &parsed.Style.Colors[col].x;
+		for (int i = 0; i < 4; i++) {
+			if (!ParseFloat(tokens[2 + i], &dst[i])) {
+				return "invalid color component";
+			}
+		}
+		return nullptr;
+	}
+	for (int i = 0; i < IM_ARRAYSIZE(style_vars); i++) {
+		const StyleVar &var = style_vars[i];
+		if (strcmp(var.Name, tokens[0]) != 0) {
+			continue;
+		}
+		if (count != 1 + var.Count) {
+			return var.Count == 1 ? "expected one value" : "expected two values";
+		}
+		float *dst = (float *)((char *)&parsed.Style + var.Offset);
+		for (int n = 0; n < var.Count; n++) {
+			if (!ParseFloat(tokens[1 + n], &dst[n])) {
+				return "invalid number";
+			}
+		}
+		return nullptr;
+	}
+	return "unknown style variable";
+}
+
+static const char *ParseLayoutLine(ParsedFile &parsed, char **tokens, const bool *quoted, int count) {
+	if (strcmp(tokens[0], "layout") == 0) {
+		if (parsed.Layout != -1) {
+			return "layout is set twice";
+		}
+		if (count != 2 || !FindNamedValue(layout_names, IM_ARRAYSIZE(layout_names), tokens[1], &parsed.Layout)) {
+			return "expected layout <name>";
+		}
+		return nullptr;
+	}
+	int op;
+	if (!FindNamedValue(edit_op_names, IM_ARRAYSIZE(edit_op_names), tokens[0], &op)) {
+		return "unknown command";
+	}
+	if (parsed.Layout == -1) {
+		return "edit before layout";
+	}
+	static const int op_token_counts[ImGuiKeyboardEditOp_COUNT] = {7, 7, 3, 4};
+	static const char *op_usages[ImGuiKeyboardEditOp_COUNT] = {
+		"expected set <row> <index> <width> <label> <shift label> <key>",
+		"expected insert <row> <index> <width> <label> <shift label> <key>",
+		"expected remove <row> <index>",
+		"expected width <row> <index> <width>",
+	};
+	ParsedFile::Edit edit = {0, op, 0, 0.0f, -1, -1, -1};
+	if (count != op_token_counts[op] || !FindNamedValue(row_names, IM_ARRAYSIZE(row_names), tokens[1], &edit.Row) ||
+		!ParseInt(tokens[2], &edit.Index)) {
+		return op_usages[op];
+	}
+	if (op != ImGuiKeyboardEditOp_Remove && (!ParseFloat(tokens[3], &edit.Width) || edit.Width <= 0.0f)) {
+		return "invalid key width";
+	}
+	if (op == ImGuiKeyboardEditOp_Set || op == ImGuiKeyboardEditOp_Insert) {
+		edit.Label = AddLabel(parsed, tokens[4], quoted[4]);
+		edit.ShiftLabel = AddLabel(parsed, tokens[5], quoted[5]);
+		edit.KeyName = AddString(parsed, tokens[6]);
+	}
+	parsed.Edits.push_back(edit);
+	return nullptr;
+}
+
+// Runs on the watcher thread
+static ParsedFile *ParseFile(const ImKeyboardReloader::File &file) {
+	ParsedFile *parsed = IM_NEW(ParsedFile)();
+	FILE *fp = fopen(file.Path, "rb");
+	if (fp == nullptr) {
+		ImFormatString(parsed->Error, sizeof(parsed->Error), "%s: can't open file", file.Path);
+		return parsed;
+	}
+	char line[1024];
+	char *tokens[8];
+	bool quoted[8];
+	const char *error = nullptr;
+	int line_number = 0;
+	while (error == nullptr && fgets(line, sizeof(line), fp) != nullptr) {
+		line_number++;
+		line[strcspn(line, "\n")] = '\0';
+		int count = 0;
+		if (!Tokenize(line, tokens, quoted, IM_ARRAYSIZE(tokens), &count)) {
+			error = "malformed line";
+		} else if (count > 0) {
+			error = file.IsStyle ? ParseStyleLine(*parsed, tokens, count)
+								 : ParseLayoutLine(*parsed, tokens, quoted, count);
+		}
+	}
+	fclose(fp);
+	if (error == nullptr && !file.IsStyle && parsed->Layout == -1) {
+		error = "missing layout";
+	}
+	if (error != nullptr) {
+		ImFormatString(parsed->Error, sizeof(parsed->Error), "%s:%d: %s", file.Path, line_number, error);
+	} else {
+		parsed->Ok = true;
+	}
+	return parsed;
+}
+
+static void Publish(ImKeyboardReloader::File &file, ParsedFile *parsed) {
+	// A result Update() didn't take yet is outdated now
+	ParsedFile *outdated = file.Pending.exchange(parsed, std::memory_order_acq_rel);
+	if (outdated != nullptr) {
+		IM_DELETE(outdated);
+	}
+}
+
+static bool FindKeyByName(const char *name, ImGuiKey *out_key) {
+	if (strcmp(name, "None") == 0) {
+		*out_key = ImGuiKey_None;
+		return true;
+	}
+	for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; key++) {
+		if (strcmp(ImGui::GetKeyName((ImGuiKey)key), name) == 0) {
+			*out_key = (ImGuiKey)key;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Turns the parsed edits into ImGuiKeyboardKeyEdit, on the main thread as the key names come from ImGui
+static bool ResolveLayout(ParsedFile &parsed, const char *path) {
+	parsed.KeyEdits.resize(parsed.Edits.Size);
+	for (int i = 0; i < parsed.Edits.Size; i++) {
+		const ParsedFile::Edit &src = parsed.Edits[i];
+		ImGuiKeyboardKeyEdit &dst = parsed.KeyEdits[i];
+		dst.Row = src.Row;
+		dst.Op = src.Op;
+		dst.Index = src.Index;
+		dst.Width = src.Width;
+		dst.Label = src.Label == -1 ? nullptr : parsed.Strings.Data + src.Label;
+		dst.ShiftLabel = src.ShiftLabel == -1 ? nullptr : parsed.Strings.Data + src.ShiftLabel;
+		dst.Key = ImGuiKey_None;
+		if (src.KeyName != -1 && !FindKeyByName(parsed.Strings.Data + src.KeyName, &dst.Key)) {
+			ImFormatString(parsed.Error, sizeof(parsed.Error), "%s: unknown key name '%s'", path,
+						   parsed.Strings.Data + src.KeyName);
+			return false;
+		}
+	}
+	return true;
+}
+
+#ifdef IMKEYBOARD_RELOAD_INOTIFY
+
+static void WatcherThread(ImKeyboardReloader *reloader) {
+	ImVector<ImKeyboardReloader::File *> &files = reloader->Files;
+	for (int i = 0; i < files.Size; i++) {
+		Publish(*files[i], ParseFile(*files[i]));
+	}
+
+	ImVector<bool> dirty;
+	dirty.resize(files.Size);
+	alignas(struct inotify_event) char buf[4096];
+	for (;;) {
+		struct pollfd fds[2] = {{reloader->InotifyFd, POLLIN, 0}, {reloader->WakeFd, POLLIN, 0}};
+		if (poll(fds, 2, -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		if (fds[1].revents != 0) {
+			break;
+		}
+
+		// Drain all events first, an editor saving a file usually produces several
+		memset(dirty.Data, 0, (size_t)dirty.size_in_bytes());
+		for (;;) {
+			const ssize_t len = read(reloader->InotifyFd, buf, sizeof(buf));
+			if (len <= 0) {
+				break;
+			}
+			for (ssize_t offset = 0; offset < len;) {
+				const struct inotify_event *event = (const struct inotify_event *)(buf + offset);
+				offset += (ssize_t)sizeof(struct inotify_event) + event->len;
+				if (event->len == 0) {
+					continue;
+				}
+				for (int i = 0; i < files.Size; i++) {
+					if (files[i]->WatchId == event->wd && strcmp(files[i]->Name, event->name) == 0) {
+						dirty[i] = true;
+					}
+				}
+			}
+		}
+		for (int i = 0; i < files.Size; i++) {
+			if (dirty[i]) {
+				Publish(*files[i], ParseFile(*files[i]));
+			}
+		}
+	}
+}
+
+#endif // IMKEYBOARD_RELOAD_INOTIFY
+
+} // namespace ImKeyboardReload
+
+ImKeyboardReloader::ImKeyboardReloader() : InotifyFd(-1), WakeFd(-1), Thread(nullptr) {
+	Error[0] = '\0';
+}
+
+ImKeyboardReloader::~ImKeyboardReloader() {
+	Stop();
+	for (int i = 0; i < Files.Size; i++) {
+		File *file = Files[i];
+		if (file->Active != nullptr) {
+			ImKeyboard::SetLayoutEdits(file->Active->Layout, nullptr, 0);
+			IM_DELETE(file->Active);
+		}
+		ParsedFile *pending = file->Pending.load();
+		if (pending != nullptr) {
+			IM_DELETE(pending);
+		}
+		IM_DELETE(file);
+	}
+	Files.clear();
+}
+
+static bool AddFile(ImVector<ImKeyboardReloader::File *> &files, const char *path, bool is_style) {
+	if (path == nullptr || strlen(path) >= sizeof(ImKeyboardReloader::File::Path)) {
+		return false;
+	}
+	ImKeyboardReloader::File *file = IM_NEW(ImKeyboardReloader::File)();
+	strcpy(file->Path, path);
+	const char *slash = strrchr(file->Path, '/');
+	file->Name = slash != nullptr ? slash + 1 : file->Path;
+	file->IsStyle = is_style;
+	files.push_back(file);
+	return true;
+}
+
+bool ImKeyboardReloader::WatchStyle(const char *path) {
+	IM_ASSERT(!IsRunning() && "Files can only be added while stopped");
+	return AddFile(Files, path, true);
+}
+
+bool ImKeyboardReloader::WatchLayout(const char *path) {
+	IM_ASSERT(!IsRunning() && "Files can only be added while stopped");
+	return AddFile(Files, path, false);
+}
+
+bool ImKeyboardReloader::Start() {
+	if (IsRunning()) {
+		return true;
+	}
+#ifdef IMKEYBOARD_RELOAD_INOTIFY
+	InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (InotifyFd == -1 || WakeFd == -1) {
+		Stop();
+		return false;
+	}
+	// Watch the directories to see files that are replaced by a rename. Watching the same directory twice returns the
+	// same watch id.
+	for (int i = 0; i < Files.Size; i++) {
+		File *file = Files[i];
+		char dir[sizeof(file->Path)];
+		if (file->Name == file->Path) {
+			strcpy(dir, ".");
+		} else {
+			const size_t len = file->Name == file->Path + 1 ? 1 : (size_t)(file->Name - file->Path - 1);
+			memcpy(dir, file->Path, len);
+			dir[len] = '\0';
+		}
+		file->WatchId = inotify_add_watch(InotifyFd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (file->WatchId == -1) {
+			Stop();
+			return false;
+		}
+	}
+	Thread = new std::thread(WatcherThread, this);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ImKeyboardReloader::Stop() {
+#ifdef IMKEYBOARD_RELOAD_INOTIFY
+	if (Thread != nullptr) {
+		const uint64_t wake = 1;
+		while (write(WakeFd, &wake, sizeof(wake)) < 0 && errno == EINTR) {
+		}
+		std::thread *thread = (std::thread *)Thread;
+		thread->join();
+		delete thread;
+		Thread = nullptr;
+	}
+	if (InotifyFd != -1) {
+		close(InotifyFd);
+		InotifyFd = -1;
+	}
+	if (WakeFd != -1) {
+		close(WakeFd);
+		WakeFd = -1;
+	}
+#endif
+}
+
+int ImKeyboardReloader::Update() {
+	int applied = 0;
+	for (int i = 0; i < Files.Size; i++) {
+		File *file = Files[i];
+		if (file->Pending.load(std::memory_order_relaxed) == nullptr) {
+			continue;
+		}
+		ParsedFile *parsed = file->Pending.exchange(nullptr, std::memory_order_acq_rel);
+		if (parsed == nullptr) {
+			continue;
+		}
+		if (parsed->Ok && !file->IsStyle && !ResolveLayout(*parsed, file->Path)) {
+			parsed->Ok = false;
+		}
+		if (!parsed->Ok) {
+			// Keep the previous version active
+			ImStrncpy(file->Error, parsed->Error, sizeof(file->Error));
+			IM_DELETE(parsed);
+			continue;
+		}
+		file->Error[0] = '\0';
+		if (file->IsStyle) {
+			ImKeyboard::GetStyle() = parsed->Style;
+			IM_DELETE(parsed);
+		} else {
+			if (file->Active != nullptr && file->Active->Layout != parsed->Layout) {
+				ImKeyboard::SetLayoutEdits(file->Active->Layout, nullptr, 0);
+			}
+			ImKeyboard::SetLayoutEdits(parsed->Layout, parsed->KeyEdits.Data, parsed->KeyEdits.Size);
+			if (file->Active != nullptr) {
+				IM_DELETE(file->Active);
+			}
+			file->Active = parsed;
+		}
+		applied++;
+	}
+
+	// Report the first file that currently fails
+	Error[0] = '\0';
+	for (int i = 0; i < Files.Size; i++) {
+		if (Files[i]->Error[0] != '\0') {
+			ImStrncpy(Error, Files[i]->Error, sizeof(Error));
+			break;
+		}
+	}
+	return applied;
+}
+
+#endif // IMGUI_DISABLE
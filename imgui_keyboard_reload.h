@@ -0,0 +1,92 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// Hot-reload keyboard styles and layout edits from text files while the application runs.
+//
+// A background thread parses the watched files once on Start() and again whenever inotify reports that one was
+// written or replaced. Update() picks up the parsed results at the frame boundary with a single atomic exchange per
+// file, so the render path never waits on I/O or parsing. A file that fails to parse keeps the previously loaded
+// version active and GetError() reports why. Watching is only supported on Linux, Start() returns false elsewhere.
+//
+// Style files set the fields of ImGuiKeyboardStyle by name, everything else keeps its default value:
+//
+//   KeyUnit 40
+//   KeyFaceOffset 4 3
+//   Color KeyPressed 1 0 0 0.5
+//
+// Layout files name the layout they change, followed by edits applied on top of the built-in ones (see
+// ImKeyboard::SetLayoutEdits()). Rows are named like ImGuiKeyboardRow_, keys like ImGui::GetKeyName() and a bare -
+// stands for no shift label:
+//
+//   layout QwertzISO
+//   set Letters1 11 1 "ü" "Ü" LeftBracket
+//   insert Bottom 3 1 "Fn" - None
+//   width Letters3 0 1.25
+//   remove FunctionNav 2
+//
+// Usage:
+//
+//   ImKeyboardReloader reloader;
+//   reloader.WatchStyle("keyboard_style.txt");
+//   reloader.WatchLayout("keyboard_layout.txt");
+//   reloader.Start();
+//   // once per frame, before ImKeyboard::Keyboard()
+//   reloader.Update();
+
+#include "imgui.h"
+#include "imgui_keyboard.h"
+
+struct ImKeyboardReloader {
+	struct File; // Defined in imgui_keyboard_reload.cpp
+
+	ImVector<File *> Files;
+	int InotifyFd;
+	int WakeFd;		 // Wakes the thread up for Stop()
+	void *Thread;	 // std::thread
+	char Error[256]; // Last parse error, empty if the last parse of every file succeeded
+
+	ImKeyboardReloader();
+	// Restores the built-in layouts, the loaded labels are owned by the reloader
+	~ImKeyboardReloader();
+	// Files can only be added while stopped. The directory of the file is watched, so the file doesn't need to
+	// exist yet and editors that save by replacing the file are picked up.
+	bool WatchStyle(const char *path);
+	bool WatchLayout(const char *path);
+	// Starts the watcher thread, which loads all files once
+	bool Start();
+	// Stops the thread, the loaded style and layout edits stay active
+	void Stop();
+	bool IsRunning() const {
+		return Thread != nullptr;
+	}
+	// Applies the files parsed since the last call, never blocks. Returns the number of files applied.
+	int Update();
+	const char *GetError() const {
+		return Error;
+	}
+};
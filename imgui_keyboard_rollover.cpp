@@ -0,0 +1,213 @@
+#include "imgui_keyboard_rollover.h"
+
+#ifndef IMGUI_DISABLE
+
+#include "imgui_internal.h"
+#include "imgui_keyboard_internal.h"
+
+#include <string.h>
+
+static const int KeySetWords = IM_INPUT_STATE_MAX_KEYS / 32;
+
+static int CountKeys(const ImKeyboardRolloverTest::KeySet &set) {
+	int count = 0;
+	for (int w = 0; w < KeySetWords; w++) {
+		count += (int)ImCountSetBits(set.Bits[w]);
+	}
+	return count;
+}
+
+static bool IsEmpty(const ImKeyboardRolloverTest::KeySet &set) {
+	ImU32 any = 0;
+	for (int w = 0; w < KeySetWords; w++) {
+		any |= set.Bits[w];
+	}
+	return any == 0;
+}
+
+// Sets or clears the keys of a layer whose bits differ between the shown and the wanted set
+static void UpdateLayer(int layer, ImKeyboardRolloverTest::KeySet *shown,
+						const ImKeyboardRolloverTest::KeySet &wanted) {
+	for (int w = 0; w < KeySetWords; w++) {
+		ImU32 changed = shown->Bits[w] ^ wanted.Bits[w];
+		while (changed != 0) {
+			const int bit = ImKeyboard::FindLowestBit(changed);
+			changed &= changed - 1;
+			const ImGuiKey key = ImInputStateGetKey(w * 32 + bit);
+			ImKeyboard::HighlightLayerKey(layer, key, ((wanted.Bits[w] >> bit) & 1) != 0);
+		}
+		shown->Bits[w] = wanted.Bits[w];
+	}
+}
+
+ImKeyboardRolloverTest::ImKeyboardRolloverTest() {
+	memset(&KeyboardKeys, 0, sizeof(KeyboardKeys));
+	for (int index = 0; index < ImInputKey_COUNT; index++) {
+		const ImGuiKey key = ImInputStateGetKey(index);
+		if (key != ImGuiKey_None && ImGui::IsKeyboardKey(key)) {
+			KeyboardKeys.Bits[index >> 5] |= 1u << (index & 31);
+		}
+	}
+	memset(&Held, 0, sizeof(Held));
+	memset(&ShownExpected, 0, sizeof(ShownExpected));
+	memset(&ShownFailed, 0, sizeof(ShownFailed));
+	ImInputStateInit(&Snapshot);
+	ExpectedLayer = FailedLayer = -1;
+	ExpectedColor = ImVec4(0.0f, 0.6f, 1.0f, 0.35f);
+	FailedColor = ImVec4(1.0f, 0.0f, 0.0f, 0.6f);
+	Clear();
+}
+
+ImKeyboardRolloverTest::~ImKeyboardRolloverTest() {
+	HideFromKeyboard();
+}
+
+int ImKeyboardRolloverTest::AddChord(const char *name, const ImGuiKey *keys, int key_count) {
+	Chord chord;
+	memset(&chord, 0, sizeof(chord));
+	for (int i = 0; i < key_count; i++) {
+		IM_ASSERT(ImGui::IsKeyboardKey(keys[i]) && "Chords can only have keyboard keys");
+		const int index = ImInputStateGetKeyIndex(keys[i]);
+		if (index == -1) {
+			continue;
+		}
+		chord.Keys.Bits[index >> 5] |= 1u << (index & 31);
+	}
+	chord.Name = Names.Size;
+	chord.Result = ChordResult_Untested;
+	Names.resize(Names.Size + (int)strlen(name) + 1);
+	memcpy(Names.Data + chord.Name, name, strlen(name) + 1);
+	Chords.push_back(chord);
+	return Chords.Size - 1;
+}
+
+void ImKeyboardRolloverTest::Clear() {
+	Chords.clear();
+	Names.clear();
+	Restart();
+}
+
+void ImKeyboardRolloverTest::Restart() {
+	for (int i = 0; i < Chords.Size; i++) {
+		Chord &chord = Chords[i];
+		chord.Result = ChordResult_Untested;
+		memset(&chord.Blocked, 0, sizeof(chord.Blocked));
+		memset(&chord.Ghosts, 0, sizeof(chord.Ghosts));
+	}
+	Combinations.clear();
+	NextChord = 0;
+	PassedCount = FailedCount = 0;
+	PeakCount = 0;
+	memset(&GroupPeak, 0, sizeof(GroupPeak));
+	GroupPeakCount = 0;
+	memset(&FailedKeys, 0, sizeof(FailedKeys));
+	// Held keeps the last snapshot, a group still held goes on but isn't checked
+	SkipGroup = !IsEmpty(Held);
+}
+
+void ImKeyboardRolloverTest::Update(const ImInputState *state) {
+	if (state == nullptr) {
+		ImInputStateCapture(&Snapshot);
+		state = &Snapshot;
+	}
+	KeySet held;
+	for (int w = 0; w < KeySetWords; w++) {
+		held.Bits[w] = state->KeysDown[w] & KeyboardKeys.Bits[w];
+	}
+	const int count = CountKeys(held);
+	if (count > GroupPeakCount) {
+		GroupPeak = held;
+		GroupPeakCount = count;
+		PeakCount = ImMax(PeakCount, count);
+	}
+	if (count == 0 && !IsEmpty(Held)) {
+		EndPressGroup();
+	}
+	Held = held;
+}
+
+void ImKeyboardRolloverTest::EndPressGroup() {
+	const bool skip = SkipGroup;
+	SkipGroup = false;
+	if (skip || GroupPeakCount == 0) {
+		GroupPeakCount = 0;
+		return;
+	}
+
+	// Distinct combinations, the hash only speeds up the comparisons
+	const ImGuiID hash = ImHashData(&GroupPeak, sizeof(GroupPeak));
+	Combination *combination = nullptr;
+	for (int i = 0; i < Combinations.Size && combination == nullptr; i++) {
+		if (Combinations[i].Hash == hash && memcmp(&Combinations[i].Keys, &GroupPeak, sizeof(GroupPeak)) == 0) {
+			combination = &Combinations[i];
+		}
+	}
+	if (combination == nullptr) {
+		Combinations.resize(Combinations.Size + 1);
+		combination = &Combinations.back();
+		combination->Keys = GroupPeak;
+		combination->KeyCount = GroupPeakCount;
+		combination->Count = 0;
+		combination->Hash = hash;
+	}
+	combination->Count++;
+
+	if (NextChord < Chords.Size) {
+		Chord &chord = Chords[NextChord++];
+		ImU32 errors = 0;
+		for (int w = 0; w < KeySetWords; w++) {
+			chord.Blocked.Bits[w] = chord.Keys.Bits[w] & ~GroupPeak.Bits[w];
+			chord.Ghosts.Bits[w] = GroupPeak.Bits[w] & ~chord.Keys.Bits[w];
+			FailedKeys.Bits[w] |= chord.Blocked.Bits[w] | chord.Ghosts.Bits[w];
+			errors |= chord.Blocked.Bits[w] | chord.Ghosts.Bits[w];
+		}
+		chord.Result = errors != 0 ? ChordResult_Failed : ChordResult_Passed;
+		if (errors != 0) {
+			FailedCount++;
+		} else {
+			PassedCount++;
+		}
+	}
+	GroupPeakCount = 0;
+}
+
+const char *ImKeyboardRolloverTest::GetChordName(int chord) const {
+	return Names.Data + Chords[chord].Name;
+}
+
+bool ImKeyboardRolloverTest::IsKeyFailed(ImGuiKey key) const {
+	const int index = ImInputStateGetKeyIndex(key);
+	if (index == -1) {
+		return false;
+	}
+	return ((FailedKeys.Bits[index >> 5] >> (index & 31)) & 1) != 0;
+}
+
+void ImKeyboardRolloverTest::ShowOnKeyboard() {
+	if (ExpectedLayer == -1) {
+		ExpectedLayer = ImKeyboard::AddHighlightLayer("Rollover Next Chord", ExpectedColor, 0);
+		FailedLayer = ImKeyboard::AddHighlightLayer("Rollover Failed Keys", FailedColor, 1);
+		IM_ASSERT(ExpectedLayer != -1 && FailedLayer != -1 && "No free highlight layers");
+		memset(&ShownExpected, 0, sizeof(ShownExpected));
+		memset(&ShownFailed, 0, sizeof(ShownFailed));
+	}
+	KeySet expected;
+	if (NextChord < Chords.Size) {
+		expected = Chords[NextChord].Keys;
+	} else {
+		memset(&expected, 0, sizeof(expected));
+	}
+	UpdateLayer(ExpectedLayer, &ShownExpected, expected);
+	UpdateLayer(FailedLayer, &ShownFailed, FailedKeys);
+}
+
+void ImKeyboardRolloverTest::HideFromKeyboard() {
+	if (ExpectedLayer == -1) {
+		return;
+	}
+	ImKeyboard::RemoveHighlightLayer(ExpectedLayer);
+	ImKeyboard::RemoveHighlightLayer(FailedLayer);
+	ExpectedLayer = FailedLayer = -1;
+}
+
+#endif // IMGUI_DISABLE
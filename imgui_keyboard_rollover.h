@@ -0,0 +1,138 @@
+// License: MIT
+// Copyright (c) 2026 Martin Gerhardy
+//
+// https://github.com/mgerhardy/imgui_keyboard
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Martin Gerhardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// N-key rollover and ghosting test for keyboard hardware validation.
+//
+// Update() takes one input snapshot per frame and works on the 256-bit key bitsets of ImInputState, so a frame costs
+// a few word operations however many keys the rig holds. It tracks the peak number of keyboard keys held at once and
+// the combinations registered: a press group lasts from the first press until all keys are released again, and its
+// combination is the largest set of keys held at the same time.
+//
+// The script is a list of chords the rig (or tester) presses in order. Each press group is checked against the next
+// chord of the script: expected keys that weren't registered are blocked, registered keys that weren't expected are
+// ghosts. A chord with either fails, and its keys go to the failed keys. ShowOnKeyboard() puts the keys of the next
+// chord and the failed keys on ImKeyboard::Keyboard() as two highlight layers.
+//
+// Usage:
+//
+//   ImKeyboardRolloverTest test;
+//   const ImGuiKey wasd[] = {ImGuiKey_W, ImGuiKey_A, ImGuiKey_S, ImGuiKey_D, ImGuiKey_Space, ImGuiKey_LeftShift};
+//   test.AddChord("WASD + Space + Shift", wasd, IM_ARRAYSIZE(wasd));
+//   // once per frame, before ImKeyboard::Keyboard()
+//   test.Update();
+//   test.ShowOnKeyboard();
+//   ImGui::Text("Peak rollover %d, %d failed", test.GetPeakCount(), test.GetFailedCount());
+
+#include "imgui.h"
+#include "imgui_keyboard.h"
+
+struct ImKeyboardRolloverTest {
+	// Bit i is the key ImInputKey i, like ImInputState::KeysDown
+	struct KeySet {
+		ImU32 Bits[IM_INPUT_STATE_MAX_KEYS / 32];
+	};
+	enum ChordResult {
+		ChordResult_Untested,
+		ChordResult_Passed,
+		ChordResult_Failed,
+	};
+	struct Chord {
+		KeySet Keys;
+		int Name; // Offset into Names
+		ChordResult Result;
+		KeySet Blocked; // Expected keys that weren't registered
+		KeySet Ghosts;	// Registered keys that weren't expected
+	};
+	// Distinct combination registered by a press group
+	struct Combination {
+		KeySet Keys;
+		int KeyCount;
+		int Count; // Press groups that registered it
+		ImGuiID Hash;
+	};
+
+	ImVector<Chord> Chords;
+	ImVector<char> Names;
+	ImVector<Combination> Combinations;
+	int NextChord; // Chord the next press group is checked against, Chords.Size when the script is done
+	int PassedCount;
+	int FailedCount;
+	int PeakCount;		 // Most keyboard keys held at once
+	KeySet KeyboardKeys; // Mask of the keys counted, mouse and gamepad keys are ignored
+	KeySet Held;		 // Keys of the last snapshot
+	KeySet GroupPeak;	 // Largest combination of the current press group
+	int GroupPeakCount;
+	bool SkipGroup;		 // The press group started before Restart() and isn't checked
+	KeySet FailedKeys;	  // Blocked and ghost keys of all failed chords
+	KeySet ShownExpected; // What ShowOnKeyboard() last pushed to the layers
+	KeySet ShownFailed;
+	ImInputState Snapshot; // Captured by Update() without a state
+	int ExpectedLayer;	   // Highlight layers created by ShowOnKeyboard(), -1 before
+	int FailedLayer;
+	ImVec4 ExpectedColor; // Colors of the layers, set before the first ShowOnKeyboard()
+	ImVec4 FailedColor;
+
+	ImKeyboardRolloverTest();
+	// Removes the highlight layers if shown
+	~ImKeyboardRolloverTest();
+	// Appends a chord to the script and returns its index. The name is copied.
+	int AddChord(const char *name, const ImGuiKey *keys, int key_count);
+	// Clears the script, the results and the statistics
+	void Clear();
+	// Clears the results and the statistics and starts the script over, the chords are kept
+	void Restart();
+	// Call once per frame. nullptr captures the ImGui input, otherwise pass a snapshot of the rig input (e.g. from
+	// imgui_input_mirror.h). A press group that started before Restart() isn't checked.
+	void Update(const ImInputState *state = nullptr);
+
+	const char *GetChordName(int chord) const;
+	ChordResult GetChordResult(int chord) const {
+		return Chords[chord].Result;
+	}
+	int GetNextChord() const {
+		return NextChord < Chords.Size ? NextChord : -1; // -1 when the script is done
+	}
+	int GetPeakCount() const {
+		return PeakCount;
+	}
+	int GetPassedCount() const {
+		return PassedCount;
+	}
+	int GetFailedCount() const {
+		return FailedCount;
+	}
+	bool IsKeyFailed(ImGuiKey key) const;
+
+	// Shows the next chord and the failed keys on ImKeyboard::Keyboard() until HideFromKeyboard(), call once per
+	// frame before it
+	void ShowOnKeyboard();
+	void HideFromKeyboard();
+
+	// Internal
+	void EndPressGroup();
+};
@@ -1,8 +1,10 @@
 #include "imgui_mouse.h"
+#include "imgui_input_trace.h"
+#include "imgui_internal.h"
 
 namespace ImMouse {
 
-#ifndef IMGUI_DISABLE
+#if !defined(IMGUI_DISABLE) && !defined(IMKEYBOARD_DISABLE_MOUSE)
 
 ImGuiMouseStyle::ImGuiMouseStyle() {
 	Scale = 1.0f;
@@ -28,7 +30,17 @@ ImGuiMouseStyle::ImGuiMouseStyle() {
 struct MouseContext {
 	ImVector<int> HighlightedButtons;
 	ImVector<int> RecordedButtons;
+	const ImInputState *InputState; // nullptr for the ImGui input
 	ImGuiMouseStyle Style;
+	ImGuiID StateHash;	   // What the widgets of StateHashFrame drew, see GetStateHash()
+	ImGuiID PrevStateHash; // Same for the previous frame that drew widgets
+	int StateHashFrame;
+
+	MouseContext() {
+		InputState = nullptr;
+		StateHash = PrevStateHash = 0;
+		StateHashFrame = -1;
+	}
 };
 
 static MouseContext *GetContext() {
@@ -45,6 +57,18 @@ static ImU32 GetColorU32(ImGuiMouseCol idx) {
 	return ImGui::ColorConvertFloat4ToU32(style.Colors[idx]);
 }
 
+void SetInputState(const ImInputState *state) {
+	GetContext()->InputState = state;
+}
+
+static bool IsMouseDown(ImGuiMouseButton button) {
+	const ImInputState *state = GetContext()->InputState;
+	if (state == nullptr) {
+		return ImGui::IsMouseDown(button);
+	}
+	return ImInputStateIsMouseDown(state, button);
+}
+
 static bool IsButtonHighlighted(int button) {
 	MouseContext *ctx = GetContext();
 	for (int i = 0; i < ctx->HighlightedButtons.Size; i++) {
@@ -55,6 +79,7 @@ static bool IsButtonHighlighted(int button) {
 	return false;
 }
 
+#ifndef IMKEYBOARD_DISABLE_RECORDING
 static bool IsButtonRecorded(int button) {
 	MouseContext *ctx = GetContext();
 	for (int i = 0; i < ctx->RecordedButtons.Size; i++) {
@@ -81,6 +106,20 @@ static void Record(int button, bool record) {
 	}
 }
 
+// Toggles the recorded state of a button clicked inside min/max, returns whether it is recorded now
+static bool RecordButtonClick(int button, const ImVec2 &min, const ImVec2 &max) {
+	IM_INPUT_TRACE_SCOPE("ImMouse::Input");
+	bool recorded = IsButtonRecorded(button);
+	const ImVec2 mouse_pos = ImGui::GetMousePos();
+	if (ImGui::IsMouseClicked(button) && mouse_pos.x >= min.x && mouse_pos.x < max.x && mouse_pos.y >= min.y &&
+		mouse_pos.y < max.y) {
+		recorded = !recorded;
+		Record(button, recorded);
+	}
+	return recorded;
+}
+#endif // IMKEYBOARD_DISABLE_RECORDING
+
 void HighlightButton(int button, bool highlight) {
 	MouseContext *ctx = GetContext();
 	if (highlight) {
@@ -111,7 +150,36 @@ const ImVector<int> &GetRecordedButtons() {
 	return GetContext()->RecordedButtons;
 }
 
+// Folds what a widget drew into the hash of the frame
+static void AddStateHash(ImGuiMouseLayout layout, ImGuiMouseFlags flags, float scale) {
+	IM_INPUT_TRACE_SCOPE("ImMouse::StateHash");
+	MouseContext *ctx = GetContext();
+	const int frame = ImGui::GetFrameCount();
+	if (ctx->StateHashFrame != frame) {
+		ctx->PrevStateHash = ctx->StateHash;
+		ctx->StateHash = 0;
+		ctx->StateHashFrame = frame;
+	}
+	int header[3] = {layout, flags, 0};
+	if (flags & ImGuiMouseFlags_ShowPressed) {
+		for (int button = ImGuiMouseButton_Left; button <= ImGuiMouseButton_Middle; button++) {
+			header[2] |= IsMouseDown(button) ? 1 << button : 0;
+		}
+	}
+	ImGuiID h = ImHashData(header, sizeof(header), ctx->StateHash);
+	h = ImHashData(&scale, sizeof(scale), h);
+	h = ImHashData(&ctx->Style, sizeof(ctx->Style), h);
+	h = ImHashData(ctx->HighlightedButtons.Data, sizeof(int) * ctx->HighlightedButtons.Size, h);
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	if (flags & ImGuiMouseFlags_Recordable) {
+		h = ImHashData(ctx->RecordedButtons.Data, sizeof(int) * ctx->RecordedButtons.Size, h);
+	}
+#endif
+	ctx->StateHash = h;
+}
+
 void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags) {
+	IM_INPUT_TRACE_SCOPE("ImMouse::Mouse");
 	const ImGuiMouseStyle &style = GetStyle();
 	const float scale = style.Scale * (ImGui::GetFontSize() / 13.0f);
 
@@ -133,25 +201,21 @@ void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags) {
 	ImVec2 body_pos(canvas_pos.x + 5.0f * scale, canvas_pos.y + 5.0f * scale);
 
 	// Draw mouse body
-	draw_list->AddRectFilled(body_pos, ImVec2(body_pos.x + body_width, body_pos.y + body_height),
-							 GetColorU32(ImGuiMouseCol_Background), body_rounding);
-	draw_list->AddRect(body_pos, ImVec2(body_pos.x + body_width, body_pos.y + body_height),
-					   GetColorU32(ImGuiMouseCol_Border), body_rounding, 0, 2.0f * scale);
+	{
+		IM_INPUT_TRACE_SCOPE("ImMouse::Background");
+		draw_list->AddRectFilled(body_pos, ImVec2(body_pos.x + body_width, body_pos.y + body_height),
+								 GetColorU32(ImGuiMouseCol_Background), body_rounding);
+		draw_list->AddRect(body_pos, ImVec2(body_pos.x + body_width, body_pos.y + body_height),
+						   GetColorU32(ImGuiMouseCol_Border), body_rounding, 0, 2.0f * scale);
+	}
 
 	// Calculate button layout
 	const bool threeButton = (layout == ImGuiMouseLayout_ThreeButton);
 	const bool showWheel = (flags & ImGuiMouseFlags_ShowWheel);
 	const bool showPressed = (flags & ImGuiMouseFlags_ShowPressed);
-	const bool recordable = (flags & ImGuiMouseFlags_Recordable);
-
-	// Handle recording when Recordable flag is set
-	ImVec2 mouse_pos;
-	bool mouse_in_canvas = false;
-	if (recordable) {
-		mouse_pos = ImGui::GetMousePos();
-		mouse_in_canvas = mouse_pos.x >= canvas_pos.x && mouse_pos.x < canvas_pos.x + canvas_size.x &&
-						  mouse_pos.y >= canvas_pos.y && mouse_pos.y < canvas_pos.y + canvas_size.y;
-	}
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	const bool recordable = (flags & ImGuiMouseFlags_Recordable) != 0;
+#endif
 
 	float left_button_width, right_button_width, middle_button_width = 0.0f;
 	if (threeButton || showWheel) {
@@ -174,17 +238,13 @@ void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags) {
 					   ImDrawFlags_RoundCornersTopLeft);
 
 	// Left button pressed/highlighted/recorded overlay
-	bool leftPressed = showPressed && ImGui::IsMouseDown(ImGuiMouseButton_Left);
+	bool leftPressed = showPressed && IsMouseDown(ImGuiMouseButton_Left);
 	bool leftHighlighted = IsButtonHighlighted(ImGuiMouseButton_Left);
-	bool leftRecorded = recordable && IsButtonRecorded(ImGuiMouseButton_Left);
-
-	// Handle recording click on left button
-	if (recordable && mouse_in_canvas && ImGui::IsMouseClicked(ImGuiMouseButton_Left) &&
-		mouse_pos.x >= left_btn_min.x && mouse_pos.x < left_btn_max.x && mouse_pos.y >= left_btn_min.y &&
-		mouse_pos.y < left_btn_max.y) {
-		Record(ImGuiMouseButton_Left, !leftRecorded);
-		leftRecorded = !leftRecorded;
-	}
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	const bool leftRecorded = recordable && RecordButtonClick(ImGuiMouseButton_Left, left_btn_min, left_btn_max);
+#else
+	const bool leftRecorded = false;
+#endif
 
 	if (leftPressed) {
 		draw_list->AddRectFilled(left_btn_min, left_btn_max, GetColorU32(ImGuiMouseCol_ButtonPressed), body_rounding,
@@ -207,17 +267,13 @@ void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags) {
 					   ImDrawFlags_RoundCornersTopRight);
 
 	// Right button pressed/highlighted/recorded overlay
-	bool rightPressed = showPressed && ImGui::IsMouseDown(ImGuiMouseButton_Right);
+	bool rightPressed = showPressed && IsMouseDown(ImGuiMouseButton_Right);
 	bool rightHighlighted = IsButtonHighlighted(ImGuiMouseButton_Right);
-	bool rightRecorded = recordable && IsButtonRecorded(ImGuiMouseButton_Right);
-
-	// Handle recording click on right button
-	if (recordable && mouse_in_canvas && ImGui::IsMouseClicked(ImGuiMouseButton_Right) &&
-		mouse_pos.x >= right_btn_min.x && mouse_pos.x < right_btn_max.x && mouse_pos.y >= right_btn_min.y &&
-		mouse_pos.y < right_btn_max.y) {
-		Record(ImGuiMouseButton_Right, !rightRecorded);
-		rightRecorded = !rightRecorded;
-	}
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+	const bool rightRecorded = recordable && RecordButtonClick(ImGuiMouseButton_Right, right_btn_min, right_btn_max);
+#else
+	const bool rightRecorded = false;
+#endif
 
 	if (rightPressed) {
 		draw_list->AddRectFilled(right_btn_min, right_btn_max, GetColorU32(ImGuiMouseCol_ButtonPressed), body_rounding,
@@ -232,6 +288,7 @@ void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags) {
 
 	// Middle button or wheel
 	if (threeButton || showWheel) {
+		IM_INPUT_TRACE_SCOPE("ImMouse::Middle");
 		float middle_x = body_pos.x + left_button_width + button_gap;
 		ImVec2 middle_min(middle_x, body_pos.y + (button_height - wheel_height) / 2.0f);
 		ImVec2 middle_max(middle_x + middle_button_width, middle_min.y + wheel_height);
@@ -251,17 +308,14 @@ void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags) {
 
 		if (threeButton) {
 			// Middle button pressed/highlighted/recorded overlay
-			bool middlePressed = showPressed && ImGui::IsMouseDown(ImGuiMouseButton_Middle);
+			bool middlePressed = showPressed && IsMouseDown(ImGuiMouseButton_Middle);
 			bool middleHighlighted = IsButtonHighlighted(ImGuiMouseButton_Middle);
-			bool middleRecorded = recordable && IsButtonRecorded(ImGuiMouseButton_Middle);
-
-			// Handle recording click on middle button
-			if (recordable && mouse_in_canvas && ImGui::IsMouseClicked(ImGuiMouseButton_Middle) &&
-				mouse_pos.x >= middle_min.x && mouse_pos.x < middle_max.x && mouse_pos.y >= middle_min.y &&
-				mouse_pos.y < middle_max.y) {
-				Record(ImGuiMouseButton_Middle, !middleRecorded);
-				middleRecorded = !middleRecorded;
-			}
+#ifndef IMKEYBOARD_DISABLE_RECORDING
+			const bool middleRecorded =
+				recordable && RecordButtonClick(ImGuiMouseButton_Middle, middle_min, middle_max);
+#else
+			const bool middleRecorded = false;
+#endif
 
 			if (middlePressed) {
 				draw_list->AddRectFilled(middle_min, middle_max, GetColorU32(ImGuiMouseCol_ButtonPressed),
@@ -277,9 +331,19 @@ void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags) {
 	}
 
 	draw_list->PopClipRect();
+	AddStateHash(layout, flags, scale);
+}
+
+ImGuiID GetStateHash() {
+	return GetContext()->StateHash;
+}
+
+bool WantsRedraw() {
+	const MouseContext *ctx = GetContext();
+	return ctx->StateHash != ctx->PrevStateHash;
 }
 
-#ifndef IMGUI_DISABLE_DEMO_WINDOWS
+#ifndef IMKEYBOARD_DISABLE_DEMO
 void MouseDemo() {
 	static bool showPressed = true;
 	static bool showWheel = true;
@@ -310,7 +374,9 @@ void MouseDemo() {
 	ImGui::Text("Options:");
 	ImGui::Checkbox("Show Pressed Buttons", &showPressed);
 	ImGui::Checkbox("Show Scroll Wheel", &showWheel);
+#ifndef IMKEYBOARD_DISABLE_RECORDING
 	ImGui::Checkbox("Recordable Buttons (Blue)", &recordable);
+#endif
 
 	// Show recorded buttons when recordable mode is enabled
 	if (recordable) {
@@ -350,7 +416,7 @@ void MouseDemo() {
 	}
 	Mouse((ImGuiMouseLayout)currentLayout, flags);
 }
-#endif // IMGUI_DISABLE_DEMO_WINDOWS
-#endif // IMGUI_DISABLE
+#endif // IMKEYBOARD_DISABLE_DEMO
+#endif // !IMGUI_DISABLE && !IMKEYBOARD_DISABLE_MOUSE
 
 } // namespace ImMouse
@@ -27,6 +27,8 @@
 #pragma once
 
 #include "imgui.h"
+#include "imgui_keyboard_config.h"
+#include "imgui_input_state.h"
 
 namespace ImMouse {
 
@@ -82,7 +84,17 @@ void HighlightButton(int button, bool highlight);
 void ClearHighlights();
 void ClearRecorded();
 const ImVector<int> &GetRecordedButtons();
+// Render pressed buttons from an input state instead of the ImGui input (e.g. another process, see
+// imgui_input_mirror.h). The state must stay valid until Mouse() returns, nullptr switches back to the ImGui input.
+// Recording always uses the ImGui input.
+void SetInputState(const ImInputState *state);
 void Mouse(ImGuiMouseLayout layout, ImGuiMouseFlags flags = 0);
+// Hash of what the Mouse() calls of the frame drew, WantsRedraw() compares it with the previous frame (see
+// ImKeyboard::WantsRedraw())
+ImGuiID GetStateHash();
+bool WantsRedraw();
+#ifndef IMKEYBOARD_DISABLE_DEMO
 void MouseDemo();
+#endif
 
 } // namespace ImMouse